@@ -59,6 +59,11 @@ static constexpr double AVALANCHE_DEFAULT_MIN_QUORUM_CONNECTED_STAKE_RATIO =
  */
 static constexpr double AVALANCHE_DEFAULT_MIN_AVAPROOFS_NODE_COUNT = 8;
 
+/**
+ * Whether we reconcile our mempool with our avalanche peers by default.
+ */
+static constexpr bool AVALANCHE_DEFAULT_MEMPOOL_SYNC = false;
+
 /**
  * Global avalanche instance.
  */
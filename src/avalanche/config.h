@@ -11,9 +11,13 @@ namespace avalanche {
 
 struct Config {
     const std::chrono::milliseconds queryTimeoutDuration;
+    //! How often to log a summary of the latencies, or 0 to never log it
+    const std::chrono::seconds latencyLogPeriod;
 
-    Config(std::chrono::milliseconds queryTimeoutDurationIn)
-        : queryTimeoutDuration(queryTimeoutDurationIn) {}
+    Config(std::chrono::milliseconds queryTimeoutDurationIn,
+           std::chrono::seconds latencyLogPeriodIn = std::chrono::seconds{0})
+        : queryTimeoutDuration(queryTimeoutDurationIn),
+          latencyLogPeriod(latencyLogPeriodIn) {}
 };
 
 } // namespace avalanche
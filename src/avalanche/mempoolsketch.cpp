@@ -0,0 +1,30 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/mempoolsketch.h>
+
+#include <crypto/siphash.h>
+#include <primitives/txid.h>
+
+#include <cassert>
+
+namespace avalanche {
+
+uint64_t MempoolSketch::getShortID(const TxId &txid) const {
+    // Unlike the compact blocks, the full 64 bits are used because the short
+    // ids are not sent for every transaction but only for the difference.
+    return SipHashUint256(shorttxidk0, shorttxidk1, txid);
+}
+
+bool MempoolSketch::diff(const MempoolSketch &other,
+                         std::vector<uint64_t> &onlyHere,
+                         std::vector<uint64_t> &onlyThere) const {
+    assert(getKeys() == other.getKeys());
+
+    ShortIdSketch difference(sketch);
+    difference -= other.sketch;
+    return difference.decode(onlyHere, onlyThere);
+}
+
+} // namespace avalanche
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_AVALANCHE_MEMPOOLSKETCH_H
+#define BITCOIN_AVALANCHE_MEMPOOLSKETCH_H
+
+#include <random.h>
+#include <serialize.h>
+#include <shortidsketch.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <limits>
+#include <utility>
+#include <vector>
+
+struct TxId;
+
+namespace avalanche {
+
+/** The largest sketch that can be sent, about 200kB */
+static constexpr size_t MAX_MEMPOOL_SKETCH_CELLS = 10000;
+/** Number of transactions the largest sketch we send can recover */
+static constexpr size_t MAX_MEMPOOL_SKETCH_CAPACITY = 4096;
+static_assert(ShortIdSketch::GetCellCount(MAX_MEMPOOL_SKETCH_CAPACITY) <=
+                  MAX_MEMPOOL_SKETCH_CELLS,
+              "The largest sketch we send must be accepted by our peers");
+
+/**
+ * Sketch of the transactions in the mempool of an avalanche peer, sent to
+ * another peer so they can find out which transactions one of them is
+ * missing. The short ids are computed with random keys so they can't be
+ * targeted to make the sketch fail.
+ */
+class MempoolSketch {
+private:
+    uint64_t shorttxidk0, shorttxidk1;
+    ShortIdSketch sketch;
+
+public:
+    MempoolSketch()
+        : shorttxidk0(GetRand(std::numeric_limits<uint64_t>::max())),
+          shorttxidk1(GetRand(std::numeric_limits<uint64_t>::max())) {}
+    explicit MempoolSketch(size_t capacity) : MempoolSketch() {
+        sketch = ShortIdSketch(capacity);
+    }
+
+    /** An empty sketch with the same keys and cell count */
+    MempoolSketch emptyCopy() const {
+        MempoolSketch copy(*this);
+        copy.sketch.clear();
+        return copy;
+    }
+
+    uint64_t getShortID(const TxId &txid) const;
+
+    void addTx(const TxId &txid) { sketch.insert(getShortID(txid)); }
+
+    /**
+     * Find out the short ids of the transactions that are only in one of the
+     * sketches. The other sketch must be built from an emptyCopy() of this one.
+     *
+     * @return false if the difference is too large to be decoded.
+     */
+    bool diff(const MempoolSketch &other, std::vector<uint64_t> &onlyHere,
+              std::vector<uint64_t> &onlyThere) const;
+
+    std::pair<uint64_t, uint64_t> getKeys() const {
+        return std::make_pair(shorttxidk0, shorttxidk1);
+    }
+    const ShortIdSketch &getSketch() const { return sketch; }
+
+    SERIALIZE_METHODS(MempoolSketch, obj) {
+        READWRITE(obj.shorttxidk0, obj.shorttxidk1, obj.sketch);
+
+        if (ser_action.ForRead() &&
+            (!obj.sketch.isValid() ||
+             obj.sketch.getCellCount() > MAX_MEMPOOL_SKETCH_CELLS)) {
+            throw std::ios_base::failure("invalid sketch size");
+        }
+    }
+};
+
+/**
+ * Response to a mempool sketch, listing the short ids of the transactions that
+ * are missing from the mempool of the responder. The total number of
+ * transactions that only one of the mempools has is also reported, so the
+ * sender can size its next sketch. Both are empty if the sketches difference
+ * could not be decoded.
+ */
+class MempoolSketchDiff {
+public:
+    bool decoded{false};
+    uint32_t differenceSize{0};
+    std::vector<uint64_t> shortids;
+
+    SERIALIZE_METHODS(MempoolSketchDiff, obj) {
+        READWRITE(obj.decoded, obj.differenceSize, obj.shortids);
+    }
+};
+
+} // namespace avalanche
+
+#endif // BITCOIN_AVALANCHE_MEMPOOLSKETCH_H
@@ -7,8 +7,11 @@
 #include <avalanche/avalanche.h>
 #include <avalanche/delegation.h>
 #include <avalanche/validation.h>
+#include <clientversion.h>
 #include <random.h>
 #include <scheduler.h>
+#include <streams.h>
+#include <util/system.h>
 #include <validation.h> // For ChainstateManager
 
 #include <algorithm>
@@ -73,6 +76,7 @@ bool PeerManager::addNodeToPeer(const PeerSet::iterator &it) {
         const uint32_t score = p.getScore();
         const uint64_t start = slotCount;
         slots.emplace_back(start, score, it->peerid);
+        slotScores.push_back(score);
         slotCount = start + score;
 
         // Add to our allocated score when we allocate a new peer in the slots
@@ -135,10 +139,12 @@ bool PeerManager::removeNodeFromPeer(const PeerSet::iterator &it,
 
     if (i + 1 == slots.size()) {
         slots.pop_back();
+        slotScores.pop_back();
         slotCount = slots.empty() ? 0 : slots.back().getStop();
     } else {
         fragmentation += slots[i].getScore();
         slots[i] = slots[i].withPeerId(NO_PEER);
+        slotScores.subtract(i, slots[i].getScore());
     }
 
     return true;
@@ -452,17 +458,22 @@ void PeerManager::cleanupDanglingProofs(const ProofRef &localProof) {
     // If we have dangling proof, this is a good indicator that we need to
     // request more nodes from our peers.
     needMoreNodes = !newlyDanglingProofIds.empty();
+
+    // The free slots don't affect the peer selection, only reclaim them once
+    // they make for most of the slots.
+    if (2 * fragmentation > slotCount) {
+        compact();
+    }
 }
 
 NodeId PeerManager::selectNode() {
     for (int retry = 0; retry < SELECT_NODE_MAX_RETRY; retry++) {
         const PeerId p = selectPeer();
 
-        // If we cannot find a peer, it may be due to the fact that it is
-        // unlikely due to high fragmentation, so compact and retry.
+        // The selection never lands on a free slot, so there is no point in
+        // retrying if there is no peer.
         if (p == NO_PEER) {
-            compact();
-            continue;
+            break;
         }
 
         // See if that peer has an available node.
@@ -484,24 +495,86 @@ std::unordered_set<ProofRef, SaltedProofHasher> PeerManager::updatedBlockTip() {
     std::vector<ProofId> invalidProofIds;
     std::vector<ProofRef> newImmatures;
 
+    // If we have been notified of all the blocks since the last update, only
+    // the proofs that might have been affected by these blocks need to be
+    // checked again. Otherwise all the proofs are.
+    const bool checkAllProofs = !hasConnectedBlocks || hasDisconnectedBlocks;
+    std::vector<ProofRef> immaturesToRescan;
+
     {
         LOCK(cs_main);
 
-        for (const auto &p : peers) {
+        auto checkProof = [&](const ProofRef &proof) {
             ProofValidationState state;
-            if (!p.proof->verify(stakeUtxoDustThreshold, chainman, state)) {
+            if (!proof->verify(stakeUtxoDustThreshold, chainman, state)) {
                 if (isImmatureState(state)) {
-                    newImmatures.push_back(p.proof);
+                    newImmatures.push_back(proof);
                 }
-                invalidProofIds.push_back(p.getProofId());
+                invalidProofIds.push_back(proof->getId());
 
                 LogPrint(BCLog::AVALANCHE,
                          "Invalidating proof %s: verification failed (%s)\n",
-                         p.proof->getId().GetHex(), state.ToString());
+                         proof->getId().GetHex(), state.ToString());
             }
+        };
+
+        if (checkAllProofs) {
+            for (const auto &p : peers) {
+                checkProof(p.proof);
+            }
+        } else {
+            std::unordered_set<ProofRef, SaltedProofHasher> proofsToCheck;
+            for (const COutPoint &utxo : spentUtxos) {
+                if (ProofRef proof = validProofPool.getProof(utxo)) {
+                    proofsToCheck.insert(std::move(proof));
+                }
+            }
+
+            const CBlockIndex *activeTip = chainman.ActiveTip();
+            const int64_t tipMedianTimePast =
+                activeTip ? activeTip->GetMedianTimePast() : 0;
+            // A zero or negative expiration time means no expiration.
+            auto &expirationView = peers.get<by_expiration>();
+            for (auto it = expirationView.upper_bound(0);
+                 it != expirationView.end() &&
+                 it->proof->getExpirationTime() <= tipMedianTimePast;
+                 it++) {
+                proofsToCheck.insert(it->proof);
+            }
+
+            for (const ProofRef &proof : proofsToCheck) {
+                checkProof(proof);
+            }
+
+            // The immature proofs only need to be registered again if they
+            // reached maturity or if one of their utxos got spent.
+            const int64_t activeHeight = chainman.ActiveHeight();
+            const int64_t stakeUtxoMinConfirmations =
+                gArgs.GetIntArg("-avaproofstakeutxoconfirmations",
+                                AVALANCHE_DEFAULT_STAKE_UTXO_CONFIRMATIONS);
+            immatureProofPool.forEachProof([&](const ProofRef &proof) {
+                int64_t maxStakeHeight = 0;
+                for (const SignedStake &ss : proof->getStakes()) {
+                    const Stake &s = ss.getStake();
+                    if (spentUtxos.count(s.getUTXO())) {
+                        immaturesToRescan.push_back(proof);
+                        return;
+                    }
+                    maxStakeHeight =
+                        std::max<int64_t>(maxStakeHeight, s.getHeight());
+                }
+                if (maxStakeHeight + stakeUtxoMinConfirmations - 1 <=
+                    activeHeight) {
+                    immaturesToRescan.push_back(proof);
+                }
+            });
         }
     }
 
+    spentUtxos.clear();
+    hasConnectedBlocks = false;
+    hasDisconnectedBlocks = false;
+
     // Remove the invalid proofs before the immature rescan. This makes it
     // possible to pull back proofs with utxos that conflicted with these
     // invalid proofs.
@@ -509,7 +582,21 @@ std::unordered_set<ProofRef, SaltedProofHasher> PeerManager::updatedBlockTip() {
         rejectProof(invalidProofId, RejectionMode::INVALIDATE);
     }
 
-    auto registeredProofs = immatureProofPool.rescan(*this);
+    auto registeredProofs = [&]() {
+        if (checkAllProofs) {
+            return immatureProofPool.rescan(*this);
+        }
+
+        // Like ProofPool::rescan, return all the proofs that have been
+        // registered again, even if they failed.
+        std::unordered_set<ProofRef, SaltedProofHasher> rescannedProofs;
+        for (const ProofRef &proof : immaturesToRescan) {
+            immatureProofPool.removeProof(proof->getId());
+            registerProof(proof);
+            rescannedProofs.insert(proof);
+        }
+        return rescannedProofs;
+    }();
 
     for (auto &p : newImmatures) {
         immatureProofPool.addProofIfPreferred(p);
@@ -518,6 +605,170 @@ std::unordered_set<ProofRef, SaltedProofHasher> PeerManager::updatedBlockTip() {
     return registeredProofs;
 }
 
+void PeerManager::blockConnected(const CBlock &block) {
+    hasConnectedBlocks = true;
+    for (const CTransactionRef &tx : block.vtx) {
+        if (tx->IsCoinBase()) {
+            continue;
+        }
+
+        for (const CTxIn &txin : tx->vin) {
+            spentUtxos.insert(txin.prevout);
+        }
+    }
+}
+
+static constexpr uint64_t PEERS_DUMP_VERSION = 1;
+
+bool PeerManager::dumpPeersToFile(const fs::path &dumpPath) const {
+    const int64_t start = GetTimeMillis();
+    const fs::path dumpPathNew = dumpPath + ".new";
+
+    try {
+        CAutoFile file(fsbridge::fopen(dumpPathNew, "wb"), SER_DISK,
+                       CLIENT_VERSION);
+        if (file.IsNull()) {
+            return false;
+        }
+
+        file << PEERS_DUMP_VERSION;
+
+        file << uint64_t(peers.size());
+        for (const Peer &peer : peers) {
+            file << *peer.proof;
+            file << peer.hasFinalized;
+            file << int64_t(count_seconds(peer.nextPossibleConflictTime));
+            file << peer.availabilityScore;
+        }
+
+        file << uint64_t(conflictingProofPool.countProofs());
+        conflictingProofPool.forEachProof(
+            [&](const ProofRef &proof) { file << *proof; });
+
+        if (!FileCommit(file.Get())) {
+            throw std::runtime_error("FileCommit failed");
+        }
+        file.fclose();
+        if (!RenameOver(dumpPathNew, dumpPath)) {
+            throw std::runtime_error("Rename failed");
+        }
+    } catch (const std::exception &e) {
+        LogPrintf("Failed to dump the avalanche peers: %s. Continuing "
+                  "anyway.\n",
+                  e.what());
+        return false;
+    }
+
+    LogPrintf("Dumped %d avalanche peers in %dms\n", peers.size(),
+              GetTimeMillis() - start);
+    return true;
+}
+
+bool PeerManager::loadPeersFromFile(
+    const fs::path &dumpPath,
+    std::unordered_set<ProofRef, SaltedProofHasher> &registeredProofs) {
+    struct DumpedPeer {
+        ProofRef proof;
+        bool hasFinalized;
+        int64_t nextPossibleConflictTime;
+        double availabilityScore;
+    };
+    std::vector<DumpedPeer> dumpedPeers;
+    std::vector<ProofRef> conflictingProofs;
+
+    CAutoFile file(fsbridge::fopen(dumpPath, "rb"), SER_DISK, CLIENT_VERSION);
+    if (file.IsNull()) {
+        LogPrintf("Failed to open the avalanche peers file from disk. "
+                  "Continuing anyway.\n");
+        return false;
+    }
+
+    try {
+        uint64_t version;
+        file >> version;
+        if (version != PEERS_DUMP_VERSION) {
+            return false;
+        }
+
+        uint64_t numPeers;
+        file >> numPeers;
+        for (uint64_t i = 0; i < numPeers; i++) {
+            DumpedPeer peer;
+            peer.proof = ProofRef::make(deserialize, file);
+            file >> peer.hasFinalized;
+            file >> peer.nextPossibleConflictTime;
+            file >> peer.availabilityScore;
+            dumpedPeers.push_back(std::move(peer));
+        }
+
+        uint64_t numConflictingProofs;
+        file >> numConflictingProofs;
+        for (uint64_t i = 0; i < numConflictingProofs; i++) {
+            conflictingProofs.push_back(ProofRef::make(deserialize, file));
+        }
+    } catch (const std::exception &e) {
+        LogPrintf("Failed to deserialize the avalanche peers: %s. Continuing "
+                  "anyway.\n",
+                  e.what());
+        return false;
+    }
+
+    // Check all the signatures at once, so registering the proofs only
+    // requires the UTXO lookups.
+    std::vector<ProofRef> proofs = conflictingProofs;
+    for (const DumpedPeer &peer : dumpedPeers) {
+        proofs.push_back(peer.proof);
+    }
+    VerifyProofSignatures(proofs);
+
+    registeredProofs.clear();
+    for (const DumpedPeer &peer : dumpedPeers) {
+        if (!registerProof(peer.proof)) {
+            continue;
+        }
+
+        auto &peersView = peers.get<by_proofid>();
+        auto it = peersView.find(peer.proof->getId());
+        assert(it != peersView.end());
+        peersView.modify(it, [&](Peer &p) {
+            p.hasFinalized = peer.hasFinalized;
+            p.nextPossibleConflictTime =
+                std::chrono::seconds{peer.nextPossibleConflictTime};
+            p.availabilityScore = peer.availabilityScore;
+        });
+        registeredProofs.insert(peer.proof);
+    }
+
+    // The conflicting proofs are only registered if they no longer conflict
+    // with the peers. Otherwise they are put back in the conflicting pool if
+    // they are still valid, without resetting the conflict cooldown of the
+    // peers.
+    for (const ProofRef &proof : conflictingProofs) {
+        const auto &stakes = proof->getStakes();
+        const bool isConflicting =
+            std::any_of(stakes.begin(), stakes.end(), [&](const auto &ss) {
+                return validProofPool.getProof(ss.getStake().getUTXO());
+            });
+        if (!isConflicting) {
+            if (registerProof(proof)) {
+                registeredProofs.insert(proof);
+            }
+            continue;
+        }
+
+        ProofValidationState state;
+        if (WITH_LOCK(cs_main, return proof->verify(stakeUtxoDustThreshold,
+                                                    chainman, state))) {
+            conflictingProofPool.addProofIfPreferred(proof);
+        }
+    }
+
+    LogPrintf("Loaded %d avalanche peers and %d conflicting proofs from "
+              "disk\n",
+              peers.size(), conflictingProofPool.countProofs());
+    return true;
+}
+
 ProofRef PeerManager::getProof(const ProofId &proofid) const {
     ProofRef proof;
 
@@ -591,19 +842,14 @@ bool PeerManager::removePeer(const PeerId peerid) {
 }
 
 PeerId PeerManager::selectPeer() const {
-    if (slots.empty() || slotCount == 0) {
+    // The free slots have no score, so they can't be selected.
+    if (connectedPeersScore == 0) {
         return NO_PEER;
     }
 
-    const uint64_t max = slotCount;
-    for (int retry = 0; retry < SELECT_PEER_MAX_RETRY; retry++) {
-        size_t i = selectPeerImpl(slots, GetRand(max), max);
-        if (i != NO_PEER) {
-            return i;
-        }
-    }
-
-    return NO_PEER;
+    const size_t i = slotScores.find(GetRand(uint64_t(connectedPeersScore)));
+    assert(slots[i].getPeerId() != NO_PEER);
+    return slots[i].getPeerId();
 }
 
 uint64_t PeerManager::compact() {
@@ -614,6 +860,7 @@ uint64_t PeerManager::compact() {
 
     std::vector<Slot> newslots;
     newslots.reserve(peers.size());
+    slotScores.clear();
 
     uint64_t prevStop = 0;
     uint32_t i = 0;
@@ -623,6 +870,7 @@ uint64_t PeerManager::compact() {
         }
 
         newslots.emplace_back(prevStop, it->getScore(), it->peerid);
+        slotScores.push_back(it->getScore());
         prevStop = slots[i].getStop();
         if (!peers.modify(it, [&](Peer &p) { p.index = i++; })) {
             return 0;
@@ -671,6 +919,12 @@ bool PeerManager::verify() const {
         return false;
     }
 
+    // The selection tree must match the slots
+    if (slotScores.size() != slots.size() ||
+        slotScores.total() != connectedPeersScore) {
+        return false;
+    }
+
     uint32_t scoreFromAllPeers = 0;
     uint32_t scoreFromPeersWithNodes = 0;
 
@@ -12,8 +12,11 @@
 #include <bloom.h>
 #include <coins.h>
 #include <consensus/validation.h>
+#include <fs.h>
+#include <primitives/block.h>
 #include <pubkey.h>
 #include <radix.h>
+#include <util/fenwicktree.h>
 #include <util/hasher.h>
 #include <util/time.h>
 
@@ -28,6 +31,7 @@
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 class ChainstateManager;
@@ -121,6 +125,13 @@ struct score_index {
     result_type operator()(const Peer &p) const { return p.getScore(); }
 };
 
+struct expiration_index {
+    using result_type = int64_t;
+    result_type operator()(const Peer &p) const {
+        return p.proof->getExpirationTime();
+    }
+};
+
 struct next_request_time {};
 
 struct PendingNode {
@@ -134,6 +145,7 @@ struct PendingNode {
 struct by_proofid;
 struct by_nodeid;
 struct by_score;
+struct by_expiration;
 
 enum class ProofRegistrationResult {
     NONE = 0,
@@ -157,6 +169,14 @@ class PeerManager {
     uint64_t slotCount = 0;
     uint64_t fragmentation = 0;
 
+    /**
+     * The score of each slot, or zero if the slot is no longer allocated.
+     * This makes it possible to select a slot in O(log n) no matter how
+     * fragmented the slots are, so they only need to be compacted to reclaim
+     * the memory.
+     */
+    FenwickTree<uint64_t> slotScores;
+
     /**
      * Several nodes can make an avalanche peer. In this case, all nodes are
      * considered interchangeable parts of the same peer.
@@ -170,7 +190,10 @@ class PeerManager {
                                      SaltedProofIdHasher>,
                   // ordered by score, decreasing order
                   bmi::ordered_non_unique<bmi::tag<by_score>, score_index,
-                                          std::greater<uint32_t>>>>;
+                                          std::greater<uint32_t>>,
+                  // ordered by expiration time
+                  bmi::ordered_non_unique<bmi::tag<by_expiration>,
+                                          expiration_index>>>;
 
     PeerId nextPeerId = 0;
     PeerSet peers;
@@ -216,7 +239,6 @@ class PeerManager {
                 bmi::member<PendingNode, NodeId, &PendingNode::nodeid>>>>;
     PendingNodeSet pendingNodes;
 
-    static constexpr int SELECT_PEER_MAX_RETRY = 3;
     static constexpr int SELECT_NODE_MAX_RETRY = 3;
 
     /**
@@ -243,6 +265,16 @@ class PeerManager {
 
     ChainstateManager &chainman;
 
+    /**
+     * The utxos spent by the blocks connected since the last tip update. If
+     * no block was disconnected in the meantime, only the proofs staking one
+     * of these utxos or reaching their expiration or maturity are re-evaluated
+     * by updatedBlockTip, rather than all of them.
+     */
+    std::unordered_set<COutPoint, SaltedOutpointHasher> spentUtxos;
+    bool hasConnectedBlocks = false;
+    bool hasDisconnectedBlocks = false;
+
 public:
     PeerManager(const Amount &stakeUtxoDustThresholdIn,
                 ChainstateManager &chainmanIn)
@@ -367,6 +399,32 @@ public:
      */
     std::unordered_set<ProofRef, SaltedProofHasher> updatedBlockTip();
 
+    /**
+     * Keep track of the blocks connected and disconnected since the last tip
+     * update, so updatedBlockTip can only re-evaluate the affected proofs. If
+     * it is called without being notified of the blocks, all the proofs are
+     * re-evaluated.
+     */
+    void blockConnected(const CBlock &block);
+    void blockDisconnected() { hasDisconnectedBlocks = true; }
+
+    /**
+     * Save the proofs of the peers, along with their state, and the
+     * conflicting proofs so they don't need to be downloaded again after a
+     * restart.
+     */
+    bool dumpPeersToFile(const fs::path &dumpPath) const;
+
+    /**
+     * Register the proofs saved by dumpPeersToFile. Their signatures are
+     * checked in parallel, then they are verified against the current UTXO set
+     * like the proofs received from the network. The proofs that are now
+     * registered are returned so they can be polled.
+     */
+    bool loadPeersFromFile(
+        const fs::path &dumpPath,
+        std::unordered_set<ProofRef, SaltedProofHasher> &registeredProofs);
+
     /**
      * Proof broadcast API.
      */
@@ -409,7 +467,8 @@ public:
     bool removePeer(const PeerId peerid);
 
     /**
-     * Randomly select a peer to poll.
+     * Randomly select a peer to poll, with a probability proportional to its
+     * score. Only returns NO_PEER if no peer has a node attached.
      */
     PeerId selectPeer() const;
 
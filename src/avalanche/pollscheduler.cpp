@@ -0,0 +1,68 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/pollscheduler.h>
+
+#include <algorithm>
+
+namespace avalanche {
+
+PollScheduler::NodeState &PollScheduler::getOrCreate(NodeId nodeid) {
+    return nodes.try_emplace(nodeid, maxPollSize).first->second;
+}
+
+size_t PollScheduler::getPollSize(NodeId nodeid) const {
+    auto it = nodes.find(nodeid);
+    return it == nodes.end() ? maxPollSize : it->second.window;
+}
+
+void PollScheduler::responseReceived(NodeId nodeid,
+                                     std::chrono::microseconds latency) {
+    NodeState &state = getOrCreate(nodeid);
+
+    if (state.responses == 0) {
+        state.latency = latency;
+    } else {
+        state.latency +=
+            (latency - state.latency) / (1 << POLL_LATENCY_SMOOTHING_SHIFT);
+    }
+    state.responses++;
+    state.window = std::min(state.window + 1, maxPollSize);
+}
+
+void PollScheduler::pollTimedOut(NodeId nodeid) {
+    NodeState &state = getOrCreate(nodeid);
+
+    state.timeouts++;
+    state.window = std::max<size_t>(state.window / 2, 1);
+}
+
+PollStats PollScheduler::getStats() const {
+    PollStats stats;
+    stats.nodeCount = nodes.size();
+
+    size_t respondingNodes = 0;
+    size_t totalPollSize = 0;
+    for (const auto &[nodeid, state] : nodes) {
+        stats.responses += state.responses;
+        stats.timeouts += state.timeouts;
+        totalPollSize += state.window;
+
+        if (state.responses > 0) {
+            stats.averageLatency += state.latency;
+            respondingNodes++;
+        }
+    }
+
+    if (respondingNodes > 0) {
+        stats.averageLatency /= respondingNodes;
+    }
+    if (stats.nodeCount > 0) {
+        stats.averagePollSize = double(totalPollSize) / stats.nodeCount;
+    }
+
+    return stats;
+}
+
+} // namespace avalanche
@@ -0,0 +1,78 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_AVALANCHE_POLLSCHEDULER_H
+#define BITCOIN_AVALANCHE_POLLSCHEDULER_H
+
+#include <nodeid.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace avalanche {
+
+/**
+ * Weight of a new latency sample in the moving average, as a power of two.
+ * This gives the last sample a weight of 1/8, like the TCP round trip time.
+ */
+static constexpr int POLL_LATENCY_SMOOTHING_SHIFT = 3;
+
+/** Polling statistics summed or averaged over all the tracked nodes */
+struct PollStats {
+    size_t nodeCount{0};
+    uint64_t responses{0};
+    uint64_t timeouts{0};
+    std::chrono::microseconds averageLatency{0};
+    double averagePollSize{0};
+};
+
+/**
+ * Adapt the number of items each node is polled for to how it responds.
+ *
+ * Every node has a window of items it can be polled for at once, which
+ * grows by one item each time it responds and is halved each time a poll
+ * times out. The items only allow for a few polls in flight at once, so this
+ * prevents the slow or unreliable nodes from holding them until the polls
+ * time out, while the responsive nodes get full polls.
+ */
+class PollScheduler {
+    struct NodeState {
+        size_t window;
+        uint64_t responses{0};
+        uint64_t timeouts{0};
+        std::chrono::microseconds latency{0};
+
+        explicit NodeState(size_t windowIn) : window(windowIn) {}
+    };
+
+    std::unordered_map<NodeId, NodeState> nodes;
+    const size_t maxPollSize;
+
+    NodeState &getOrCreate(NodeId nodeid);
+
+public:
+    explicit PollScheduler(size_t maxPollSizeIn) : maxPollSize(maxPollSizeIn) {}
+
+    /** The maximum number of items to poll the node for */
+    size_t getPollSize(NodeId nodeid) const;
+
+    /** Record that the node responded to a poll after the given time */
+    void responseReceived(NodeId nodeid, std::chrono::microseconds latency);
+
+    /**
+     * Record that a poll timed out. An invalid response gets the node banned,
+     * so it doesn't need to be accounted for.
+     */
+    void pollTimedOut(NodeId nodeid);
+
+    void removeNode(NodeId nodeid) { nodes.erase(nodeid); }
+
+    PollStats getStats() const;
+};
+
+} // namespace avalanche
+
+#endif // BITCOIN_AVALANCHE_POLLSCHEDULER_H
@@ -20,6 +20,7 @@
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <tuple>
@@ -129,6 +130,16 @@ class Processor::NotificationsHandler
 public:
     NotificationsHandler(Processor *p) : m_processor(p) {}
 
+    void blockConnected(const CBlock &block, int height) override {
+        LOCK(m_processor->cs_peerManager);
+        m_processor->peerManager->blockConnected(block);
+    }
+
+    void blockDisconnected(const CBlock &block, int height) override {
+        LOCK(m_processor->cs_peerManager);
+        m_processor->peerManager->blockDisconnected();
+    }
+
     void updatedBlockTip() override {
         const bool registerLocalProof = m_processor->canShareLocalProof();
         auto registerProofs = [&]() {
@@ -167,12 +178,13 @@ Processor::Processor(Config avaconfigIn, interfaces::Chain &chain,
                      double minQuorumConnectedScoreRatioIn,
                      int64_t minAvaproofsNodeCountIn,
                      uint32_t staleVoteThresholdIn, uint32_t staleVoteFactorIn,
-                     Amount stakeUtxoDustThreshold)
+                     Amount stakeUtxoDustThreshold, fs::path peersDumpPathIn)
     : avaconfig(std::move(avaconfigIn)), connman(connmanIn),
       chainman(chainmanIn), mempool(mempoolIn),
       voteRecords(RWCollection<VoteMap>(VoteMap(VoteMapComparator(mempool)))),
       round(0), peerManager(std::make_unique<PeerManager>(
                     stakeUtxoDustThreshold, chainman)),
+      peersDumpPath(std::move(peersDumpPathIn)),
       peerData(std::move(peerDataIn)), sessionKey(std::move(sessionKeyIn)),
       minQuorumScore(minQuorumTotalScoreIn),
       minQuorumConnectedScoreRatio(minQuorumConnectedScoreRatioIn),
@@ -190,11 +202,33 @@ Processor::Processor(Config avaconfigIn, interfaces::Chain &chain,
             return true;
         },
         5min);
+
+    if (avaconfig.latencyLogPeriod.count() > 0) {
+        scheduler.scheduleEvery(
+            [this]() -> bool {
+                logLatencySummary();
+                return true;
+            },
+            avaconfig.latencyLogPeriod);
+    }
+
+    if (!peersDumpPath.empty()) {
+        std::unordered_set<ProofRef, SaltedProofHasher> registeredProofs;
+        WITH_LOCK(cs_peerManager, peerManager->loadPeersFromFile(
+                                      peersDumpPath, registeredProofs));
+        for (const ProofRef &proof : registeredProofs) {
+            addToReconcile(proof);
+        }
+    }
 }
 
 Processor::~Processor() {
     chainNotificationsHandler.reset();
     stopEventLoop();
+
+    if (!peersDumpPath.empty()) {
+        WITH_LOCK(cs_peerManager, peerManager->dumpPeersToFile(peersDumpPath));
+    }
 }
 
 std::unique_ptr<Processor>
@@ -370,7 +404,22 @@ Processor::MakeProcessor(const ArgsManager &argsman, interfaces::Chain &chain,
         return nullptr;
     }
 
-    Config avaconfig(queryTimeoutDuration);
+    const int64_t latencyLogPeriod = argsman.GetIntArg(
+        "-avalatencylogperiod", AVALANCHE_DEFAULT_LATENCY_LOG_PERIOD.count());
+    if (latencyLogPeriod < 0) {
+        error = _("The avalanche latency log period must be positive or 0");
+        return nullptr;
+    }
+
+    Config avaconfig(queryTimeoutDuration,
+                     std::chrono::seconds(latencyLogPeriod));
+
+    fs::path peersDumpPath;
+    if (isAvalancheEnabled(argsman) &&
+        argsman.GetBoolArg("-persistavapeers",
+                           AVALANCHE_DEFAULT_PERSIST_PEERS)) {
+        peersDumpPath = argsman.GetDataDirNet() / "avapeers.dat";
+    }
 
     // We can't use std::make_unique with a private constructor
     return std::unique_ptr<Processor>(new Processor(
@@ -378,7 +427,7 @@ Processor::MakeProcessor(const ArgsManager &argsman, interfaces::Chain &chain,
         std::move(peerData), std::move(sessionKey),
         Proof::amountToScore(minQuorumStake), minQuorumConnectedStakeRatio,
         minAvaproofsNodeCount, staleVoteThreshold, staleVoteFactor,
-        stakeUtxoDustThreshold));
+        stakeUtxoDustThreshold, std::move(peersDumpPath)));
 }
 
 static bool isNull(const AnyVoteItem &item) {
@@ -471,6 +520,43 @@ void Processor::sendResponse(CNode *pfrom, Response response) const {
 bool Processor::registerVotes(NodeId nodeid, const Response &response,
                               std::vector<VoteItemUpdate> &updates,
                               int &banscore, std::string &error) {
+    ItemVotesMap itemVotes((VoteMapComparator(mempool)));
+    if (!collectVotes(nodeid, response, itemVotes, banscore, error)) {
+        return false;
+    }
+
+    applyVotes(itemVotes, updates);
+    return true;
+}
+
+bool Processor::registerVotes(std::vector<PollResponse> &responses,
+                              std::vector<VoteItemUpdate> &updates) {
+    ItemVotesMap itemVotes((VoteMapComparator(mempool)));
+
+    bool allValid = true;
+    for (PollResponse &r : responses) {
+        // A bad response must not void the votes from the other ones, so
+        // collect into a separate map and merge only if it is valid.
+        ItemVotesMap responseVotes((VoteMapComparator(mempool)));
+        if (!collectVotes(r.nodeid, r.response, responseVotes, r.banscore,
+                          r.error)) {
+            allValid = false;
+            continue;
+        }
+
+        for (auto &[item, nodeVotes] : responseVotes) {
+            NodeVotes &v = itemVotes[item];
+            v.insert(v.end(), nodeVotes.begin(), nodeVotes.end());
+        }
+    }
+
+    applyVotes(itemVotes, updates);
+    return allValid;
+}
+
+bool Processor::collectVotes(NodeId nodeid, const Response &response,
+                             ItemVotesMap &itemVotes, int &banscore,
+                             std::string &error) {
     {
         // Save the time at which we can query again.
         LOCK(cs_peerManager);
@@ -484,6 +570,7 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
     }
 
     std::vector<CInv> invs;
+    std::chrono::microseconds latency;
 
     {
         // Check that the query exists.
@@ -496,6 +583,8 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
         }
 
         invs = std::move(it->invs);
+        latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - it->sent);
         w->erase(it);
     }
 
@@ -512,12 +601,19 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
         if (invs[i].hash != votes[i].GetHash()) {
             banscore = 100;
             error = "invalid-ava-response-content";
-            return false;
+                return false;
         }
     }
 
-    std::map<AnyVoteItem, Vote, VoteMapComparator> responseItems(
-        (VoteMapComparator(mempool)));
+    WITH_LOCK(cs_pollScheduler,
+              pollScheduler.responseReceived(nodeid, latency));
+
+    {
+        LOCK(cs_latencyStats);
+        latencyStats.pollRoundTripTime.Add(latency.count());
+        latencyStats.nodePollRoundTripTime[nodeid].Add(latency.count());
+        latencyStats.votesPerPoll.Add(votes.size());
+    }
 
     // At this stage we are certain that invs[i] matches votes[i], so we can use
     // the inv type to retrieve what is being voted on.
@@ -534,15 +630,23 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
             continue;
         }
 
-        responseItems.insert(std::make_pair(std::move(item), votes[i]));
+        // A node only gets one vote per item and per response.
+        NodeVotes &nodeVotes = itemVotes[std::move(item)];
+        if (nodeVotes.empty() || nodeVotes.back().first != nodeid) {
+            nodeVotes.emplace_back(nodeid, votes[i].GetError());
+        }
     }
 
+    return true;
+}
+
+void Processor::applyVotes(const ItemVotesMap &itemVotes,
+                           std::vector<VoteItemUpdate> &updates) {
     auto voteRecordsWriteView = voteRecords.getWriteView();
 
     // Register votes.
-    for (const auto &p : responseItems) {
+    for (const auto &p : itemVotes) {
         auto item = p.first;
-        const Vote &v = p.second;
 
         auto it = voteRecordsWriteView->find(item);
         if (it == voteRecordsWriteView.end()) {
@@ -551,7 +655,7 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
         }
 
         auto &vr = it->second;
-        if (!vr.registerVote(nodeid, v.GetError())) {
+        if (!vr.registerVotes(p.second)) {
             if (vr.isStale(staleVoteThreshold, staleVoteFactor)) {
                 updates.emplace_back(std::move(item), VoteStatus::Stale);
 
@@ -572,6 +676,29 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
             continue;
         }
 
+        {
+            const uint64_t elapsedMillis =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() -
+                    vr.getRegistrationTime())
+                    .count();
+
+            LOCK(cs_latencyStats);
+            std::visit(
+                variant::overloaded{
+                    [&](const ProofRef &) {
+                        latencyStats.proofFinalizationTime.Add(elapsedMillis);
+                    },
+                    [&](const CBlockIndex *) {
+                        latencyStats.blockFinalizationTime.Add(elapsedMillis);
+                    },
+                    [&](const CTransactionRef &) {
+                        latencyStats.txFinalizationTime.Add(elapsedMillis);
+                    },
+                },
+                item);
+        }
+
         // We just finalized a vote. If it is valid, then let the caller
         // know. Either way, remove the item from the map.
         updates.emplace_back(std::move(item), vr.isAccepted()
@@ -622,8 +749,25 @@ bool Processor::registerVotes(NodeId nodeid, const Response &response,
 
         finalizationTip = pindex;
     }
+}
 
-    return true;
+void Processor::logLatencySummary() const {
+    const LatencyStats stats = getLatencyStats();
+
+    auto summarize = [](const Log2Histogram &histogram, const char *unit) {
+        return strprintf("%u, p50 %u%s, p90 %u%s", histogram.GetCount(),
+                         histogram.GetPercentileUpperBound(50), unit,
+                         histogram.GetPercentileUpperBound(90), unit);
+    };
+
+    LogPrintf("Avalanche latencies: finalized blocks %s, proofs %s, txs %s; "
+              "responses %s, %u votes per poll on average; %u timed out "
+              "polls\n",
+              summarize(stats.blockFinalizationTime, "ms"),
+              summarize(stats.proofFinalizationTime, "ms"),
+              summarize(stats.txFinalizationTime, "ms"),
+              summarize(stats.pollRoundTripTime, "us"),
+              stats.votesPerPoll.GetMean(), stats.timedOutPolls);
 }
 
 CPubKey Processor::getSessionPubKey() const {
@@ -819,6 +963,9 @@ void Processor::FinalizeNode(const ::Config &config, const CNode &node) {
     const NodeId nodeid = node.GetId();
     WITH_LOCK(cs_peerManager, peerManager->removeNode(nodeid));
     WITH_LOCK(cs_delayedAvahelloNodeIds, delayedAvahelloNodeIds.erase(nodeid));
+    WITH_LOCK(cs_pollScheduler, pollScheduler.removeNode(nodeid));
+    WITH_LOCK(cs_latencyStats,
+              latencyStats.nodePollRoundTripTime.erase(nodeid));
 }
 
 void Processor::runEventLoop() {
@@ -837,7 +984,9 @@ void Processor::runEventLoop() {
     if (nodeid == NO_NODE) {
         return;
     }
-    std::vector<CInv> invs = getInvsForNextPoll();
+    const size_t pollSize =
+        WITH_LOCK(cs_pollScheduler, return pollScheduler.getPollSize(nodeid));
+    std::vector<CInv> invs = getInvsForNextPoll(true, pollSize);
     if (invs.empty()) {
         return;
     }
@@ -857,11 +1006,11 @@ void Processor::runEventLoop() {
 
                 {
                     // Compute the time at which this requests times out.
-                    auto timeout = std::chrono::steady_clock::now() +
-                                   avaconfig.queryTimeoutDuration;
+                    const auto now = std::chrono::steady_clock::now();
+                    auto timeout = now + avaconfig.queryTimeoutDuration;
                     // Register the query.
                     queries.getWriteView()->insert(
-                        {pnode->GetId(), current_round, timeout, invs});
+                        {pnode->GetId(), current_round, now, timeout, invs});
                     // Set the timeout.
                     peerManager->updateNextRequestTime(pnode->GetId(), timeout);
                 }
@@ -892,6 +1041,7 @@ void Processor::runEventLoop() {
 void Processor::clearTimedoutRequests() {
     auto now = std::chrono::steady_clock::now();
     std::map<CInv, uint8_t> timedout_items{};
+    std::vector<NodeId> timedout_nodes;
 
     {
         // Clear expired requests.
@@ -902,10 +1052,20 @@ void Processor::clearTimedoutRequests() {
                 timedout_items[i]++;
             }
 
+            timedout_nodes.push_back(it->nodeid);
             w->get<query_timeout>().erase(it++);
         }
     }
 
+    {
+        LOCK(cs_pollScheduler);
+        for (const NodeId nodeid : timedout_nodes) {
+            pollScheduler.pollTimedOut(nodeid);
+        }
+    }
+    WITH_LOCK(cs_latencyStats,
+              latencyStats.timedOutPolls += timedout_nodes.size());
+
     if (timedout_items.empty()) {
         return;
     }
@@ -928,7 +1088,8 @@ void Processor::clearTimedoutRequests() {
     }
 }
 
-std::vector<CInv> Processor::getInvsForNextPoll(bool forPoll) {
+std::vector<CInv> Processor::getInvsForNextPoll(bool forPoll,
+                                                size_t maxElements) {
     std::vector<CInv> invs;
 
     {
@@ -955,7 +1116,7 @@ std::vector<CInv> Processor::getInvsForNextPoll(bool forPoll) {
 
     auto r = voteRecords.getReadView();
     for (const auto &[item, voteRecord] : r) {
-        if (invs.size() >= AVALANCHE_MAX_ELEMENT_POLL) {
+        if (invs.size() >= std::min(maxElements, AVALANCHE_MAX_ELEMENT_POLL)) {
             // Make sure we do not produce more invs than specified by the
             // protocol.
             return invs;
@@ -7,6 +7,7 @@
 
 #include <avalanche/config.h>
 #include <avalanche/node.h>
+#include <avalanche/pollscheduler.h>
 #include <avalanche/proof.h>
 #include <avalanche/proofcomparator.h>
 #include <avalanche/protocol.h>
@@ -15,12 +16,14 @@
 #include <blockindexcomparators.h>
 #include <bloom.h>
 #include <eventloop.h>
+#include <fs.h>
 #include <interfaces/chain.h>
 #include <interfaces/handler.h>
 #include <key.h>
 #include <net.h>
 #include <primitives/transaction.h>
 #include <rwcollection.h>
+#include <util/histogram.h>
 #include <util/variant.h>
 
 #include <boost/multi_index/composite_key.hpp>
@@ -33,6 +36,7 @@
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -66,6 +70,16 @@ static constexpr std::chrono::milliseconds AVALANCHE_DEFAULT_QUERY_TIMEOUT{
 static constexpr uint32_t AVALANCHE_FINALIZED_ITEMS_FILTER_NUM_ELEMENTS =
     AVALANCHE_MAX_INFLIGHT_POLL * 20;
 
+/**
+ * Default for -avalatencylogperiod, 0 to disable the periodic summary.
+ */
+static constexpr std::chrono::seconds AVALANCHE_DEFAULT_LATENCY_LOG_PERIOD{0};
+
+/**
+ * Default for -persistavapeers
+ */
+static constexpr bool AVALANCHE_DEFAULT_PERSIST_PEERS = false;
+
 namespace avalanche {
 
 class Delegation;
@@ -169,6 +183,37 @@ public:
 };
 using VoteMap = std::map<AnyVoteItem, VoteRecord, VoteMapComparator>;
 
+/** The votes for an item along with the node they come from, in order */
+using NodeVotes = std::vector<std::pair<NodeId, uint32_t>>;
+using ItemVotesMap = std::map<AnyVoteItem, NodeVotes, VoteMapComparator>;
+
+/** A response to a poll, and the reason why it was rejected if it was */
+struct PollResponse {
+    NodeId nodeid;
+    Response response;
+    int banscore{0};
+    std::string error;
+
+    PollResponse(NodeId nodeidIn, Response responseIn)
+        : nodeid(nodeidIn), response(std::move(responseIn)) {}
+};
+
+/** Latency statistics of the avalanche polls and votes */
+struct LatencyStats {
+    //! Time from the start of the vote on an item to its finalization or
+    //! invalidation, in milliseconds, for each type of item
+    Log2Histogram blockFinalizationTime;
+    Log2Histogram proofFinalizationTime;
+    Log2Histogram txFinalizationTime;
+    //! Time between a poll and its response, in microseconds, over all the
+    //! nodes and for each connected node
+    Log2Histogram pollRoundTripTime;
+    std::unordered_map<NodeId, Log2Histogram> nodePollRoundTripTime;
+    //! Number of votes in each valid response
+    Log2Histogram votesPerPoll;
+    uint64_t timedOutPolls{0};
+};
+
 struct query_timeout {};
 
 namespace {
@@ -202,6 +247,7 @@ class Processor final : public NetEventsInterface {
     struct Query {
         NodeId nodeid;
         uint64_t round;
+        TimePoint sent;
         TimePoint timeout;
 
         /**
@@ -229,6 +275,20 @@ class Processor final : public NetEventsInterface {
 
     RWCollection<QuerySet> queries;
 
+    mutable Mutex cs_latencyStats;
+    LatencyStats latencyStats GUARDED_BY(cs_latencyStats);
+
+    /** Decide how many items each node gets polled for. */
+    mutable Mutex cs_pollScheduler;
+    PollScheduler pollScheduler GUARDED_BY(cs_pollScheduler){
+        AVALANCHE_MAX_ELEMENT_POLL};
+
+    /**
+     * Where the peers are saved on shutdown and loaded from on startup, or
+     * empty if they are not persisted.
+     */
+    const fs::path peersDumpPath;
+
     /** Data required to participate. */
     struct PeerData;
     std::unique_ptr<PeerData> peerData;
@@ -272,7 +332,8 @@ class Processor final : public NetEventsInterface {
               CKey sessionKeyIn, uint32_t minQuorumTotalScoreIn,
               double minQuorumConnectedScoreRatioIn,
               int64_t minAvaproofsNodeCountIn, uint32_t staleVoteThresholdIn,
-              uint32_t staleVoteFactorIn, Amount stakeUtxoDustThresholdIn);
+              uint32_t staleVoteFactorIn, Amount stakeUtxoDustThresholdIn,
+              fs::path peersDumpPathIn);
 
 public:
     ~Processor();
@@ -292,6 +353,21 @@ public:
     bool registerVotes(NodeId nodeid, const Response &response,
                        std::vector<VoteItemUpdate> &updates, int &banscore,
                        std::string &error);
+    /**
+     * Register the votes from several responses at once. The votes for the
+     * same item are grouped so its vote record is looked up and updated only
+     * once. Returns false if any of the responses is rejected, in which case
+     * its banscore and error are set and its votes are ignored.
+     */
+    bool registerVotes(std::vector<PollResponse> &responses,
+                       std::vector<VoteItemUpdate> &updates);
+
+    LatencyStats getLatencyStats() const {
+        return WITH_LOCK(cs_latencyStats, return latencyStats);
+    }
+    PollStats getPollStats() const {
+        return WITH_LOCK(cs_pollScheduler, return pollScheduler.getStats());
+    }
 
     template <typename Callable> auto withPeerManager(Callable &&func) const {
         LOCK(cs_peerManager);
@@ -343,11 +419,25 @@ public:
 private:
     void runEventLoop();
     void clearTimedoutRequests();
-    std::vector<CInv> getInvsForNextPoll(bool forPoll = true);
+    std::vector<CInv>
+    getInvsForNextPoll(bool forPoll = true,
+                       size_t maxElements = AVALANCHE_MAX_ELEMENT_POLL);
     bool sendHelloInternal(CNode *pfrom)
         EXCLUSIVE_LOCKS_REQUIRED(cs_delayedAvahelloNodeIds);
     AnyVoteItem getVoteItemFromInv(const CInv &inv) const;
 
+    /**
+     * Check that the response matches a query we made and add its votes to
+     * the map.
+     */
+    bool collectVotes(NodeId nodeid, const Response &response,
+                      ItemVotesMap &itemVotes, int &banscore,
+                      std::string &error);
+    void applyVotes(const ItemVotesMap &itemVotes,
+                    std::vector<VoteItemUpdate> &updates);
+
+    void logLatencySummary() const;
+
     /**
      * We don't need many blocks but a low false positive rate.
      * In the event of a false positive the node might skip polling this block.
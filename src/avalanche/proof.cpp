@@ -16,6 +16,8 @@
 
 #include <tinyformat.h>
 
+#include <algorithm>
+#include <future>
 #include <numeric>
 #include <unordered_set>
 
@@ -125,7 +127,11 @@ bool Proof::verify(const Amount &stakeUtxoDustThreshold,
                              "payout-script-non-standard");
     }
 
-    if (!master.VerifySchnorr(limitedProofId, signature)) {
+    // Check all the signatures upfront, in parallel for the large proofs. If
+    // any is invalid, the checks below will find which one.
+    const bool signaturesValid = VerifyProofSignatures({this});
+
+    if (!signaturesValid && !master.VerifySchnorr(limitedProofId, signature)) {
         return state.Invalid(ProofValidationResult::INVALID_PROOF_SIGNATURE,
                              "invalid-proof-signature");
     }
@@ -152,7 +158,7 @@ bool Proof::verify(const Amount &stakeUtxoDustThreshold,
                                  "duplicated-stake");
         }
 
-        if (!ss.verify(getStakeCommitment())) {
+        if (!signaturesValid && !ss.verify(getStakeCommitment())) {
             return state.Invalid(
                 ProofValidationResult::INVALID_STAKE_SIGNATURE,
                 "invalid-stake-signature",
@@ -163,6 +169,82 @@ bool Proof::verify(const Amount &stakeUtxoDustThreshold,
     return true;
 }
 
+bool VerifyProofSignatures(const std::vector<const Proof *> &proofs) {
+    // Each check is a (proof, signature) pair. The signature index is the
+    // stake index, and the master signature comes after the stakes.
+    std::vector<std::pair<size_t, size_t>> checks;
+    std::vector<StakeCommitment> commitments;
+    commitments.reserve(proofs.size());
+    for (size_t i = 0; i < proofs.size(); i++) {
+        const Proof &proof = *proofs[i];
+        commitments.push_back(proof.getStakeCommitment());
+        if (proof.signaturesVerified) {
+            continue;
+        }
+        for (size_t j = 0; j <= proof.stakes.size(); j++) {
+            checks.emplace_back(i, j);
+        }
+    }
+
+    std::vector<std::atomic<bool>> invalid(proofs.size());
+    std::atomic<size_t> next{0};
+    auto checkSignatures = [&]() {
+        size_t begin;
+        while ((begin = next.fetch_add(AVALANCHE_MIN_SIGNATURES_PER_THREAD)) <
+               checks.size()) {
+            const size_t end = std::min(
+                begin + AVALANCHE_MIN_SIGNATURES_PER_THREAD, checks.size());
+            for (size_t k = begin; k < end; k++) {
+                const auto &[i, j] = checks[k];
+                if (invalid[i]) {
+                    continue;
+                }
+
+                const Proof &proof = *proofs[i];
+                const bool valid =
+                    j < proof.stakes.size()
+                        ? proof.stakes[j].verify(commitments[i])
+                        : proof.master.VerifySchnorr(proof.limitedProofId,
+                                                     proof.signature);
+                if (!valid) {
+                    invalid[i] = true;
+                }
+            }
+        }
+    };
+
+    const size_t n_threads = std::clamp<size_t>(
+        checks.size() / AVALANCHE_MIN_SIGNATURES_PER_THREAD, 1,
+        std::clamp(GetNumCores(), 1, AVALANCHE_MAX_PROOF_VERIFICATION_THREADS));
+    {
+        std::vector<std::future<void>> workers;
+        for (size_t t = 1; t < n_threads; t++) {
+            workers.push_back(std::async(std::launch::async, checkSignatures));
+        }
+        checkSignatures();
+    }
+
+    bool allValid = true;
+    for (size_t i = 0; i < proofs.size(); i++) {
+        if (invalid[i]) {
+            allValid = false;
+            continue;
+        }
+        proofs[i]->signaturesVerified = true;
+    }
+
+    return allValid;
+}
+
+bool VerifyProofSignatures(const std::vector<ProofRef> &proofs) {
+    std::vector<const Proof *> rawProofs;
+    rawProofs.reserve(proofs.size());
+    for (const ProofRef &proof : proofs) {
+        rawProofs.push_back(proof.get());
+    }
+    return VerifyProofSignatures(rawProofs);
+}
+
 bool Proof::verify(const Amount &stakeUtxoDustThreshold,
                    const ChainstateManager &chainman,
                    ProofValidationState &state) const {
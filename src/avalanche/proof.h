@@ -16,6 +16,7 @@
 #include <validation.h> // For ChainstateManager and cs_main
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <optional>
 #include <vector>
@@ -34,6 +35,17 @@ static constexpr int AVALANCHE_MAX_PROOF_STAKES = 1000;
  */
 static constexpr int AVALANCHE_DEFAULT_STAKE_UTXO_CONFIRMATIONS = 2016;
 
+/**
+ * Maximum number of threads used to check the signatures of the proofs.
+ */
+static constexpr int AVALANCHE_MAX_PROOF_VERIFICATION_THREADS = 8;
+
+/**
+ * Minimum number of signatures to check per thread. Below this the cost of
+ * starting a thread outweighs the parallel speedup.
+ */
+static constexpr size_t AVALANCHE_MIN_SIGNATURES_PER_THREAD = 32;
+
 namespace avalanche {
 
 /** Minimum amount per utxo */
@@ -114,6 +126,10 @@ class Proof {
     uint32_t score;
     void computeScore();
 
+    //! Set once the master and stake signatures are known to be valid, so they
+    //! are not checked again each time the proof is re-evaluated.
+    mutable std::atomic<bool> signaturesVerified{false};
+
     IMPLEMENT_RCU_REFCOUNT(uint64_t);
 
 public:
@@ -137,7 +153,8 @@ public:
           payoutScriptPubKey(std::move(other.payoutScriptPubKey)),
           signature(std::move(other.signature)),
           limitedProofId(std::move(other.limitedProofId)),
-          proofid(std::move(other.proofid)), score(other.score) {}
+          proofid(std::move(other.proofid)), score(other.score),
+          signaturesVerified(other.signaturesVerified.load()) {}
 
     /**
      * Deserialization constructor.
@@ -151,6 +168,7 @@ public:
         READWRITE(obj.payoutScriptPubKey, obj.signature);
         SER_READ(obj, obj.computeProofId());
         SER_READ(obj, obj.computeScore());
+        SER_READ(obj, obj.signaturesVerified = false);
     }
 
     static bool FromHex(Proof &proof, const std::string &hexProof,
@@ -180,10 +198,25 @@ public:
                 const ChainstateManager &chainman,
                 ProofValidationState &state) const
         EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    friend bool VerifyProofSignatures(const std::vector<const Proof *> &proofs);
 };
 
 using ProofRef = RCUPtr<const Proof>;
 
+/**
+ * Check the master and stake signatures of several proofs at once, spreading
+ * the checks over up to AVALANCHE_MAX_PROOF_VERIFICATION_THREADS threads. The
+ * proofs with valid signatures are remembered as such, so the subsequent calls
+ * to Proof::verify only perform the cheap checks. This is intended to be run
+ * ahead of the proof registration for the proofs that are received together.
+ *
+ * Returns true if the signatures of all the proofs are valid. The invalid
+ * proofs are left untouched, and Proof::verify will report the error.
+ */
+bool VerifyProofSignatures(const std::vector<const Proof *> &proofs);
+bool VerifyProofSignatures(const std::vector<ProofRef> &proofs);
+
 class SaltedProofHasher : private SaltedUint256Hasher {
 public:
     SaltedProofHasher() : SaltedUint256Hasher() {}
@@ -0,0 +1,126 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/mempoolsketch.h>
+
+#include <primitives/txid.h>
+#include <random.h>
+#include <streams.h>
+#include <version.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace avalanche;
+
+BOOST_FIXTURE_TEST_SUITE(mempoolsketch_tests, BasicTestingSetup)
+
+static std::vector<uint64_t> GetSortedShortIds(const MempoolSketch &sketch,
+                                               const std::vector<TxId> &txids) {
+    std::vector<uint64_t> shortids;
+    for (const TxId &txid : txids) {
+        shortids.push_back(sketch.getShortID(txid));
+    }
+    std::sort(shortids.begin(), shortids.end());
+    return shortids;
+}
+
+BOOST_AUTO_TEST_CASE(mempool_diff) {
+    // The decoding fails with a small probability, so the txids are picked
+    // deterministically.
+    FastRandomContext rng(true);
+    auto randomTxIds = [&](size_t count) {
+        std::vector<TxId> txids;
+        for (size_t i = 0; i < count; i++) {
+            txids.emplace_back(rng.rand256());
+        }
+        return txids;
+    };
+
+    const std::vector<TxId> common = randomTxIds(1000);
+    const std::vector<TxId> onlyOurs = randomTxIds(12);
+    const std::vector<TxId> onlyTheirs = randomTxIds(8);
+
+    MempoolSketch theirs(20);
+    for (const auto &txids : {common, onlyTheirs}) {
+        for (const TxId &txid : txids) {
+            theirs.addTx(txid);
+        }
+    }
+
+    MempoolSketch ours = theirs.emptyCopy();
+    BOOST_CHECK(ours.getKeys() == theirs.getKeys());
+    BOOST_CHECK_EQUAL(ours.getSketch().getCellCount(),
+                      theirs.getSketch().getCellCount());
+    for (const auto &txids : {common, onlyOurs}) {
+        for (const TxId &txid : txids) {
+            ours.addTx(txid);
+        }
+    }
+
+    std::vector<uint64_t> onlyHere, onlyThere;
+    BOOST_CHECK(ours.diff(theirs, onlyHere, onlyThere));
+    std::sort(onlyHere.begin(), onlyHere.end());
+    std::sort(onlyThere.begin(), onlyThere.end());
+    BOOST_CHECK(onlyHere == GetSortedShortIds(ours, onlyOurs));
+    BOOST_CHECK(onlyThere == GetSortedShortIds(ours, onlyTheirs));
+
+    // Another sketch uses other keys
+    MempoolSketch other(20);
+    BOOST_CHECK(other.getKeys() != theirs.getKeys());
+    BOOST_CHECK(other.getShortID(common[0]) != theirs.getShortID(common[0]));
+
+    // Too many differences can't be decoded
+    for (const TxId &txid : randomTxIds(100)) {
+        ours.addTx(txid);
+    }
+    onlyHere.clear();
+    onlyThere.clear();
+    BOOST_CHECK(!ours.diff(theirs, onlyHere, onlyThere));
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+    MempoolSketch sketch(10);
+    const TxId txid(InsecureRand256());
+    sketch.addTx(txid);
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << sketch;
+
+    MempoolSketch deserialized;
+    ss >> deserialized;
+    BOOST_CHECK(deserialized.getKeys() == sketch.getKeys());
+    BOOST_CHECK_EQUAL(deserialized.getShortID(txid), sketch.getShortID(txid));
+
+    std::vector<uint64_t> onlyHere, onlyThere;
+    BOOST_CHECK(deserialized.diff(sketch.emptyCopy(), onlyHere, onlyThere));
+    BOOST_CHECK_EQUAL(onlyHere.size(), 1);
+    BOOST_CHECK_EQUAL(onlyHere[0], sketch.getShortID(txid));
+    BOOST_CHECK(onlyThere.empty());
+
+    auto checkBadCellCount = [&](size_t cellCount) {
+        CDataStream bad(SER_NETWORK, PROTOCOL_VERSION);
+        bad << sketch.getKeys() << COMPACTSIZE(cellCount);
+        for (size_t i = 0; i < cellCount; i++) {
+            bad << int32_t(0) << uint64_t(0) << uint64_t(0);
+        }
+
+        MempoolSketch badSketch;
+        BOOST_CHECK_EXCEPTION(bad >> badSketch, std::ios_base::failure,
+                              HasReason("invalid sketch size"));
+    };
+
+    // The cells must fill the hash partitions
+    checkBadCellCount(0);
+    checkBadCellCount(ShortIdSketch::NUM_HASHES + 1);
+    // The sketch is too large
+    checkBadCellCount(MAX_MEMPOOL_SKETCH_CELLS + ShortIdSketch::NUM_HASHES -
+                      MAX_MEMPOOL_SKETCH_CELLS % ShortIdSketch::NUM_HASHES);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
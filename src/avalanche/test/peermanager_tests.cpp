@@ -2091,6 +2091,168 @@ BOOST_AUTO_TEST_CASE(proof_expiry) {
     gArgs.ClearForcedArg("-avalancheconflictingproofcooldown");
 }
 
+BOOST_AUTO_TEST_CASE(incremental_tip_update) {
+    ChainstateManager &chainman = *Assert(m_node.chainman);
+    Chainstate &active_chainstate = chainman.ActiveChainstate();
+    avalanche::PeerManager pm(PROOF_DUST_THRESHOLD, chainman);
+
+    auto key = CKey::MakeCompressedKey();
+
+    auto blockSpending = [](const std::vector<COutPoint> &outpoints) {
+        CMutableTransaction coinbase;
+        coinbase.vin.resize(1);
+        CMutableTransaction tx;
+        for (const COutPoint &outpoint : outpoints) {
+            tx.vin.emplace_back(outpoint);
+        }
+
+        CBlock block;
+        block.vtx.push_back(MakeTransactionRef(coinbase));
+        block.vtx.push_back(MakeTransactionRef(tx));
+        return block;
+    };
+
+    auto spendCoins = [&](const std::vector<COutPoint> &outpoints) {
+        LOCK(cs_main);
+        for (const COutPoint &outpoint : outpoints) {
+            BOOST_CHECK(active_chainstate.CoinsTip().SpendCoin(outpoint));
+        }
+    };
+
+    std::vector<COutPoint> utxos;
+    std::vector<ProofRef> proofs;
+    for (int i = 0; i < 3; i++) {
+        utxos.push_back(createUtxo(active_chainstate, key));
+        proofs.push_back(buildProofWithSequence(key, {utxos.back()}, 10 + i));
+        BOOST_CHECK(pm.registerProof(proofs.back()));
+    }
+
+    // Both coins are spent, but the block only tells about the first one so
+    // only the first proof is checked again.
+    spendCoins({utxos[0], utxos[1]});
+    pm.blockConnected(blockSpending({utxos[0]}));
+    pm.updatedBlockTip();
+    BOOST_CHECK(!pm.exists(proofs[0]->getId()));
+    BOOST_CHECK(pm.isBoundToPeer(proofs[1]->getId()));
+    BOOST_CHECK(pm.isBoundToPeer(proofs[2]->getId()));
+
+    // Without block notification all the proofs are checked again
+    pm.updatedBlockTip();
+    BOOST_CHECK(!pm.exists(proofs[1]->getId()));
+    BOOST_CHECK(pm.isBoundToPeer(proofs[2]->getId()));
+
+    // Same if a block has been disconnected
+    spendCoins({utxos[2]});
+    pm.blockConnected(blockSpending({}));
+    pm.blockDisconnected();
+    pm.updatedBlockTip();
+    BOOST_CHECK(!pm.exists(proofs[2]->getId()));
+
+    // The immature proofs are registered once they reach maturity
+    gArgs.ForceSetArg("-avaproofstakeutxoconfirmations", "2");
+    const int height = chainman.ActiveHeight();
+    auto immatureUtxo = createUtxo(active_chainstate, key,
+                                   PROOF_DUST_THRESHOLD, height);
+    auto immatureProof =
+        buildProofWithOutpoints(key, {immatureUtxo}, PROOF_DUST_THRESHOLD,
+                                key, 1, height);
+    BOOST_CHECK(!pm.registerProof(immatureProof));
+    BOOST_CHECK(pm.isImmature(immatureProof->getId()));
+
+    pm.blockConnected(blockSpending({}));
+    pm.updatedBlockTip();
+    BOOST_CHECK(pm.isImmature(immatureProof->getId()));
+
+    mineBlocks(1);
+    pm.blockConnected(blockSpending({}));
+    pm.updatedBlockTip();
+    BOOST_CHECK(pm.isBoundToPeer(immatureProof->getId()));
+
+    // The proofs are checked again when they reach their expiration time
+    const int64_t tipTime = chainman.ActiveTip()->GetBlockTime();
+    auto utxoToExpire = createUtxo(active_chainstate, key);
+    auto proofToExpire = buildProof(key, {{utxoToExpire, PROOF_DUST_THRESHOLD}},
+                                    key, 2, 100, false, tipTime + 1);
+    BOOST_CHECK(pm.registerProof(proofToExpire));
+
+    for (int64_t i = 0; i < 6; i++) {
+        SetMockTime(proofToExpire->getExpirationTime() + i);
+        const CBlock block = CreateAndProcessBlock({}, CScript());
+        pm.blockConnected(block);
+    }
+    BOOST_CHECK_EQUAL(chainman.ActiveTip()->GetMedianTimePast(),
+                      proofToExpire->getExpirationTime());
+    pm.updatedBlockTip();
+    BOOST_CHECK(!pm.exists(proofToExpire->getId()));
+    BOOST_CHECK(pm.isBoundToPeer(immatureProof->getId()));
+}
+
+BOOST_FIXTURE_TEST_CASE(dump_and_load_peers, NoCoolDownFixture) {
+    ChainstateManager &chainman = *Assert(m_node.chainman);
+    Chainstate &active_chainstate = chainman.ActiveChainstate();
+    const fs::path dumpPath = m_args.GetDataDirNet() / "avapeers.dat";
+
+    auto key = CKey::MakeCompressedKey();
+
+    std::vector<ProofRef> proofs;
+    std::vector<COutPoint> utxos;
+    std::unordered_set<ProofRef, SaltedProofHasher> registeredProofs;
+    {
+        avalanche::PeerManager pm(PROOF_DUST_THRESHOLD, chainman);
+
+        // Nothing to load yet
+        BOOST_CHECK(!pm.loadPeersFromFile(dumpPath, registeredProofs));
+
+        for (int i = 0; i < 4; i++) {
+            utxos.push_back(createUtxo(active_chainstate, key));
+            proofs.push_back(buildProofWithSequence(key, {utxos.back()}, 10));
+            BOOST_CHECK(pm.registerProof(proofs.back()));
+        }
+
+        const PeerId finalizedPeerId =
+            TestPeerManager::getPeerIdForProofId(pm, proofs[0]->getId());
+        BOOST_CHECK(pm.setFinalized(finalizedPeerId));
+
+        // A lower sequence makes it a conflicting proof
+        auto conflictingProof = buildProofWithSequence(key, {utxos[1]}, 5);
+        BOOST_CHECK(!pm.registerProof(conflictingProof));
+        BOOST_CHECK(pm.isInConflictingPool(conflictingProof->getId()));
+        proofs.push_back(conflictingProof);
+
+        BOOST_CHECK(pm.dumpPeersToFile(dumpPath));
+    }
+
+    // The proof staking a spent utxo is not loaded
+    {
+        LOCK(cs_main);
+        BOOST_CHECK(active_chainstate.CoinsTip().SpendCoin(utxos[3]));
+    }
+
+    avalanche::PeerManager pm(PROOF_DUST_THRESHOLD, chainman);
+    BOOST_CHECK(pm.loadPeersFromFile(dumpPath, registeredProofs));
+    ProofIdSet registeredProofIds;
+    for (const ProofRef &proof : registeredProofs) {
+        registeredProofIds.insert(proof->getId());
+    }
+    BOOST_CHECK_EQUAL(registeredProofIds.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        BOOST_CHECK(pm.isBoundToPeer(proofs[i]->getId()));
+        BOOST_CHECK(registeredProofIds.count(proofs[i]->getId()));
+    }
+    BOOST_CHECK(!pm.exists(proofs[3]->getId()));
+    BOOST_CHECK(pm.isInConflictingPool(proofs[4]->getId()));
+
+    pm.forEachPeer([&](const Peer &peer) {
+        BOOST_CHECK_EQUAL(peer.hasFinalized,
+                          peer.getProofId() == proofs[0]->getId());
+    });
+
+    // Loading again doesn't register the proofs twice
+    BOOST_CHECK(pm.loadPeersFromFile(dumpPath, registeredProofs));
+    BOOST_CHECK(registeredProofs.empty());
+    BOOST_CHECK(pm.verify());
+}
+
 BOOST_AUTO_TEST_CASE(peer_availability_score) {
     ChainstateManager &chainman = *Assert(m_node.chainman);
     avalanche::PeerManager pm(PROOF_DUST_THRESHOLD, chainman);
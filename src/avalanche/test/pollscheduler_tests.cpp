@@ -0,0 +1,79 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/pollscheduler.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+using namespace avalanche;
+using namespace std::chrono_literals;
+
+BOOST_FIXTURE_TEST_SUITE(pollscheduler_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(poll_size) {
+    PollScheduler scheduler(16);
+
+    // Unknown nodes get full polls
+    BOOST_CHECK_EQUAL(scheduler.getPollSize(0), 16);
+
+    // The poll size can't grow above the maximum
+    scheduler.responseReceived(0, 10ms);
+    BOOST_CHECK_EQUAL(scheduler.getPollSize(0), 16);
+
+    // Each timeout halves it, down to a single item
+    for (size_t expected : {8, 4, 2, 1, 1}) {
+        scheduler.pollTimedOut(0);
+        BOOST_CHECK_EQUAL(scheduler.getPollSize(0), expected);
+    }
+
+    // Each response grows it by one item
+    for (size_t expected = 2; expected <= 16; expected++) {
+        scheduler.responseReceived(0, 10ms);
+        BOOST_CHECK_EQUAL(scheduler.getPollSize(0), expected);
+    }
+
+    // The nodes are tracked independently
+    scheduler.pollTimedOut(1);
+    BOOST_CHECK_EQUAL(scheduler.getPollSize(0), 16);
+    BOOST_CHECK_EQUAL(scheduler.getPollSize(1), 8);
+
+    // A removed node starts over
+    scheduler.removeNode(1);
+    BOOST_CHECK_EQUAL(scheduler.getPollSize(1), 16);
+}
+
+BOOST_AUTO_TEST_CASE(stats) {
+    PollScheduler scheduler(16);
+
+    PollStats stats = scheduler.getStats();
+    BOOST_CHECK_EQUAL(stats.nodeCount, 0);
+    BOOST_CHECK_EQUAL(stats.responses, 0);
+    BOOST_CHECK_EQUAL(stats.timeouts, 0);
+    BOOST_CHECK(stats.averageLatency == 0us);
+    BOOST_CHECK_EQUAL(stats.averagePollSize, 0);
+
+    // The first sample sets the latency, the next ones are smoothed
+    scheduler.responseReceived(0, 80ms);
+    BOOST_CHECK(scheduler.getStats().averageLatency == 80ms);
+    scheduler.responseReceived(0, 160ms);
+    BOOST_CHECK(scheduler.getStats().averageLatency == 90ms);
+
+    // Nodes that never responded don't count in the latency
+    scheduler.pollTimedOut(1);
+    scheduler.pollTimedOut(1);
+    scheduler.responseReceived(2, 30ms);
+
+    stats = scheduler.getStats();
+    BOOST_CHECK_EQUAL(stats.nodeCount, 3);
+    BOOST_CHECK_EQUAL(stats.responses, 3);
+    BOOST_CHECK_EQUAL(stats.timeouts, 2);
+    BOOST_CHECK(stats.averageLatency == 60ms);
+    BOOST_CHECK_EQUAL(stats.averagePollSize, (16. + 4. + 16.) / 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
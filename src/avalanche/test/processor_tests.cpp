@@ -1066,6 +1066,50 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(poll_inflight_timeout, P, VoteItemProviders) {
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(poll_stats, P, VoteItemProviders) {
+    P provider(this);
+    ChainstateManager &chainman = *Assert(m_node.chainman);
+
+    auto item = provider.buildVoteItem();
+    BOOST_CHECK(addToReconcile(item));
+    ConnectNodes();
+
+    // The responses are accounted for
+    Response resp{getRound(), 0, {Vote(0, provider.getVoteItemId(item))}};
+    NodeId avanodeid = getSuitableNodeToQuery();
+    runEventLoop();
+    std::vector<avalanche::VoteItemUpdate> updates;
+    BOOST_CHECK(registerVotes(avanodeid, resp, updates));
+
+    PollStats stats = m_processor->getPollStats();
+    BOOST_CHECK_EQUAL(stats.nodeCount, 1);
+    BOOST_CHECK_EQUAL(stats.responses, 1);
+    BOOST_CHECK_EQUAL(stats.timeouts, 0);
+    BOOST_CHECK_EQUAL(stats.averagePollSize, AVALANCHE_MAX_ELEMENT_POLL);
+
+    // Let the polls expire right away
+    setArg("-avatimeout", "1");
+    bilingual_str error;
+    m_processor = Processor::MakeProcessor(
+        *m_node.args, *m_node.chain, m_node.connman.get(), chainman,
+        m_node.mempool.get(), *m_node.scheduler, error);
+
+    item = provider.buildVoteItem();
+    BOOST_CHECK(addToReconcile(item));
+    ConnectNodes();
+
+    // The node that timed out gets smaller polls
+    runEventLoop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    runEventLoop();
+
+    stats = m_processor->getPollStats();
+    BOOST_CHECK_EQUAL(stats.nodeCount, 1);
+    BOOST_CHECK_EQUAL(stats.responses, 0);
+    BOOST_CHECK_EQUAL(stats.timeouts, 1);
+    BOOST_CHECK_EQUAL(stats.averagePollSize, AVALANCHE_MAX_ELEMENT_POLL / 2);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(poll_inflight_count, P, VoteItemProviders) {
     P provider(this);
     const uint32_t invType = provider.invType;
@@ -1184,6 +1228,104 @@ BOOST_AUTO_TEST_CASE(quorum_diversity) {
     BOOST_CHECK_EQUAL(m_processor->getConfidence(pindex), confidence + 1);
 }
 
+BOOST_AUTO_TEST_CASE(register_votes_batch) {
+    std::vector<VoteItemUpdate> updates;
+
+    CBlock block = CreateAndProcessBlock({}, CScript());
+    const BlockHash blockHash = block.GetHash();
+    const CBlockIndex *pindex;
+    {
+        LOCK(cs_main);
+        pindex =
+            Assert(m_node.chainman)->m_blockman.LookupBlockIndex(blockHash);
+    }
+
+    auto avanodes = ConnectNodes();
+    BOOST_CHECK(m_processor->addToReconcile(pindex));
+    VoteRecord expected(m_processor->isAccepted(pindex));
+
+    // Poll all the nodes, and answer for all of them at once
+    std::vector<PollResponse> responses;
+    for (size_t i = 0; i < avanodes.size(); i++) {
+        const NodeId nodeid = getSuitableNodeToQuery();
+        responses.emplace_back(
+            nodeid, Response{getRound(), 0, {Vote(0, blockHash)}});
+        runEventLoop();
+        expected.registerVote(nodeid, 0);
+    }
+
+    // Along with a response to a query we never made
+    responses.emplace_back(avanodes[0]->GetId(),
+                           Response{getRound() + 1, 0, {Vote(0, blockHash)}});
+
+    BOOST_CHECK(!m_processor->registerVotes(responses, updates));
+    for (size_t i = 0; i < avanodes.size(); i++) {
+        BOOST_CHECK_EQUAL(responses[i].error, "");
+    }
+    BOOST_CHECK_EQUAL(responses.back().error, "unexpected-ava-response");
+    BOOST_CHECK_EQUAL(responses.back().banscore, 2);
+
+    // The votes from the valid responses are all accounted for
+    BOOST_CHECK_GT(expected.getConfidence(), 0);
+    BOOST_CHECK_EQUAL(m_processor->getConfidence(pindex),
+                      expected.getConfidence());
+    BOOST_CHECK_EQUAL(m_processor->isAccepted(pindex), expected.isAccepted());
+
+    // The responses can't be registered twice
+    responses.pop_back();
+    BOOST_CHECK(!m_processor->registerVotes(responses, updates));
+    for (const PollResponse &r : responses) {
+        BOOST_CHECK_EQUAL(r.error, "unexpected-ava-response");
+    }
+    BOOST_CHECK_EQUAL(m_processor->getConfidence(pindex),
+                      expected.getConfidence());
+}
+
+BOOST_AUTO_TEST_CASE(latency_stats) {
+    CBlock block = CreateAndProcessBlock({}, CScript());
+    const BlockHash blockHash = block.GetHash();
+    const CBlockIndex *pindex;
+    {
+        LOCK(cs_main);
+        pindex =
+            Assert(m_node.chainman)->m_blockman.LookupBlockIndex(blockHash);
+    }
+
+    ConnectNodes();
+    BOOST_CHECK(m_processor->addToReconcile(pindex));
+
+    // Vote until the block is finalized
+    std::vector<VoteItemUpdate> updates;
+    uint64_t polls = 0;
+    while (updates.empty() ||
+           updates.back().getStatus() != VoteStatus::Finalized) {
+        BOOST_REQUIRE_LT(polls, 10000);
+        updates.clear();
+
+        const NodeId nodeid = getSuitableNodeToQuery();
+        Response resp{getRound(), 0, {Vote(0, blockHash)}};
+        runEventLoop();
+        BOOST_CHECK(registerVotes(nodeid, resp, updates));
+        polls++;
+    }
+
+    const LatencyStats stats = m_processor->getLatencyStats();
+    BOOST_CHECK_EQUAL(stats.blockFinalizationTime.GetCount(), 1);
+    BOOST_CHECK_EQUAL(stats.proofFinalizationTime.GetCount(), 0);
+    BOOST_CHECK_EQUAL(stats.txFinalizationTime.GetCount(), 0);
+
+    BOOST_CHECK_EQUAL(stats.pollRoundTripTime.GetCount(), polls);
+    BOOST_CHECK_EQUAL(stats.votesPerPoll.GetCount(), polls);
+    BOOST_CHECK_EQUAL(stats.votesPerPoll.GetMax(), 1);
+    BOOST_CHECK_EQUAL(stats.timedOutPolls, 0);
+
+    uint64_t nodePolls = 0;
+    for (const auto &[nodeid, histogram] : stats.nodePollRoundTripTime) {
+        nodePolls += histogram.GetCount();
+    }
+    BOOST_CHECK_EQUAL(nodePolls, polls);
+}
+
 BOOST_AUTO_TEST_CASE(event_loop) {
     CScheduler s;
 
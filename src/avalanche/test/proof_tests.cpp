@@ -918,4 +918,66 @@ BOOST_AUTO_TEST_CASE(get_staked_amount) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(verify_signatures) {
+    auto key = CKey::MakeCompressedKey();
+
+    auto buildProof = [&](int64_t expirationTime, size_t numStakes) {
+        ProofBuilder pb(0, expirationTime, key,
+                        UNSPENDABLE_ECREG_PAYOUT_SCRIPT);
+        for (size_t i = 0; i < numStakes; i++) {
+            BOOST_CHECK(pb.addUTXO(COutPoint(TxId(GetRandHash()), 0),
+                                   PROOF_DUST_THRESHOLD, 42, false, key));
+        }
+        return pb.build();
+    };
+
+    auto checkVerify = [](const ProofRef &proof,
+                          ProofValidationResult expected) {
+        ProofValidationState state;
+        BOOST_CHECK_EQUAL(proof->verify(PROOF_DUST_THRESHOLD, state),
+                          expected == ProofValidationResult::NONE);
+        BOOST_CHECK(state.GetResult() == expected);
+    };
+
+    // Enough signatures to be spread over several threads
+    std::vector<ProofRef> proofs;
+    for (int i = 0; i < 10; i++) {
+        proofs.push_back(buildProof(i, 100));
+    }
+    BOOST_CHECK(VerifyProofSignatures(proofs));
+    for (const ProofRef &proof : proofs) {
+        checkVerify(proof, ProofValidationResult::NONE);
+    }
+    // The proofs are already known to be valid
+    BOOST_CHECK(VerifyProofSignatures(proofs));
+
+    // The stakes are signed for another expiration time
+    ProofRef invalidProof = ProofRef::make(
+        0, 10, key.GetPubKey(), proofs[0]->getStakes(),
+        UNSPENDABLE_ECREG_PAYOUT_SCRIPT, proofs[0]->getSignature());
+    ProofRef validProof1 = buildProof(11, AVALANCHE_MAX_PROOF_STAKES);
+    ProofRef validProof2 = buildProof(12, 1);
+
+    BOOST_CHECK(
+        !VerifyProofSignatures({validProof1, invalidProof, validProof2}));
+    checkVerify(validProof1, ProofValidationResult::NONE);
+    checkVerify(validProof2, ProofValidationResult::NONE);
+    checkVerify(invalidProof, ProofValidationResult::INVALID_PROOF_SIGNATURE);
+
+    // The invalid proof is still reported as such
+    BOOST_CHECK(!VerifyProofSignatures({invalidProof}));
+    checkVerify(invalidProof, ProofValidationResult::INVALID_PROOF_SIGNATURE);
+
+    // Deserializing over a verified proof resets its state
+    Proof p;
+    bilingual_str error;
+    BOOST_CHECK(Proof::FromHex(p, validProof2->ToHex(), error));
+    ProofValidationState state;
+    BOOST_CHECK(p.verify(PROOF_DUST_THRESHOLD, state));
+    BOOST_CHECK(Proof::FromHex(p, invalidProof->ToHex(), error));
+    BOOST_CHECK(!p.verify(PROOF_DUST_THRESHOLD, state));
+    BOOST_CHECK(state.GetResult() ==
+                ProofValidationResult::INVALID_PROOF_SIGNATURE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
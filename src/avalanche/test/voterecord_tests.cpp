@@ -8,6 +8,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <utility>
+#include <vector>
+
 using namespace avalanche;
 
 struct VoteRecordFixture {
@@ -347,4 +350,54 @@ BOOST_AUTO_TEST_CASE(duplicate_votes) {
     BOOST_CHECK(vr.hasFinalized());
 }
 
+BOOST_AUTO_TEST_CASE(register_votes) {
+    for (int run = 0; run < 100; run++) {
+        VoteRecord sequential(InsecureRandBool());
+        VoteRecord batched(sequential.isAccepted());
+
+        // Apply random votes from a small set of nodes, so some of them get
+        // rejected as duplicates, both one by one and in batches of random
+        // sizes.
+        while (!sequential.hasFinalized() && !sequential.isStale()) {
+            std::vector<std::pair<NodeId, uint32_t>> nodeVotes;
+            bool changed = false;
+            const size_t batchSize = 1 + InsecureRandRange(20);
+            for (size_t i = 0; i < batchSize; i++) {
+                const NodeId nodeid = InsecureRandRange(12);
+                const uint32_t error = InsecureRandRange(10) == 0 ? -1
+                                       : InsecureRandRange(10) == 0 ? 1
+                                                                    : 0;
+                nodeVotes.emplace_back(nodeid, error);
+
+                // The votes after the finalization are ignored
+                if (!sequential.hasFinalized()) {
+                    changed |= sequential.registerVote(nodeid, error);
+                }
+            }
+
+            BOOST_CHECK_EQUAL(batched.registerVotes(nodeVotes), changed);
+            BOOST_CHECK_EQUAL(batched.isAccepted(), sequential.isAccepted());
+            BOOST_CHECK_EQUAL(batched.getConfidence(),
+                              sequential.getConfidence());
+            BOOST_CHECK_EQUAL(batched.hasFinalized(),
+                              sequential.hasFinalized());
+        }
+    }
+
+    // Each vote clears one inflight request
+    VoteRecord vr(true);
+    for (int i = 0; i < AVALANCHE_MAX_INFLIGHT_POLL; i++) {
+        BOOST_CHECK(vr.registerPoll());
+    }
+    BOOST_CHECK(!vr.shouldPoll());
+
+    std::vector<std::pair<NodeId, uint32_t>> nodeVotes{{0, 0}, {1, 0}, {2, 0}};
+    BOOST_CHECK(!vr.registerVotes(nodeVotes));
+    for (int i = 0; i < 3; i++) {
+        BOOST_CHECK(vr.shouldPoll());
+        BOOST_CHECK(vr.registerPoll());
+    }
+    BOOST_CHECK(!vr.shouldPoll());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,27 @@ bool VoteRecord::registerVote(NodeId nodeid, uint32_t error) {
     // We just got a new vote, so there is one less inflight request.
     clearInflightRequest();
 
+    return applyVote(nodeid, error);
+}
+
+bool VoteRecord::registerVotes(
+    Span<const std::pair<NodeId, uint32_t>> nodeVotes) {
+    // Each vote answers one inflight request, only touch the atomic once.
+    clearInflightRequest(uint8_t(nodeVotes.size()));
+
+    bool changed = false;
+    for (const auto &[nodeid, error] : nodeVotes) {
+        changed |= applyVote(nodeid, error);
+        if (hasFinalized()) {
+            // The item is done with, the remaining votes are moot.
+            break;
+        }
+    }
+
+    return changed;
+}
+
+bool VoteRecord::applyVote(NodeId nodeid, uint32_t error) {
     // We want to avoid having the same node voting twice in a quorum.
     if (!addNodeToQuorum(nodeid)) {
         return false;
@@ -68,18 +89,23 @@ bool VoteRecord::addNodeToQuorum(NodeId nodeid) {
     const uint16_t h = (r1 + r2) >> 48;
 
     /**
-     * Check if the node is in the filter.
+     * Check if the node is in the filter. The entry that is about to be
+     * overwritten is ignored. All the entries are compared without branching
+     * so the compiler can do it in a single vector comparison.
      */
-    for (size_t i = 1; i < nodeFilter.size(); i++) {
-        if (nodeFilter[(successfulVotes + i) % nodeFilter.size()] == h) {
-            return false;
-        }
+    const size_t next = successfulVotes % nodeFilter.size();
+    uint32_t matches = 0;
+    for (size_t i = 0; i < nodeFilter.size(); i++) {
+        matches |= uint32_t(nodeFilter[i] == h) << i;
+    }
+    if (matches & ~(uint32_t(1) << next)) {
+        return false;
     }
 
     /**
      * Add the node which just voted to the filter.
      */
-    nodeFilter[successfulVotes % nodeFilter.size()] = h;
+    nodeFilter[next] = h;
     successfulVotes++;
     return true;
 }
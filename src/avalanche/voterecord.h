@@ -6,10 +6,13 @@
 #define BITCOIN_AVALANCHE_VOTERECORD_H
 
 #include <nodeid.h>
+#include <span.h>
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <utility>
 
 /**
  * Finalization score.
@@ -68,6 +71,10 @@ private:
     // Track the nodes which are part of the quorum.
     std::array<uint16_t, 8> nodeFilter{{0, 0, 0, 0, 0, 0, 0, 0}};
 
+    // When the vote started, to measure how long it takes to finalize.
+    std::chrono::steady_clock::time_point registrationTime{
+        std::chrono::steady_clock::now()};
+
 public:
     explicit VoteRecord(bool accepted) : confidence(accepted) {}
 
@@ -77,8 +84,8 @@ public:
     VoteRecord(const VoteRecord &other)
         : confidence(other.confidence), votes(other.votes),
           consider(other.consider), inflight(other.inflight.load()),
-          successfulVotes(other.successfulVotes), nodeFilter(other.nodeFilter) {
-    }
+          successfulVotes(other.successfulVotes), nodeFilter(other.nodeFilter),
+          registrationTime(other.registrationTime) {}
 
     /**
      * Vote accounting facilities.
@@ -90,6 +97,10 @@ public:
         return getConfidence() >= AVALANCHE_FINALIZATION_SCORE;
     }
 
+    std::chrono::steady_clock::time_point getRegistrationTime() const {
+        return registrationTime;
+    }
+
     bool isStale(uint32_t staleThreshold = AVALANCHE_VOTE_STALE_THRESHOLD,
                  uint32_t staleFactor = AVALANCHE_VOTE_STALE_FACTOR) const {
         return successfulVotes > staleThreshold &&
@@ -102,6 +113,15 @@ public:
      */
     bool registerVote(NodeId nodeid, uint32_t error);
 
+    /**
+     * Register several votes for an item, in order, along with their error
+     * code. This is equivalent to calling registerVote for each of them,
+     * except that the votes that come after the item is finalized are ignored.
+     * Returns true if any of the votes changed the acceptance or finalization
+     * state.
+     */
+    bool registerVotes(Span<const std::pair<NodeId, uint32_t>> nodeVotes);
+
     /**
      * Register that a request is being made regarding that item.
      * The method is made const so that it can be accessed via a read only view
@@ -120,6 +140,12 @@ public:
     void clearInflightRequest(uint8_t count = 1) { inflight -= count; }
 
 private:
+    /**
+     * Update the confidence with a vote, without accounting for the inflight
+     * request.
+     */
+    bool applyVote(NodeId nodeid, uint32_t error);
+
     /**
      * Add the node to the quorum.
      * Returns true if the node was added, false if the node already was in the
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/peermanager.h>
+#include <bench/bench.h>
+#include <random.h>
+#include <util/fenwicktree.h>
+
+#include <vector>
+
+using namespace avalanche;
+
+static constexpr size_t NUM_PEERS = 10000;
+static constexpr uint32_t MAX_SCORE = 100000;
+
+/**
+ * Mimic the slot allocation of the PeerManager: each round a random peer
+ * disconnects, leaving a free slot behind, and a new one is appended.
+ */
+class SlotChurn {
+    FastRandomContext rng{true};
+    std::vector<Slot> slots;
+    uint64_t slotCount = 0;
+    uint64_t fragmentation = 0;
+    FenwickTree<uint64_t> slotScores;
+    PeerId nextPeerId = 0;
+
+    void addPeer() {
+        const uint32_t score = 1 + rng.randrange(MAX_SCORE);
+        slots.emplace_back(slotCount, score, nextPeerId++);
+        slotScores.push_back(score);
+        slotCount += score;
+    }
+
+    /** The slots are compacted the way the former peer selection did */
+    void compact() {
+        std::vector<Slot> newslots;
+        slotScores.clear();
+        uint64_t prevStop = 0;
+        for (const Slot &s : slots) {
+            if (s.getPeerId() == NO_PEER) {
+                continue;
+            }
+            newslots.emplace_back(prevStop, s.getScore(), s.getPeerId());
+            slotScores.push_back(s.getScore());
+            prevStop += s.getScore();
+        }
+        slots = std::move(newslots);
+        slotCount = prevStop;
+        fragmentation = 0;
+    }
+
+public:
+    SlotChurn() {
+        for (size_t i = 0; i < NUM_PEERS; i++) {
+            addPeer();
+        }
+    }
+
+    void churn() {
+        const size_t i = rng.randrange(slots.size());
+        if (slots[i].getPeerId() != NO_PEER) {
+            fragmentation += slots[i].getScore();
+            slotScores.subtract(i, slots[i].getScore());
+            slots[i] = slots[i].withPeerId(NO_PEER);
+        }
+        addPeer();
+    }
+
+    PeerId selectWithRetry() {
+        for (int retry = 0; retry < 3; retry++) {
+            for (int i = 0; i < 3; i++) {
+                const PeerId p = selectPeerImpl(
+                    slots, rng.randrange(slotCount), slotCount);
+                if (p != NO_PEER) {
+                    return p;
+                }
+            }
+            compact();
+        }
+        return NO_PEER;
+    }
+
+    PeerId selectFromTree() {
+        return slots[slotScores.find(rng.randrange(slotScores.total()))]
+            .getPeerId();
+    }
+
+    /** Compaction only reclaims memory when the tree is used */
+    void reclaim() {
+        if (2 * fragmentation > slotCount) {
+            compact();
+        }
+    }
+};
+
+static void PeerSelection(benchmark::Bench &bench, bool useTree) {
+    SlotChurn slots;
+    bench.run([&] {
+        slots.churn();
+        if (useTree) {
+            slots.reclaim();
+            assert(slots.selectFromTree() != NO_PEER);
+        } else {
+            assert(slots.selectWithRetry() != NO_PEER);
+        }
+    });
+}
+
+static void AvalanchePeerSelectionSlots(benchmark::Bench &bench) {
+    PeerSelection(bench, false);
+}
+static void AvalanchePeerSelectionTree(benchmark::Bench &bench) {
+    PeerSelection(bench, true);
+}
+
+BENCHMARK(AvalanchePeerSelectionSlots);
+BENCHMARK(AvalanchePeerSelectionTree);
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <avalanche/proof.h>
+#include <avalanche/proofbuilder.h>
+#include <bench/bench.h>
+#include <key.h>
+#include <random.h>
+#include <script/standard.h>
+#include <streams.h>
+#include <version.h>
+
+#include <test/util/setup_common.h>
+
+#include <vector>
+
+using namespace avalanche;
+
+static std::vector<CDataStream> BuildSerializedProofs(size_t numProofs,
+                                                      size_t numStakes) {
+    FastRandomContext rng(true);
+    const CScript payoutScript =
+        GetScriptForDestination(PKHash(uint160(rng.randbytes(20))));
+
+    std::vector<CDataStream> serializedProofs;
+    for (size_t i = 0; i < numProofs; i++) {
+        CKey key;
+        key.MakeNewKey(true);
+        ProofBuilder pb(0, i, key, payoutScript);
+        for (size_t j = 0; j < numStakes; j++) {
+            assert(pb.addUTXO(COutPoint(TxId(rng.rand256()), 0),
+                              PROOF_DUST_THRESHOLD, 42, false, key));
+        }
+
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << *pb.build();
+        serializedProofs.push_back(std::move(ss));
+    }
+    return serializedProofs;
+}
+
+/**
+ * The proofs are deserialized in each iteration, as the result of the signature
+ * checks is remembered by the proof. This costs less than 5% of the run time.
+ */
+static std::vector<ProofRef>
+DeserializeProofs(const std::vector<CDataStream> &serializedProofs) {
+    std::vector<ProofRef> proofs;
+    for (CDataStream ss : serializedProofs) {
+        proofs.push_back(ProofRef::make(deserialize, ss));
+    }
+    return proofs;
+}
+
+static void VerifyProofs(benchmark::Bench &bench, size_t numProofs,
+                         size_t numStakes, bool batch) {
+    const BasicTestingSetup test_setup{};
+    const auto serializedProofs = BuildSerializedProofs(numProofs, numStakes);
+
+    bench.unit("signature")
+        .batch(numProofs * (numStakes + 1))
+        .run([&] {
+            const auto proofs = DeserializeProofs(serializedProofs);
+            if (batch) {
+                assert(VerifyProofSignatures(proofs));
+                return;
+            }
+
+            for (const ProofRef &proof : proofs) {
+                // The signatures are checked sequentially
+                assert(proof->getMaster().VerifySchnorr(
+                    proof->getLimitedId(), proof->getSignature()));
+                for (const SignedStake &ss : proof->getStakes()) {
+                    assert(ss.verify(proof->getStakeCommitment()));
+                }
+            }
+        });
+}
+
+static void ProofVerifyLargeSequential(benchmark::Bench &bench) {
+    VerifyProofs(bench, 1, AVALANCHE_MAX_PROOF_STAKES, false);
+}
+static void ProofVerifyLargeBatch(benchmark::Bench &bench) {
+    VerifyProofs(bench, 1, AVALANCHE_MAX_PROOF_STAKES, true);
+}
+static void ProofVerifyManySequential(benchmark::Bench &bench) {
+    VerifyProofs(bench, 100, 10, false);
+}
+static void ProofVerifyManyBatch(benchmark::Bench &bench) {
+    VerifyProofs(bench, 100, 10, true);
+}
+
+BENCHMARK(ProofVerifyLargeSequential);
+BENCHMARK(ProofVerifyLargeBatch);
+BENCHMARK(ProofVerifyManySequential);
+BENCHMARK(ProofVerifyManyBatch);
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <coins.h>
+#include <random.h>
+#include <script/script.h>
+#include <txdb.h>
+#include <util/system.h>
+
+#include <test/util/setup_common.h>
+
+#include <string>
+
+//! Flush a large cache of new coins to an in-memory coins database
+static void CoinsFlush(benchmark::Bench &bench, int n_threads) {
+    const BasicTestingSetup test_setup{};
+    gArgs.ForceSetArg("-dbwritethreads", std::to_string(n_threads));
+
+    static constexpr size_t NUM_COINS = 200000;
+    FastRandomContext rng(true);
+    CCoinsViewDB db{"coins_flush", /*nCacheSize*/ 1 << 23, /*fMemory*/ true,
+                    /*fWipe*/ true};
+    CCoinsViewCache cache{&db};
+    cache.SetBestBlock(BlockHash(rng.rand256()));
+    for (size_t i = 0; i < NUM_COINS; i++) {
+        cache.AddCoin(COutPoint(TxId(rng.rand256()), 0),
+                      Coin(CTxOut(int64_t(i) * SATOSHI,
+                                  CScript() << OP_DUP << OP_HASH160
+                                            << rng.randbytes(20)
+                                            << OP_EQUALVERIFY << OP_CHECKSIG),
+                           1, false),
+                      false);
+    }
+
+    // The flush empties the cache, so it can only be measured once
+    bench.unit("coin").batch(NUM_COINS).epochs(1).epochIterations(1).run(
+        [&] { assert(cache.Flush()); });
+
+    gArgs.ClearForcedArg("-dbwritethreads");
+}
+
+static void CoinsFlushSingleThread(benchmark::Bench &bench) {
+    CoinsFlush(bench, 1);
+}
+
+static void CoinsFlushParallel(benchmark::Bench &bench) {
+    CoinsFlush(bench, MAX_DB_WRITE_THREADS);
+}
+
+BENCHMARK(CoinsFlushSingleThread);
+BENCHMARK(CoinsFlushParallel);
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <coins.h>
+#include <node/coinstats.h>
+#include <random.h>
+#include <script/script.h>
+#include <txdb.h>
+#include <validation.h>
+
+#include <test/util/setup_common.h>
+
+using node::CCoinsStats;
+using node::CoinStatsHashType;
+
+static void CoinStats(benchmark::Bench &bench, CoinStatsHashType hash_type) {
+    TestingSetup test_setup{};
+    node::BlockManager &blockman = test_setup.m_node.chainman->m_blockman;
+    const CBlockIndex *pindex =
+        WITH_LOCK(cs_main, return test_setup.m_node.chainman->ActiveTip());
+
+    CCoinsViewDB db{"coinstats", /*nCacheSize*/ 1 << 23, /*fMemory*/ true,
+                    /*fWipe*/ false};
+    {
+        FastRandomContext rng(true);
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(pindex->GetBlockHash());
+        for (int i = 0; i < 20000; i++) {
+            const TxId txid{rng.rand256()};
+            for (uint32_t n = 0; n < 2; n++) {
+                Coin coin{CTxOut(int64_t(rng.randrange(1000)) * SATOSHI,
+                                 CScript() << OP_DUP << OP_HASH160
+                                           << rng.randbytes(20)
+                                           << OP_EQUALVERIFY << OP_CHECKSIG),
+                          100, false};
+                cache.AddCoin(COutPoint(txid, n), std::move(coin), false);
+            }
+        }
+        assert(cache.Flush());
+    }
+
+    bench.unit("coin").batch(40000).run([&] {
+        CCoinsStats stats{hash_type};
+        assert(node::GetUTXOStats(&db, blockman, stats, [] {}, pindex));
+    });
+}
+
+static void CoinStatsMuHash(benchmark::Bench &bench) {
+    CoinStats(bench, CoinStatsHashType::MUHASH);
+}
+
+static void CoinStatsHashSerialized(benchmark::Bench &bench) {
+    CoinStats(bench, CoinStatsHashType::HASH_SERIALIZED);
+}
+
+BENCHMARK(CoinStatsMuHash);
+BENCHMARK(CoinStatsHashSerialized);
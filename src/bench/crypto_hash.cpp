@@ -15,6 +15,7 @@
 #include <uint256.h>
 
 #include <string>
+#include <vector>
 
 /* Number of bytes to hash per iteration */
 static const uint64_t BUFFER_SIZE = 1000 * 1000;
@@ -59,6 +60,43 @@ static void SHA256D64_1024(benchmark::Bench &bench) {
         [&] { SHA256D64(in.data(), in.data(), 1024); });
 }
 
+/**
+ * Messages of various lengths, typical of the serialized transactions and
+ * of the data hashed for their signature hashes.
+ */
+static std::vector<std::vector<uint8_t>> MakeMessages(size_t count) {
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < count; i++) {
+        messages.emplace_back(32 + (i * 37) % 600, uint8_t(i));
+    }
+    return messages;
+}
+
+static void SHA256D_1024_Messages(benchmark::Bench &bench) {
+    const auto messages = MakeMessages(1024);
+    uint8_t hash[CHash256::OUTPUT_SIZE];
+    bench.batch(messages.size()).unit("message").run([&] {
+        for (const auto &message : messages) {
+            CHash256().Write(message).Finalize(hash);
+        }
+    });
+}
+
+static void SHA256DMulti_1024_Messages(benchmark::Bench &bench) {
+    const auto messages = MakeMessages(1024);
+    std::vector<const uint8_t *> inputs;
+    std::vector<size_t> lengths;
+    for (const auto &message : messages) {
+        inputs.push_back(message.data());
+        lengths.push_back(message.size());
+    }
+    std::vector<uint8_t> out(CSHA256::OUTPUT_SIZE * messages.size());
+    bench.batch(messages.size()).unit("message").run([&] {
+        SHA256DMulti(out.data(), inputs.data(), lengths.data(),
+                     messages.size());
+    });
+}
+
 static void SHA512(benchmark::Bench &bench) {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
     std::vector<uint8_t> in(BUFFER_SIZE, 0);
@@ -128,6 +166,8 @@ BENCHMARK(SHA3_256_1M);
 BENCHMARK(SHA256_32b);
 BENCHMARK(SipHash_32b);
 BENCHMARK(SHA256D64_1024);
+BENCHMARK(SHA256D_1024_Messages);
+BENCHMARK(SHA256DMulti_1024_Messages);
 BENCHMARK(FastRandom_32bit);
 BENCHMARK(FastRandom_1bit);
 
@@ -6,6 +6,7 @@
 #include <bench/data.h>
 
 #include <rpc/blockchain.h>
+#include <rpc/request.h>
 #include <streams.h>
 #include <validation.h>
 
@@ -62,3 +63,26 @@ static void BlockToJsonVerboseWrite(benchmark::Bench &bench) {
 }
 
 BENCHMARK(BlockToJsonVerboseWrite);
+
+namespace {
+class StringResultStream : public RPCResultStream {
+public:
+    std::string json;
+
+    void Write(const std::string &str) override { json += str; }
+    void Flush() override {}
+    bool IsStarted() const override { return !json.empty(); }
+};
+} // namespace
+
+static void BlockToJsonVerboseStream(benchmark::Bench &bench) {
+    TestBlockAndIndex data;
+    bench.run([&] {
+        StringResultStream stream;
+        blockToJSONStream(stream, data.test_setup.m_node.chainman->m_blockman,
+                          data.block, &data.blockindex, &data.blockindex);
+        ankerl::nanobench::doNotOptimizeAway(stream.json);
+    });
+}
+
+BENCHMARK(BlockToJsonVerboseStream);
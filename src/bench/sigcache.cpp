@@ -0,0 +1,70 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <random.h>
+#include <script/shardedcache.h>
+#include <script/sigcache.h>
+#include <util/system.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+static constexpr int MIN_THREADS = 2;
+static constexpr size_t ENTRIES = 100000;
+static constexpr size_t LOOKUPS_PER_THREAD = 10000;
+// One insertion every INSERT_INTERVAL lookups, like the signatures of the
+// transactions accepted to the mempool among the block validation lookups.
+static constexpr size_t INSERT_INTERVAL = 16;
+
+/**
+ * Hammer a signature cache from as many threads as there are script check
+ * threads. NUM_SHARDS = 1 is equivalent to a single cache behind one lock.
+ */
+template <size_t NUM_SHARDS>
+static void SigCacheConcurrentAccess(benchmark::Bench &bench) {
+    using Cache = ShardedCuckooCache<CuckooCache::KeyOnly<uint256>,
+                                     SignatureCacheHasher, NUM_SHARDS>;
+    Cache cache;
+    cache.setup_bytes(DEFAULT_MAX_SIG_CACHE_SIZE << 20);
+
+    FastRandomContext rng(/* fDeterministic */ true);
+    std::vector<uint256> entries(ENTRIES);
+    for (uint256 &entry : entries) {
+        entry = rng.rand256();
+        cache.insert(entry);
+    }
+
+    const size_t n_threads = std::max(MIN_THREADS, GetNumCores());
+    bench.batch(n_threads * LOOKUPS_PER_THREAD).unit("lookup").run([&] {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = 0; i < LOOKUPS_PER_THREAD; ++i) {
+                    const uint256 &entry =
+                        entries[(t * LOOKUPS_PER_THREAD + i) % ENTRIES];
+                    if (i % INSERT_INTERVAL == 0) {
+                        cache.insert(entry);
+                    }
+                    cache.contains(entry, false);
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    });
+}
+
+static void SigCacheSingleLock(benchmark::Bench &bench) {
+    SigCacheConcurrentAccess<1>(bench);
+}
+
+static void SigCacheSharded(benchmark::Bench &bench) {
+    SigCacheConcurrentAccess<SCRIPT_CACHE_SHARDS>(bench);
+}
+
+BENCHMARK(SigCacheSingleLock);
+BENCHMARK(SigCacheSharded);
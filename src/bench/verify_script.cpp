@@ -3,7 +3,10 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <crypto/sha256.h>
+#include <hash.h>
 #include <key.h>
+#include <policy/policy.h>
 #if defined(HAVE_CONSENSUS_LIB)
 #include <script/bitcoinconsensus.h>
 #endif
@@ -16,8 +19,194 @@
 
 #include <array>
 
+namespace {
+/**
+ * Accept any signature, like the signature cache does for the transactions
+ * which are already in the mempool, so the benchmarks measure the script
+ * evaluation rather than the signature verification.
+ */
+class CachedSignatureChecker : public BaseSignatureChecker {
+public:
+    bool CheckSig(Span<const uint8_t> vchSig, Span<const uint8_t> vchPubKey,
+                  const CScript &scriptCode, uint32_t flags) const override {
+        return true;
+    }
+};
+
+struct StandardSpend {
+    CScript scriptSig;
+    CScript scriptPubKey;
+};
+
+std::vector<uint8_t> MakeSig(const CKey &key) {
+    std::vector<uint8_t> sig;
+    bool signed_ok = key.SignECDSA(uint256::ONE, sig);
+    assert(signed_ok);
+    sig.push_back(SIGHASH_ALL | SIGHASH_FORKID);
+    return sig;
+}
+
+StandardSpend MakeP2PKHSpend() {
+    CKey key;
+    key.MakeNewKey(true);
+    const CPubKey pubkey = key.GetPubKey();
+    return {CScript() << MakeSig(key) << ToByteVector(pubkey),
+            GetScriptForDestination(PKHash(pubkey))};
+}
+
+StandardSpend MakeMultisigSpend() {
+    std::vector<CKey> keys(3);
+    std::vector<CPubKey> pubkeys;
+    for (CKey &key : keys) {
+        key.MakeNewKey(true);
+        pubkeys.push_back(key.GetPubKey());
+    }
+    const CScript redeemScript = GetScriptForMultisig(2, pubkeys);
+    return {CScript() << OP_0 << MakeSig(keys[0]) << MakeSig(keys[2])
+                      << std::vector<uint8_t>(redeemScript.begin(),
+                                              redeemScript.end()),
+            GetScriptForDestination(ScriptHash(redeemScript))};
+}
+
+StandardSpend MakeP2SHSpend(const CScript &redeemScript, CScript scriptSig) {
+    scriptSig << std::vector<uint8_t>(redeemScript.begin(), redeemScript.end());
+    return {std::move(scriptSig),
+            GetScriptForDestination(ScriptHash(redeemScript))};
+}
+
+/**
+ * The standard spends along with hash locked and data manipulation scripts,
+ * which are evaluated by the interpreter.
+ */
+std::vector<StandardSpend> MakeMixedSpends() {
+    std::vector<StandardSpend> spends;
+    spends.push_back(MakeP2PKHSpend());
+    spends.push_back(MakeMultisigSpend());
+
+    // <sig> <preimage> | OP_SHA256 <hash> OP_EQUALVERIFY <pubkey> OP_CHECKSIG
+    CKey key;
+    key.MakeNewKey(true);
+    const std::vector<uint8_t> preimage(32, 0x42);
+    uint256 hash;
+    CSHA256().Write(preimage.data(), preimage.size()).Finalize(hash.begin());
+    spends.push_back(
+        MakeP2SHSpend(CScript() << OP_SHA256 << ToByteVector(hash)
+                                << OP_EQUALVERIFY
+                                << ToByteVector(key.GetPubKey())
+                                << OP_CHECKSIG,
+                      CScript() << MakeSig(key) << preimage));
+
+    // <data> <position> | OP_SPLIT OP_SWAP OP_CAT OP_HASH160 <hash> OP_EQUAL
+    std::vector<uint8_t> data(64);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i;
+    }
+    std::vector<uint8_t> rotated(data.begin() + 24, data.end());
+    rotated.insert(rotated.end(), data.begin(), data.begin() + 24);
+    spends.push_back(MakeP2SHSpend(CScript() << OP_SPLIT << OP_SWAP << OP_CAT
+                                             << OP_HASH160
+                                             << ToByteVector(Hash160(rotated))
+                                             << OP_EQUAL,
+                                   CScript() << data << 24));
+
+    // <sig> <pubkey> <1> | OP_IF OP_DUP OP_HASH160 <hash> OP_EQUALVERIFY
+    // OP_ENDIF OP_CHECKSIG
+    spends.push_back(MakeP2SHSpend(
+        CScript() << OP_IF << OP_DUP << OP_HASH160
+                  << ToByteVector(key.GetPubKey().GetID()) << OP_EQUALVERIFY
+                  << OP_ENDIF << OP_CHECKSIG,
+        CScript() << MakeSig(key) << ToByteVector(key.GetPubKey()) << 1));
+
+    return spends;
+}
+
+void BenchVerifySpend(benchmark::Bench &bench, const StandardSpend &spend,
+                      bool useInterpreter) {
+    const CachedSignatureChecker checker;
+    bench.run([&] {
+        ScriptExecutionMetrics metrics;
+        ScriptError error;
+        bool ret = useInterpreter
+                       ? VerifyScriptWithInterpreter(
+                             spend.scriptSig, spend.scriptPubKey,
+                             STANDARD_SCRIPT_VERIFY_FLAGS, checker, metrics,
+                             &error)
+                       : VerifyScript(spend.scriptSig, spend.scriptPubKey,
+                                      STANDARD_SCRIPT_VERIFY_FLAGS, checker,
+                                      metrics, &error);
+        assert(ret);
+    });
+}
+} // namespace
+
+// Standard templates, verified by the fast path or by the interpreter
+static void VerifyP2PKHScript(benchmark::Bench &bench) {
+    ECC_Start();
+    const StandardSpend spend = MakeP2PKHSpend();
+    ECC_Stop();
+    BenchVerifySpend(bench, spend, /*useInterpreter=*/false);
+}
+
+static void VerifyP2PKHScriptInterpreter(benchmark::Bench &bench) {
+    ECC_Start();
+    const StandardSpend spend = MakeP2PKHSpend();
+    ECC_Stop();
+    BenchVerifySpend(bench, spend, /*useInterpreter=*/true);
+}
+
+static void VerifyMultisigScript(benchmark::Bench &bench) {
+    ECC_Start();
+    const StandardSpend spend = MakeMultisigSpend();
+    ECC_Stop();
+    BenchVerifySpend(bench, spend, /*useInterpreter=*/false);
+}
+
+static void VerifyMultisigScriptInterpreter(benchmark::Bench &bench) {
+    ECC_Start();
+    const StandardSpend spend = MakeMultisigSpend();
+    ECC_Stop();
+    BenchVerifySpend(bench, spend, /*useInterpreter=*/true);
+}
+
+// A mix of standard and non-standard inputs, the latter being evaluated by the
+// interpreter
+static void VerifyMixedScripts(benchmark::Bench &bench) {
+    ECC_Start();
+    const std::vector<StandardSpend> spends = MakeMixedSpends();
+    ECC_Stop();
+
+    const CachedSignatureChecker checker;
+    bench.batch(spends.size()).unit("input").run([&] {
+        for (const StandardSpend &spend : spends) {
+            ScriptError error;
+            bool ret = VerifyScript(spend.scriptSig, spend.scriptPubKey,
+                                    STANDARD_SCRIPT_VERIFY_FLAGS, checker,
+                                    &error);
+            assert(ret);
+        }
+    });
+}
+
+static void VerifyMixedScriptsInterpreter(benchmark::Bench &bench) {
+    ECC_Start();
+    const std::vector<StandardSpend> spends = MakeMixedSpends();
+    ECC_Stop();
+
+    const CachedSignatureChecker checker;
+    bench.batch(spends.size()).unit("input").run([&] {
+        for (const StandardSpend &spend : spends) {
+            ScriptExecutionMetrics metrics;
+            ScriptError error;
+            bool ret = VerifyScriptWithInterpreter(
+                spend.scriptSig, spend.scriptPubKey,
+                STANDARD_SCRIPT_VERIFY_FLAGS, checker, metrics, &error);
+            assert(ret);
+        }
+    });
+}
+
 static void VerifyNestedIfScript(benchmark::Bench &bench) {
-    std::vector<std::vector<uint8_t>> stack;
+    std::vector<StackElement> stack;
     CScript script;
     for (int i = 0; i < 100; ++i) {
         script << OP_1 << OP_IF;
@@ -38,4 +227,10 @@ static void VerifyNestedIfScript(benchmark::Bench &bench) {
     });
 }
 
+BENCHMARK(VerifyP2PKHScript);
+BENCHMARK(VerifyP2PKHScriptInterpreter);
+BENCHMARK(VerifyMultisigScript);
+BENCHMARK(VerifyMultisigScriptInterpreter);
+BENCHMARK(VerifyMixedScripts);
+BENCHMARK(VerifyMixedScriptsInterpreter);
 BENCHMARK(VerifyNestedIfScript);
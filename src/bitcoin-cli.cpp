@@ -10,6 +10,7 @@
 #include <chainparamsbase.h>
 #include <clientversion.h>
 #include <currencyunit.h>
+#include <rpc/cbor.h>
 #include <rpc/client.h>
 #include <rpc/mining.h>
 #include <rpc/protocol.h>
@@ -46,6 +47,7 @@ const std::function<std::string(const char *)> G_TRANSLATION_FUN = nullptr;
 static const char DEFAULT_RPCCONNECT[] = "127.0.0.1";
 static const int DEFAULT_HTTP_CLIENT_TIMEOUT = 900;
 static const bool DEFAULT_NAMED = false;
+static const char DEFAULT_RPCENCODING[] = "json";
 static const int CONTINUE_EXECUTION = -1;
 /** Default number of blocks to generate for RPC generatetoaddress. */
 static const std::string DEFAULT_NBLOCKS = "1";
@@ -122,6 +124,13 @@ static void SetupCliArgs(ArgsManager &argsman) {
                    OptionsCategory::OPTIONS);
     argsman.AddArg("-rpcwait", "Wait for RPC server to start",
                    ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg(
+        "-rpcencoding=<encoding>",
+        strprintf("Encoding of the RPC requests and replies, json or cbor. The "
+                  "cbor binary encoding is more compact and faster to parse, "
+                  "notably for the hex encoded data (default: %s)",
+                  DEFAULT_RPCENCODING),
+        ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-rpcuser=<user>", "Username for JSON-RPC connections",
                    ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-rpcpassword=<pw>", "Password for JSON-RPC connections",
@@ -255,6 +264,7 @@ struct HTTPReply {
 
     int status;
     int error;
+    std::string contentType;
     std::string body;
 };
 
@@ -293,6 +303,12 @@ static void http_request_done(struct evhttp_request *req, void *ctx) {
 
     reply->status = evhttp_request_get_response_code(req);
 
+    const char *contentType = evhttp_find_header(
+        evhttp_request_get_input_headers(req), "Content-Type");
+    if (contentType) {
+        reply->contentType = contentType;
+    }
+
     struct evbuffer *buf = evhttp_request_get_input_buffer(req);
     if (buf) {
         size_t size = evbuffer_get_length(buf);
@@ -708,6 +724,14 @@ public:
 static UniValue CallRPC(BaseRequestHandler *rh, const std::string &strMethod,
                         const std::vector<std::string> &args,
                         const std::optional<std::string> &rpcwallet = {}) {
+    const std::string encoding =
+        gArgs.GetArg("-rpcencoding", DEFAULT_RPCENCODING);
+    if (encoding != "json" && encoding != "cbor") {
+        throw std::runtime_error(
+            strprintf("Unknown -rpcencoding value: %s", encoding));
+    }
+    const bool use_cbor = encoding == "cbor";
+
     std::string host;
     // In preference order, we choose the following for the port:
     //     1. -rpcport
@@ -769,13 +793,17 @@ static UniValue CallRPC(BaseRequestHandler *rh, const std::string &strMethod,
     assert(output_headers);
     evhttp_add_header(output_headers, "Host", host.c_str());
     evhttp_add_header(output_headers, "Connection", "close");
-    evhttp_add_header(output_headers, "Content-Type", "application/json");
+    evhttp_add_header(output_headers, "Content-Type",
+                      use_cbor ? CBOR_CONTENT_TYPE.c_str()
+                               : "application/json");
     evhttp_add_header(
         output_headers, "Authorization",
         (std::string("Basic ") + EncodeBase64(strRPCUserColonPass)).c_str());
 
     // Attach request data
-    std::string strRequest = rh->PrepareRequest(strMethod, args).write() + "\n";
+    const UniValue request = rh->PrepareRequest(strMethod, args);
+    const std::string strRequest =
+        use_cbor ? EncodeCBOR(request) : request.write() + "\n";
     struct evbuffer *output_buffer =
         evhttp_request_get_output_buffer(req.get());
     assert(output_buffer);
@@ -841,7 +869,10 @@ static UniValue CallRPC(BaseRequestHandler *rh, const std::string &strMethod,
 
     // Parse reply
     UniValue valReply(UniValue::VSTR);
-    if (!valReply.read(response.body)) {
+    const bool cborReply =
+        ToLower(response.contentType).rfind(CBOR_CONTENT_TYPE, 0) == 0;
+    if (!(cborReply ? DecodeCBOR(MakeUCharSpan(response.body), valReply)
+                    : valReply.read(response.body))) {
         throw std::runtime_error("couldn't parse reply from server");
     }
     const UniValue reply = rh->ProcessReply(valReply);
@@ -25,6 +25,12 @@ bool CCoinsView::BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) {
 CCoinsViewCursor *CCoinsView::Cursor() const {
     return nullptr;
 }
+std::vector<std::unique_ptr<CCoinsViewCursor>>
+CCoinsView::RangeCursors(size_t n_ranges) const {
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    cursors.emplace_back(Cursor());
+    return cursors;
+}
 bool CCoinsView::HaveCoin(const COutPoint &outpoint) const {
     Coin coin;
     return GetCoin(outpoint, coin);
@@ -53,6 +59,10 @@ bool CCoinsViewBacked::BatchWrite(CCoinsMap &mapCoins,
 CCoinsViewCursor *CCoinsViewBacked::Cursor() const {
     return base->Cursor();
 }
+std::vector<std::unique_ptr<CCoinsViewCursor>>
+CCoinsViewBacked::RangeCursors(size_t n_ranges) const {
+    return base->RangeCursors(n_ranges);
+}
 size_t CCoinsViewBacked::EstimateSize() const {
     return base->EstimateSize();
 }
@@ -15,7 +15,9 @@
 #include <cassert>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 /**
  * A UTXO entry.
@@ -173,6 +175,15 @@ public:
     //! Get a cursor to iterate over the whole state
     virtual CCoinsViewCursor *Cursor() const;
 
+    /**
+     * Get cursors to iterate over disjoint ranges of the state, which cover
+     * the whole state together and can be used concurrently. All the outputs
+     * of a transaction are in the same range. At most n_ranges cursors are
+     * returned, the default implementation returns a single cursor.
+     */
+    virtual std::vector<std::unique_ptr<CCoinsViewCursor>>
+    RangeCursors(size_t n_ranges) const;
+
     //! As we use CCoinsViews polymorphically, have a virtual destructor
     virtual ~CCoinsView() {}
 
@@ -194,6 +205,8 @@ public:
     void SetBackend(CCoinsView &viewIn);
     bool BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) override;
     CCoinsViewCursor *Cursor() const override;
+    std::vector<std::unique_ptr<CCoinsViewCursor>>
+    RangeCursors(size_t n_ranges) const override;
     size_t EstimateSize() const override;
 };
 
@@ -231,6 +244,11 @@ public:
         throw std::logic_error(
             "CCoinsViewCache cursor iteration not supported.");
     }
+    std::vector<std::unique_ptr<CCoinsViewCursor>>
+    RangeCursors(size_t n_ranges) const override {
+        throw std::logic_error(
+            "CCoinsViewCache cursor iteration not supported.");
+    }
 
     /**
      * Check if we have the given utxo already loaded in this cache.
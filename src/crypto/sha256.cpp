@@ -22,16 +22,25 @@ namespace sha256d64_sse41 {
 void Transform_4way(uint8_t *out, const uint8_t *in);
 }
 
+namespace sha256_sse41 {
+void Transform_4way(uint32_t *s, const uint8_t *const *chunks);
+}
+
 namespace sha256d64_avx2 {
 void Transform_8way(uint8_t *out, const uint8_t *in);
 }
 
+namespace sha256_avx2 {
+void Transform_8way(uint32_t *s, const uint8_t *const *chunks);
+}
+
 namespace sha256d64_shani {
 void Transform_2way(uint8_t *out, const uint8_t *in);
 }
 
 namespace sha256_shani {
 void Transform(uint32_t *s, const uint8_t *chunk, size_t blocks);
+void Transform_2way(uint32_t *s, const uint8_t *const *chunks);
 }
 
 // Internal implementation code.
@@ -578,6 +587,11 @@ namespace sha256 {
 
 typedef void (*TransformType)(uint32_t *, const uint8_t *, size_t);
 typedef void (*TransformD64Type)(uint8_t *, const uint8_t *);
+/**
+ * Process one 64-byte chunk for each of several independent SHA-256 states.
+ * The state of lane i is stored at s + 8 * i and its chunk at chunks[i].
+ */
+typedef void (*TransformMultiType)(uint32_t *s, const uint8_t *const *chunks);
 
 template <TransformType tr>
 void TransformD64Wrapper(uint8_t *out, const uint8_t *in) {
@@ -618,6 +632,27 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_2way = nullptr;
+TransformMultiType TransformMulti_4way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
+
+/** Check a multi-way transform against the expected states above. */
+bool SelfTestMulti(TransformMultiType tr, size_t ways,
+                   const uint32_t (&result)[9][8], const uint8_t *data) {
+    uint32_t states[8 * 8];
+    const uint8_t *chunks[8];
+    for (size_t i = 0; i < ways; ++i) {
+        std::copy(result[i], result[i] + 8, states + 8 * i);
+        chunks[i] = data + 64 * i;
+    }
+    tr(states, chunks);
+    for (size_t i = 0; i < ways; ++i) {
+        if (!std::equal(states + 8 * i, states + 8 * (i + 1), result[i + 1])) {
+            return false;
+        }
+    }
+    return true;
+}
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -729,6 +764,20 @@ bool SelfTest() {
         }
     }
 
+    // Test the TransformMulti variants, if available.
+    if (TransformMulti_2way &&
+        !SelfTestMulti(TransformMulti_2way, 2, result, data + 1)) {
+        return false;
+    }
+    if (TransformMulti_4way &&
+        !SelfTestMulti(TransformMulti_4way, 4, result, data + 1)) {
+        return false;
+    }
+    if (TransformMulti_8way &&
+        !SelfTestMulti(TransformMulti_8way, 8, result, data + 1)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -780,6 +829,7 @@ std::string SHA256AutoDetect() {
         Transform = sha256_shani::Transform;
         TransformD64 = TransformD64Wrapper<sha256_shani::Transform>;
         TransformD64_2way = sha256d64_shani::Transform_2way;
+        TransformMulti_2way = sha256_shani::Transform_2way;
         ret = "shani(1way,2way)";
         have_sse4 = false; // Disable SSE4/AVX2;
         have_avx2 = false;
@@ -794,6 +844,7 @@ std::string SHA256AutoDetect() {
 #endif
 #if defined(ENABLE_SSE41) && !defined(BUILD_BITCOIN_INTERNAL)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformMulti_4way = sha256_sse41::Transform_4way;
         ret += ",sse41(4way)";
 #endif
     }
@@ -801,6 +852,7 @@ std::string SHA256AutoDetect() {
 #if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256_avx2::Transform_8way;
         ret += ",avx2(8way)";
     }
 #endif
@@ -895,3 +947,164 @@ void SHA256D64(uint8_t *out, const uint8_t *in, size_t blocks) {
         --blocks;
     }
 }
+
+namespace {
+/**
+ * A message being hashed in one lane of the multi-way transforms. The
+ * complete 64-byte blocks are read from the message itself, the last one or
+ * two blocks containing the padding are built in a local buffer.
+ */
+struct MultiLane {
+    const uint8_t *data;
+    size_t index;
+    size_t fullBlocks;
+    size_t blocks;
+    size_t nextBlock;
+    int rounds;
+    uint8_t tail[128];
+
+    void Start(const uint8_t *in, size_t len, uint32_t *s) {
+        data = in;
+        fullBlocks = len / 64;
+        const size_t remaining = len % 64;
+        std::fill(tail, tail + sizeof(tail), 0);
+        if (remaining > 0) {
+            std::copy(in + 64 * fullBlocks, in + len, tail);
+        }
+        tail[remaining] = 0x80;
+        const size_t tailBlocks = remaining < 56 ? 1 : 2;
+        WriteBE64(tail + 64 * tailBlocks - 8, uint64_t(len) << 3);
+        blocks = fullBlocks + tailBlocks;
+        nextBlock = 0;
+        sha256::Initialize(s);
+    }
+
+    const uint8_t *Chunk() const {
+        return nextBlock < fullBlocks ? data + 64 * nextBlock
+                                      : tail + 64 * (nextBlock - fullBlocks);
+    }
+
+    /** Process all the remaining blocks with the single-way transform. */
+    void Finish(uint32_t *s) {
+        if (nextBlock < fullBlocks) {
+            Transform(s, data + 64 * nextBlock, fullBlocks - nextBlock);
+            nextBlock = fullBlocks;
+        }
+        Transform(s, tail + 64 * (nextBlock - fullBlocks), blocks - nextBlock);
+        nextBlock = blocks;
+    }
+};
+
+void WriteState(uint8_t *out, const uint32_t *s) {
+    for (size_t i = 0; i < 8; ++i) {
+        WriteBE32(out + 4 * i, s[i]);
+    }
+}
+
+void SHA256MultiImpl(uint8_t *output, const uint8_t *const *inputs,
+                     const size_t *lengths, size_t count, int rounds) {
+    TransformMultiType tr = nullptr;
+    size_t ways = 1;
+    if (TransformMulti_8way && count >= 8) {
+        tr = TransformMulti_8way;
+        ways = 8;
+    } else if (TransformMulti_4way && count >= 4) {
+        tr = TransformMulti_4way;
+        ways = 4;
+    } else if (TransformMulti_2way && count >= 2) {
+        tr = TransformMulti_2way;
+        ways = 2;
+    }
+
+    MultiLane lanes[8];
+    uint32_t states[8 * 8];
+    const uint8_t *chunks[8];
+    uint8_t digest[CSHA256::OUTPUT_SIZE];
+
+    // Hash one message at a time when no multi-way transform is usable.
+    if (!tr) {
+        for (size_t i = 0; i < count; ++i) {
+            lanes[0].Start(inputs[i], lengths[i], states);
+            lanes[0].Finish(states);
+            for (int r = 1; r < rounds; ++r) {
+                WriteState(digest, states);
+                lanes[0].Start(digest, sizeof(digest), states);
+                lanes[0].Finish(states);
+            }
+            WriteState(output + CSHA256::OUTPUT_SIZE * i, states);
+        }
+        return;
+    }
+
+    size_t next = 0;
+    for (size_t i = 0; i < ways; ++i) {
+        lanes[i].index = next;
+        lanes[i].rounds = 1;
+        lanes[i].Start(inputs[next], lengths[next], states + 8 * i);
+        next++;
+    }
+
+    // Keep all the lanes busy, refilling each of them with the next message
+    // as soon as it is done, until there are not enough messages left.
+    bool full = true;
+    while (full) {
+        for (size_t i = 0; i < ways; ++i) {
+            chunks[i] = lanes[i].Chunk();
+        }
+        tr(states, chunks);
+        for (size_t i = 0; i < ways; ++i) {
+            MultiLane &lane = lanes[i];
+            if (++lane.nextBlock < lane.blocks) {
+                continue;
+            }
+            uint32_t *s = states + 8 * i;
+            if (lane.rounds < rounds) {
+                // Hash the digest again in the same lane.
+                WriteState(digest, s);
+                lane.rounds++;
+                lane.Start(digest, sizeof(digest), s);
+                continue;
+            }
+            WriteState(output + CSHA256::OUTPUT_SIZE * lane.index, s);
+            if (next == count) {
+                // Leave this lane empty and finish the others below.
+                lane.nextBlock = lane.blocks;
+                lane.rounds = rounds;
+                full = false;
+                continue;
+            }
+            lane.index = next;
+            lane.rounds = 1;
+            lane.Start(inputs[next], lengths[next], s);
+            next++;
+        }
+    }
+
+    // Complete the messages that are still in flight one at a time.
+    for (size_t i = 0; i < ways; ++i) {
+        MultiLane &lane = lanes[i];
+        if (lane.nextBlock == lane.blocks && lane.rounds == rounds) {
+            continue;
+        }
+        uint32_t *s = states + 8 * i;
+        lane.Finish(s);
+        while (lane.rounds < rounds) {
+            WriteState(digest, s);
+            lane.rounds++;
+            lane.Start(digest, sizeof(digest), s);
+            lane.Finish(s);
+        }
+        WriteState(output + CSHA256::OUTPUT_SIZE * lane.index, s);
+    }
+}
+} // namespace
+
+void SHA256Multi(uint8_t *output, const uint8_t *const *inputs,
+                 const size_t *lengths, size_t count) {
+    SHA256MultiImpl(output, inputs, lengths, count, 1);
+}
+
+void SHA256DMulti(uint8_t *output, const uint8_t *const *inputs,
+                  const size_t *lengths, size_t count) {
+    SHA256MultiImpl(output, inputs, lengths, count, 2);
+}
@@ -39,4 +39,21 @@ std::string SHA256AutoDetect();
  */
 void SHA256D64(uint8_t *output, const uint8_t *input, size_t blocks);
 
+/**
+ * Compute the SHA256's of multiple messages of arbitrary lengths, hashing
+ * several of them in parallel when a multi-way implementation is available.
+ * output:  pointer to a count*32 byte output buffer
+ * inputs:  pointers to the count messages
+ * lengths: the lengths in bytes of the count messages
+ * count:   the number of hashes to compute.
+ */
+void SHA256Multi(uint8_t *output, const uint8_t *const *inputs,
+                 const size_t *lengths, size_t count);
+
+/**
+ * Same as SHA256Multi, but compute the double-SHA256's of the messages.
+ */
+void SHA256DMulti(uint8_t *output, const uint8_t *const *inputs,
+                  const size_t *lengths, size_t count);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
@@ -444,4 +444,84 @@ void Transform_4way(uint8_t *out, const uint8_t *in) {
 }
 } // namespace sha256d64_sse41
 
+namespace sha256_sse41 {
+
+using namespace sha256d64_sse41;
+
+namespace {
+    alignas(64) const uint32_t ROUND_CONSTANTS[64] = {
+        0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul, 0x3956c25bul,
+        0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul, 0xd807aa98ul, 0x12835b01ul,
+        0x243185beul, 0x550c7dc3ul, 0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul,
+        0xc19bf174ul, 0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul,
+        0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul, 0x983e5152ul,
+        0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul, 0xc6e00bf3ul, 0xd5a79147ul,
+        0x06ca6351ul, 0x14292967ul, 0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul,
+        0x53380d13ul, 0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+        0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul, 0xd192e819ul,
+        0xd6990624ul, 0xf40e3585ul, 0x106aa070ul, 0x19a4c116ul, 0x1e376c08ul,
+        0x2748774cul, 0x34b0bcb5ul, 0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful,
+        0x682e6ff3ul, 0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul,
+        0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul,
+    };
+
+    __m128i inline Schedule(__m128i *w, int i) {
+        if (i >= 16) {
+            Inc(w[i & 15], sigma1(w[(i + 14) & 15]), w[(i + 9) & 15],
+                sigma0(w[(i + 1) & 15]));
+        }
+        return w[i & 15];
+    }
+} // namespace
+
+void Transform_4way(uint32_t *s, const uint8_t *const *chunks) {
+    __m128i state[8], w[16];
+    for (int i = 0; i < 8; i++) {
+        state[i] = _mm_set_epi32(s[i], s[8 + i], s[16 + i], s[24 + i]);
+    }
+    for (int i = 0; i < 16; i++) {
+        w[i] = _mm_set_epi32(
+            ReadBE32(chunks[0] + 4 * i), ReadBE32(chunks[1] + 4 * i),
+            ReadBE32(chunks[2] + 4 * i), ReadBE32(chunks[3] + 4 * i));
+    }
+
+    __m128i a = state[0], b = state[1], c = state[2], d = state[3],
+            e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i += 8) {
+        Round(a, b, c, d, e, f, g, h,
+              Add(K(ROUND_CONSTANTS[i]), Schedule(w, i)));
+        Round(h, a, b, c, d, e, f, g,
+              Add(K(ROUND_CONSTANTS[i + 1]), Schedule(w, i + 1)));
+        Round(g, h, a, b, c, d, e, f,
+              Add(K(ROUND_CONSTANTS[i + 2]), Schedule(w, i + 2)));
+        Round(f, g, h, a, b, c, d, e,
+              Add(K(ROUND_CONSTANTS[i + 3]), Schedule(w, i + 3)));
+        Round(e, f, g, h, a, b, c, d,
+              Add(K(ROUND_CONSTANTS[i + 4]), Schedule(w, i + 4)));
+        Round(d, e, f, g, h, a, b, c,
+              Add(K(ROUND_CONSTANTS[i + 5]), Schedule(w, i + 5)));
+        Round(c, d, e, f, g, h, a, b,
+              Add(K(ROUND_CONSTANTS[i + 6]), Schedule(w, i + 6)));
+        Round(b, c, d, e, f, g, h, a,
+              Add(K(ROUND_CONSTANTS[i + 7]), Schedule(w, i + 7)));
+    }
+    state[0] = Add(state[0], a);
+    state[1] = Add(state[1], b);
+    state[2] = Add(state[2], c);
+    state[3] = Add(state[3], d);
+    state[4] = Add(state[4], e);
+    state[5] = Add(state[5], f);
+    state[6] = Add(state[6], g);
+    state[7] = Add(state[7], h);
+
+    for (int i = 0; i < 8; i++) {
+        a = state[i];
+        s[i] = _mm_extract_epi32(a, 3);
+        s[8 + i] = _mm_extract_epi32(a, 2);
+        s[16 + i] = _mm_extract_epi32(a, 1);
+        s[24 + i] = _mm_extract_epi32(a, 0);
+    }
+}
+} // namespace sha256_sse41
+
 #endif
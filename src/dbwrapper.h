@@ -15,6 +15,8 @@
 #include <leveldb/db.h>
 #include <leveldb/write_batch.h>
 
+#include <memory>
+
 static const size_t DBWRAPPER_PREALLOC_KEY_SIZE = 64;
 static const size_t DBWRAPPER_PREALLOC_VALUE_SIZE = 1024;
 
@@ -290,6 +292,41 @@ public:
         return new CDBIterator(*this, pdb->NewIterator(iteroptions));
     }
 
+    /**
+     * A consistent read-only view of the database, released on destruction.
+     * All the iterators created from the same snapshot see the same state,
+     * even if the database is written concurrently.
+     */
+    class Snapshot {
+    private:
+        leveldb::DB *const pdb;
+        const leveldb::Snapshot *const psnapshot;
+
+        friend class CDBWrapper;
+
+    public:
+        explicit Snapshot(leveldb::DB *pdbIn)
+            : pdb(pdbIn), psnapshot(pdbIn->GetSnapshot()) {}
+        ~Snapshot() { pdb->ReleaseSnapshot(psnapshot); }
+
+        Snapshot(const Snapshot &) = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+    };
+
+    std::shared_ptr<const Snapshot> GetSnapshot() {
+        return std::make_shared<const Snapshot>(pdb);
+    }
+
+    /**
+     * Create an iterator over the database as it was when the snapshot was
+     * taken. The snapshot must outlive the iterator.
+     */
+    CDBIterator *NewIterator(const Snapshot &snapshot) {
+        leveldb::ReadOptions options = iteroptions;
+        options.snapshot = snapshot.psnapshot;
+        return new CDBIterator(*this, pdb->NewIterator(options));
+    }
+
     /**
      * Return true if the database managed by this class contains no entries.
      */
@@ -7,6 +7,7 @@
 #include <chainparams.h>
 #include <config.h>
 #include <crypto/hmac_sha256.h>
+#include <rpc/cbor.h>
 #include <rpc/protocol.h>
 #include <util/strencodings.h>
 #include <util/system.h>
@@ -73,9 +74,37 @@ static std::unique_ptr<HTTPRPCTimerInterface> httpRPCTimerInterface;
 /* RPC Auth Whitelist */
 static std::map<std::string, std::set<std::string>> g_rpc_whitelist;
 static bool g_rpc_whitelist_default = false;
+/* RPC methods dispatched to the slow work queue */
+static std::set<std::string> g_rpc_slow_methods;
+
+/* Maximum number of threads executing the calls of a batch concurrently */
+static size_t g_rpc_batch_parallelism = DEFAULT_RPC_BATCH_PARALLELISM;
+
+/**
+ * Number of bytes from the request body that are inspected to determine which
+ * work queue the request is dispatched to.
+ */
+static const size_t RPC_METHOD_PEEK_SIZE = 256;
+
+/** Whether the request body is CBOR encoded, and the reply should be too */
+static bool IsCBORRequest(HTTPRequest *req) {
+    const auto [found, contentType] = req->GetHeader("content-type");
+    return found && ToLower(contentType).rfind(CBOR_CONTENT_TYPE, 0) == 0;
+}
+
+static void WriteRPCReply(HTTPRequest *req, int nStatus, const UniValue &reply,
+                          bool cbor) {
+    if (cbor) {
+        req->WriteHeader("Content-Type", CBOR_CONTENT_TYPE);
+        req->WriteReply(nStatus, EncodeCBOR(reply));
+    } else {
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(nStatus, reply.write() + "\n");
+    }
+}
 
 static void JSONErrorReply(HTTPRequest *req, const UniValue &objError,
-                           const UniValue &id) {
+                           const UniValue &id, bool cbor) {
     // Send error reply from json-rpc error object.
     int nStatus = HTTP_INTERNAL_SERVER_ERROR;
     int code = find_value(objError, "code").get_int();
@@ -86,16 +115,49 @@ static void JSONErrorReply(HTTPRequest *req, const UniValue &objError,
         nStatus = HTTP_NOT_FOUND;
     }
 
-    std::string strReply = JSONRPCReply(NullUniValue, objError, id);
-
-    req->WriteHeader("Content-Type", "application/json");
-    req->WriteReply(nStatus, strReply);
+    WriteRPCReply(req, nStatus, JSONRPCReplyObj(NullUniValue, objError, id),
+                  cbor);
 }
 
 /*
  * This function checks username and password against -rpcauth entries from
  * config file.
  */
+void HTTPResultStream::SendBuffer() {
+    req->WriteReplyChunk(buffer);
+    buffer.clear();
+}
+
+void HTTPResultStream::Write(const std::string &json) {
+    if (!started) {
+        started = true;
+        req->WriteHeader("Content-Type", "application/json");
+        req->StartChunkedReply(HTTP_OK);
+        buffer = prefix;
+    }
+    buffer += json;
+    if (buffer.size() >= SEND_SIZE) {
+        SendBuffer();
+    }
+}
+
+void HTTPResultStream::Flush() {
+    if (started && !req->WaitForPendingReplyChunks()) {
+        throw std::runtime_error("Client closed the connection");
+    }
+}
+
+void HTTPResultStream::Finish(bool complete) {
+    if (!started) {
+        return;
+    }
+    if (complete) {
+        buffer += suffix;
+    }
+    SendBuffer();
+    req->EndChunkedReply();
+}
+
 static bool multiUserAuthorized(std::string strUserPass) {
     if (strUserPass.find(':') == std::string::npos) {
         return false;
@@ -325,17 +387,20 @@ bool HTTPRPCRequestProcessor::ProcessHTTPRequest(HTTPRequest *req) {
         return false;
     }
 
+    const bool use_cbor = IsCBORRequest(req);
     try {
         // Parse request
         UniValue valRequest;
-        if (!valRequest.read(req->ReadBody())) {
+        const std::string body = req->ReadBody();
+        if (!(use_cbor ? DecodeCBOR(MakeUCharSpan(body), valRequest)
+                       : valRequest.read(body))) {
             throw JSONRPCError(RPC_PARSE_ERROR, "Parse error");
         }
 
         // Set the URI
         jreq.URI = req->GetURI();
 
-        std::string strReply;
+        UniValue reply;
         bool user_has_whitelist = g_rpc_whitelist.count(jreq.authUser);
         if (!user_has_whitelist && g_rpc_whitelist_default) {
             LogPrintf("RPC User %s not allowed to call any methods\n",
@@ -353,10 +418,34 @@ bool HTTPRPCRequestProcessor::ProcessHTTPRequest(HTTPRequest *req) {
                 req->WriteReply(HTTP_FORBIDDEN);
                 return false;
             }
-            UniValue result = rpcServer.ExecuteCommand(config, jreq);
+            // Let the method stream large results directly to the client.
+            HTTPResultStream stream(req, "{\"result\":",
+                                    ",\"error\":null,\"id\":" +
+                                        jreq.id.write() + "}\n");
+            if (!use_cbor) {
+                jreq.resultStream = &stream;
+            }
+            UniValue result;
+            try {
+                result = rpcServer.ExecuteCommand(config, jreq);
+            } catch (...) {
+                if (!stream.IsStarted()) {
+                    throw;
+                }
+                // The status has already been sent, so the error can't be
+                // reported. Truncate the reply instead.
+                LogPrintf("RPC method %s failed while streaming its result\n",
+                          jreq.strMethod);
+                stream.Finish(false);
+                return false;
+            }
+            if (stream.IsStarted()) {
+                stream.Finish();
+                return true;
+            }
 
             // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            reply = JSONRPCReplyObj(result, NullUniValue, jreq.id);
 
             // array of requests
         } else if (valRequest.isArray()) {
@@ -381,19 +470,28 @@ bool HTTPRPCRequestProcessor::ProcessHTTPRequest(HTTPRequest *req) {
                     }
                 }
             }
-            strReply = JSONRPCExecBatch(config, rpcServer, jreq,
-                                        valRequest.get_array());
+            // The batches are dispatched to the slow work queue, use its idle
+            // workers to execute the calls in parallel.
+            RPCParallelRunner runner = nullptr;
+            if (g_rpc_batch_parallelism > 1) {
+                runner = [](const std::vector<std::function<void()>> &tasks) {
+                    RunOnHTTPWorkers(HTTPWorkQueueType::RPC_SLOW, tasks,
+                                     g_rpc_batch_parallelism);
+                };
+            }
+            reply = JSONRPCExecBatch(config, rpcServer, jreq,
+                                     valRequest.get_array(), runner);
         } else {
             throw JSONRPCError(RPC_PARSE_ERROR, "Top-level object parse error");
         }
 
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strReply);
+        WriteRPCReply(req, HTTP_OK, reply, use_cbor);
     } catch (const UniValue &objError) {
-        JSONErrorReply(req, objError, jreq.id);
+        JSONErrorReply(req, objError, jreq.id, use_cbor);
         return false;
     } catch (const std::exception &e) {
-        JSONErrorReply(req, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id);
+        JSONErrorReply(req, JSONRPCError(RPC_PARSE_ERROR, e.what()), jreq.id,
+                       use_cbor);
         return false;
     }
     return true;
@@ -420,6 +518,15 @@ static bool InitRPCAuthentication() {
         LogPrintf("Using rpcauth authentication.\n");
     }
 
+    const std::vector<std::string> slowMethods =
+        gArgs.IsArgSet("-rpcslowmethod") ? gArgs.GetArgs("-rpcslowmethod")
+                                         : DEFAULT_RPC_SLOW_METHODS;
+    g_rpc_slow_methods =
+        std::set<std::string>(slowMethods.begin(), slowMethods.end());
+    g_rpc_batch_parallelism = std::max<int64_t>(
+        gArgs.GetIntArg("-rpcbatchparallelism", DEFAULT_RPC_BATCH_PARALLELISM),
+        1);
+
     g_rpc_whitelist_default = gArgs.GetBoolArg("-rpcwhitelistdefault",
                                                gArgs.IsArgSet("-rpcwhitelist"));
     for (const std::string &strRPCWhitelist : gArgs.GetArgs("-rpcwhitelist")) {
@@ -446,6 +553,81 @@ static bool InitRPCAuthentication() {
     return true;
 }
 
+std::string PeekJSONRPCMethod(const std::string &body) {
+    static const std::string methodKey = "\"method\"";
+    size_t pos = body.find(methodKey);
+    if (pos == std::string::npos) {
+        return "";
+    }
+
+    auto skipSpaces = [&](size_t p) {
+        while (p < body.size() && IsSpace(body[p])) {
+            p++;
+        }
+        return p;
+    };
+
+    pos = skipSpaces(pos + methodKey.size());
+    if (pos >= body.size() || body[pos] != ':') {
+        return "";
+    }
+    pos = skipSpaces(pos + 1);
+    if (pos >= body.size() || body[pos] != '"') {
+        return "";
+    }
+
+    const size_t end = body.find('"', ++pos);
+    if (end == std::string::npos) {
+        return "";
+    }
+    return body.substr(pos, end - pos);
+}
+
+/**
+ * Best effort extraction of the method name from the beginning of a CBOR
+ * encoded request. Only the method names shorter than 24 characters, which
+ * are encoded with a single byte header, are found.
+ */
+static std::string PeekCBORRPCMethod(const std::string &body) {
+    // The "method" key, as a 6 bytes long text string
+    static const std::string key = "\x66method";
+    const size_t pos = body.find(key);
+    if (pos == std::string::npos || pos + key.size() >= body.size()) {
+        return "";
+    }
+    const uint8_t head = body[pos + key.size()];
+    if (head >> 5 != 3 || (head & 0x1f) >= 24) {
+        return "";
+    }
+    return body.substr(pos + key.size() + 1, head & 0x1f);
+}
+
+/**
+ * Dispatch the batches and the requests for the expensive methods to the slow
+ * work queue so they don't delay the cheap requests.
+ */
+static HTTPWorkQueueType SelectRPCWorkQueue(HTTPRequest *req) {
+    const std::string body = req->PeekBody(RPC_METHOD_PEEK_SIZE);
+    if (IsCBORRequest(req)) {
+        // CBOR arrays use the major type 4
+        if (!body.empty() && uint8_t(body[0]) >> 5 == 4) {
+            return HTTPWorkQueueType::RPC_SLOW;
+        }
+        return g_rpc_slow_methods.count(PeekCBORRPCMethod(body))
+                   ? HTTPWorkQueueType::RPC_SLOW
+                   : HTTPWorkQueueType::RPC;
+    }
+
+    const size_t start = body.find_first_not_of(" \t\n\r");
+    if (start != std::string::npos && body[start] == '[') {
+        return HTTPWorkQueueType::RPC_SLOW;
+    }
+
+    return g_rpc_slow_methods.count(PeekJSONRPCMethod(body))
+               ? HTTPWorkQueueType::RPC_SLOW
+               : HTTPWorkQueueType::RPC;
+}
+
 bool StartHTTPRPC(HTTPRPCRequestProcessor &httpRPCRequestProcessor) {
     LogPrint(BCLog::RPC, "Starting HTTP RPC server\n");
     if (!InitRPCAuthentication()) {
@@ -456,9 +638,10 @@ bool StartHTTPRPC(HTTPRPCRequestProcessor &httpRPCRequestProcessor) {
         &rpcFunction =
             std::bind(&HTTPRPCRequestProcessor::DelegateHTTPRequest,
                       &httpRPCRequestProcessor, std::placeholders::_2);
-    RegisterHTTPHandler("/", true, rpcFunction);
+    RegisterHTTPHandler("/", true, rpcFunction, SelectRPCWorkQueue);
     if (g_wallet_init_interface.HasWalletSupport()) {
-        RegisterHTTPHandler("/wallet/", false, rpcFunction);
+        RegisterHTTPHandler("/wallet/", false, rpcFunction,
+                            SelectRPCWorkQueue);
     }
     struct event_base *eventBase = EventBase();
     assert(eventBase);
@@ -6,12 +6,75 @@
 #define BITCOIN_HTTPRPC_H
 
 #include <httpserver.h>
+#include <rpc/request.h>
 #include <rpc/server.h>
 
 #include <any>
+#include <string>
+#include <vector>
 
 class Config;
 
+/**
+ * RPC methods that are dispatched to the slow work queue by default, because
+ * they can take a long time to complete depending on their parameters.
+ */
+static const std::vector<std::string> DEFAULT_RPC_SLOW_METHODS{
+    "dumptxoutset",    "getblock",    "getblockstats", "getrawmempool",
+    "gettxoutsetinfo", "savemempool", "scantxoutset",  "verifychain"};
+
+/**
+ * Maximum number of threads executing the calls of a single batch
+ * concurrently.
+ */
+static const int DEFAULT_RPC_BATCH_PARALLELISM = 4;
+
+/**
+ * Best effort extraction of the method name from the beginning of a JSON-RPC
+ * request body, without parsing the whole request. Returns an empty string if
+ * the method could not be found.
+ */
+std::string PeekJSONRPCMethod(const std::string &body);
+
+/**
+ * Result stream sending the JSON to the client as a chunked HTTP reply while
+ * it is produced. The data is sent by chunks of about SEND_SIZE bytes, and
+ * Flush() blocks while the client is too slow to consume the reply.
+ */
+class HTTPResultStream final : public RPCResultStream {
+public:
+    static constexpr size_t SEND_SIZE = 64 * 1024;
+
+private:
+    HTTPRequest *req;
+    //! Written before the first chunk of the result
+    const std::string prefix;
+    //! Written after the result
+    const std::string suffix;
+    std::string buffer;
+    bool started{false};
+
+    void SendBuffer();
+
+public:
+    HTTPResultStream(HTTPRequest *reqIn, std::string prefixIn,
+                     std::string suffixIn)
+        : req(reqIn), prefix(std::move(prefixIn)),
+          suffix(std::move(suffixIn)) {}
+
+    void Write(const std::string &json) override;
+    /** Throws if the client closed the connection. */
+    void Flush() override;
+    bool IsStarted() const override { return started; }
+
+    /**
+     * Complete the reply if the stream has been started. In case the result
+     * could not be completed, the reply is ended without the suffix so the
+     * client gets an invalid JSON document instead of a truncated valid one.
+     */
+    void Finish(bool complete = true);
+};
+
 class HTTPRPCRequestProcessor {
 private:
     Config &config;
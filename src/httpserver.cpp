@@ -17,6 +17,7 @@
 #include <util/strencodings.h>
 #include <util/system.h>
 #include <util/threadnames.h>
+#include <util/time.h>
 #include <util/translation.h>
 
 #include <event2/buffer.h>
@@ -30,6 +31,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -62,18 +64,43 @@ private:
     Config *config;
 };
 
+/** Work item running an arbitrary function */
+class HTTPTaskItem final : public HTTPClosure {
+public:
+    explicit HTTPTaskItem(std::function<void()> _func)
+        : func(std::move(_func)) {}
+
+    void operator()() override { func(); }
+
+private:
+    std::function<void()> func;
+};
+
 /**
  * Simple work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
  */
 template <typename WorkItem> class WorkQueue {
 private:
+    struct QueuedItem {
+        std::unique_ptr<WorkItem> item;
+        SteadyMicroseconds enqueueTime;
+    };
+
     /** Mutex protects entire object */
     Mutex cs;
     std::condition_variable cond;
-    std::deque<std::unique_ptr<WorkItem>> queue;
+    std::deque<QueuedItem> queue;
     bool running;
     size_t maxDepth;
+    /** Number of worker threads waiting for an item */
+    size_t numIdle{0};
+
+    /** Statistics */
+    uint64_t processed{0};
+    uint64_t rejected{0};
+    Log2Histogram queueTime;
+    Log2Histogram runTime;
 
 public:
     explicit WorkQueue(size_t _maxDepth) : running(true), maxDepth(_maxDepth) {}
@@ -86,32 +113,76 @@ public:
     bool Enqueue(WorkItem *item) {
         LOCK(cs);
         if (queue.size() >= maxDepth) {
+            rejected++;
             return false;
         }
-        queue.emplace_back(std::unique_ptr<WorkItem>(item));
+        queue.push_back(
+            {std::unique_ptr<WorkItem>(item), Now<SteadyMicroseconds>()});
         cond.notify_one();
         return true;
     }
 
+    /**
+     * Enqueue up to maxItems work items built by makeItem, but no more than the
+     * number of idle workers so they are processed immediately. The queue depth
+     * limit does not apply. Returns the number of items enqueued.
+     */
+    size_t EnqueueForIdleWorkers(
+        size_t maxItems,
+        const std::function<std::unique_ptr<WorkItem>()> &makeItem) {
+        LOCK(cs);
+        if (!running || numIdle <= queue.size()) {
+            return 0;
+        }
+        const size_t count = std::min(maxItems, numIdle - queue.size());
+        for (size_t i = 0; i < count; i++) {
+            queue.push_back({makeItem(), Now<SteadyMicroseconds>()});
+            cond.notify_one();
+        }
+        return count;
+    }
+
     /** Thread function */
     void Run() {
         while (true) {
             std::unique_ptr<WorkItem> i;
+            SteadyMicroseconds start;
             {
                 WAIT_LOCK(cs, lock);
                 while (running && queue.empty()) {
+                    numIdle++;
                     cond.wait(lock);
+                    numIdle--;
                 }
                 if (!running) {
                     break;
                 }
-                i = std::move(queue.front());
+                i = std::move(queue.front().item);
+                start = Now<SteadyMicroseconds>();
+                queueTime.Add(
+                    count_microseconds(start - queue.front().enqueueTime));
                 queue.pop_front();
             }
             (*i)();
+
+            LOCK(cs);
+            runTime.Add(
+                count_microseconds(Now<SteadyMicroseconds>() - start));
+            processed++;
         }
     }
 
+    /** Fill the statistics of this queue */
+    void GetStats(HTTPWorkQueueStats &stats) {
+        LOCK(cs);
+        stats.depth = queue.size();
+        stats.max_depth = maxDepth;
+        stats.processed = processed;
+        stats.rejected = rejected;
+        stats.queue_time = queueTime;
+        stats.run_time = runTime;
+    }
+
     /** Interrupt and exit loops */
     void Interrupt() {
         LOCK(cs);
@@ -122,11 +193,37 @@ public:
 
 struct HTTPPathHandler {
     HTTPPathHandler(std::string _prefix, bool _exactMatch,
-                    HTTPRequestHandler _handler)
-        : prefix(_prefix), exactMatch(_exactMatch), handler(_handler) {}
+                    HTTPRequestHandler _handler,
+                    HTTPWorkQueueSelector _selector)
+        : prefix(_prefix), exactMatch(_exactMatch), handler(_handler),
+          selector(_selector) {}
     std::string prefix;
     bool exactMatch;
     HTTPRequestHandler handler;
+    HTTPWorkQueueSelector selector;
+};
+
+/** A work queue and the pool of worker threads serving it */
+struct HTTPWorkerPool {
+    HTTPWorkQueueType type;
+    //! Command line options for the number of threads and the queue depth
+    std::string threadsArg;
+    int defaultThreads;
+    std::string depthArg;
+    int defaultDepth;
+    //! Prefix for the worker threads name
+    std::string threadName;
+
+    int numThreads{0};
+    std::unique_ptr<WorkQueue<HTTPClosure>> queue;
+    std::vector<std::thread> workers;
+
+    HTTPWorkerPool(HTTPWorkQueueType _type, std::string _threadsArg,
+                   int _defaultThreads, std::string _depthArg,
+                   int _defaultDepth, std::string _threadName)
+        : type(_type), threadsArg(std::move(_threadsArg)),
+          defaultThreads(_defaultThreads), depthArg(std::move(_depthArg)),
+          defaultDepth(_defaultDepth), threadName(std::move(_threadName)) {}
 };
 
 /** HTTP module state */
@@ -137,8 +234,9 @@ static struct event_base *eventBase = nullptr;
 static struct evhttp *eventHTTP = nullptr;
 //! List of subnets to allow RPC connections from
 static std::vector<CSubNet> rpc_allow_subnets;
-//! Work queue for handling longer requests off the event loop thread
-static WorkQueue<HTTPClosure> *workQueue = nullptr;
+//! Work queues for handling longer requests off the event loop thread,
+//! indexed by HTTPWorkQueueType
+static std::vector<HTTPWorkerPool> workerPools;
 //! Handlers for (sub)paths
 static std::vector<HTTPPathHandler> pathHandlers;
 //! Bound listening sockets
@@ -271,16 +369,22 @@ static void http_request_cb(struct evhttp_request *req, void *arg) {
 
     // Dispatch to worker thread.
     if (i != iend) {
+        const HTTPWorkQueueType queueType =
+            i->selector ? i->selector(hreq.get()) : HTTPWorkQueueType::RPC;
+        assert(size_t(queueType) < workerPools.size());
+        HTTPWorkerPool &pool = workerPools[size_t(queueType)];
+
         std::unique_ptr<HTTPWorkItem> item(
             new HTTPWorkItem(config, std::move(hreq), path, i->handler));
-        assert(workQueue);
-        if (workQueue->Enqueue(item.get())) {
+        assert(pool.queue);
+        if (pool.queue->Enqueue(item.get())) {
             /* if true, queue took ownership */
             item.release();
         } else {
-            LogPrintf("WARNING: request rejected because http work queue depth "
-                      "exceeded, it can be increased with the -rpcworkqueue= "
-                      "setting\n");
+            LogPrintf("WARNING: request rejected because http %s work queue "
+                      "depth exceeded, it can be increased with the %s= "
+                      "setting\n",
+                      HTTPWorkQueueTypeName(queueType), pool.depthArg);
             item->req->WriteReply(HTTP_SERVICE_UNAVAILABLE,
                                   "Work queue depth exceeded");
         }
@@ -360,8 +464,9 @@ static bool HTTPBindAddresses(struct evhttp *http) {
 }
 
 /** Simple wrapper to set thread name and run work queue */
-static void HTTPWorkQueueRun(WorkQueue<HTTPClosure> *queue, int worker_num) {
-    util::ThreadRename(strprintf("httpworker.%i", worker_num));
+static void HTTPWorkQueueRun(WorkQueue<HTTPClosure> *queue,
+                             const std::string &threadName, int worker_num) {
+    util::ThreadRename(strprintf("%s.%i", threadName, worker_num));
     queue->Run();
 }
 
@@ -429,11 +534,28 @@ bool InitHTTPServer(Config &config) {
     }
 
     LogPrint(BCLog::HTTP, "Initialized HTTP server\n");
-    int workQueueDepth = std::max(
-        (long)gArgs.GetIntArg("-rpcworkqueue", DEFAULT_HTTP_WORKQUEUE), 1L);
-    LogPrintf("HTTP: creating work queue of depth %d\n", workQueueDepth);
 
-    workQueue = new WorkQueue<HTTPClosure>(workQueueDepth);
+    // Must be in HTTPWorkQueueType order.
+    workerPools.clear();
+    workerPools.emplace_back(HTTPWorkQueueType::RPC, "-rpcthreads",
+                             DEFAULT_HTTP_THREADS, "-rpcworkqueue",
+                             DEFAULT_HTTP_WORKQUEUE, "httpworker");
+    workerPools.emplace_back(HTTPWorkQueueType::RPC_SLOW, "-rpcslowthreads",
+                             DEFAULT_HTTP_SLOW_THREADS, "-rpcslowworkqueue",
+                             DEFAULT_HTTP_SLOW_WORKQUEUE, "httpslow");
+    workerPools.emplace_back(HTTPWorkQueueType::REST, "-restthreads",
+                             DEFAULT_HTTP_REST_THREADS, "-restworkqueue",
+                             DEFAULT_HTTP_REST_WORKQUEUE, "httprest");
+
+    for (HTTPWorkerPool &pool : workerPools) {
+        assert(&pool == &workerPools[size_t(pool.type)]);
+        int workQueueDepth = std::max(
+            (long)gArgs.GetIntArg(pool.depthArg, pool.defaultDepth), 1L);
+        LogPrintf("HTTP: creating %s work queue of depth %d\n",
+                  HTTPWorkQueueTypeName(pool.type), workQueueDepth);
+        pool.queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    }
+
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -455,17 +577,20 @@ bool UpdateHTTPServerLogging(bool enable) {
 }
 
 static std::thread g_thread_http;
-static std::vector<std::thread> g_thread_http_workers;
 
 void StartHTTPServer() {
     LogPrint(BCLog::HTTP, "Starting HTTP server\n");
-    int rpcThreads = std::max(
-        (long)gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
-    LogPrintf("HTTP: starting %d worker threads\n", rpcThreads);
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
-    for (int i = 0; i < rpcThreads; i++) {
-        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, workQueue, i);
+    for (HTTPWorkerPool &pool : workerPools) {
+        pool.numThreads = std::max(
+            (long)gArgs.GetIntArg(pool.threadsArg, pool.defaultThreads), 1L);
+        LogPrintf("HTTP: starting %d %s worker threads\n", pool.numThreads,
+                  HTTPWorkQueueTypeName(pool.type));
+        for (int i = 0; i < pool.numThreads; i++) {
+            pool.workers.emplace_back(HTTPWorkQueueRun, pool.queue.get(),
+                                      pool.threadName, i);
+        }
     }
 }
 
@@ -475,21 +600,23 @@ void InterruptHTTPServer() {
         // Reject requests on current connections
         evhttp_set_gencb(eventHTTP, http_reject_request_cb, nullptr);
     }
-    if (workQueue) {
-        workQueue->Interrupt();
+    for (HTTPWorkerPool &pool : workerPools) {
+        if (pool.queue) {
+            pool.queue->Interrupt();
+        }
     }
 }
 
 void StopHTTPServer() {
     LogPrint(BCLog::HTTP, "Stopping HTTP server\n");
-    if (workQueue) {
+    if (!workerPools.empty()) {
         LogPrint(BCLog::HTTP, "Waiting for HTTP worker threads to exit\n");
-        for (auto &thread : g_thread_http_workers) {
-            thread.join();
+        for (HTTPWorkerPool &pool : workerPools) {
+            for (auto &thread : pool.workers) {
+                thread.join();
+            }
         }
-        g_thread_http_workers.clear();
-        delete workQueue;
-        workQueue = nullptr;
+        workerPools.clear();
     }
     // Unlisten sockets, these are what make the event loop running, which means
     // that after this and all connections are closed the event loop will quit.
@@ -518,6 +645,101 @@ struct event_base *EventBase() {
     return eventBase;
 }
 
+std::string HTTPWorkQueueTypeName(HTTPWorkQueueType type) {
+    switch (type) {
+        case HTTPWorkQueueType::RPC:
+            return "rpc";
+        case HTTPWorkQueueType::RPC_SLOW:
+            return "rpc_slow";
+        case HTTPWorkQueueType::REST:
+            return "rest";
+    }
+    assert(false);
+}
+
+namespace {
+/**
+ * Tasks shared between the thread calling RunOnHTTPWorkers and the helper
+ * workers. Each task is claimed by exactly one thread.
+ */
+struct SharedTasks {
+    //! Owned by the caller, only valid until all the tasks are completed
+    const std::vector<std::function<void()>> &tasks;
+    const size_t size;
+    std::atomic<size_t> next{0};
+
+    Mutex cs;
+    std::condition_variable cond;
+    size_t remaining GUARDED_BY(cs);
+
+    explicit SharedTasks(const std::vector<std::function<void()>> &_tasks)
+        : tasks(_tasks), size(_tasks.size()), remaining(_tasks.size()) {}
+
+    /** Run the unclaimed tasks until there is none left. */
+    void RunUnclaimed() EXCLUSIVE_LOCKS_REQUIRED(!cs) {
+        // A helper can start after all the tasks are completed, so the tasks
+        // vector must not be accessed before a task is claimed.
+        while (true) {
+            const size_t i = next++;
+            if (i >= size) {
+                return;
+            }
+
+            tasks[i]();
+
+            LOCK(cs);
+            if (--remaining == 0) {
+                cond.notify_all();
+            }
+        }
+    }
+};
+} // namespace
+
+void RunOnHTTPWorkers(HTTPWorkQueueType type,
+                      const std::vector<std::function<void()>> &tasks,
+                      size_t maxParallelism) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    auto shared = std::make_shared<SharedTasks>(tasks);
+
+    const size_t maxHelpers = std::min(maxParallelism, tasks.size()) - 1;
+    if (maxHelpers > 0 && size_t(type) < workerPools.size() &&
+        workerPools[size_t(type)].queue) {
+        workerPools[size_t(type)].queue->EnqueueForIdleWorkers(
+            maxHelpers, [&shared]() -> std::unique_ptr<HTTPClosure> {
+                return std::make_unique<HTTPTaskItem>(
+                    [shared]() { shared->RunUnclaimed(); });
+            });
+    }
+
+    // The calling thread processes the tasks as well, so they all get completed
+    // even if no helper is available or the helpers are not run because the
+    // server is shutting down.
+    shared->RunUnclaimed();
+
+    WAIT_LOCK(shared->cs, lock);
+    shared->cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(shared->cs) {
+        return shared->remaining == 0;
+    });
+}
+
+std::vector<HTTPWorkQueueStats> GetHTTPWorkQueueStats() {
+    std::vector<HTTPWorkQueueStats> result;
+    for (HTTPWorkerPool &pool : workerPools) {
+        HTTPWorkQueueStats stats;
+        stats.type = pool.type;
+        stats.threads = pool.numThreads;
+        if (pool.queue) {
+            pool.queue->GetStats(stats);
+        }
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
 static void httpevent_callback_fn(evutil_socket_t, short, void *data) {
     // Static handler: simply call inner handler
     HTTPEvent *self = static_cast<HTTPEvent *>(data);
@@ -548,6 +770,12 @@ void HTTPEvent::trigger(struct timeval *tv) {
 HTTPRequest::HTTPRequest(struct evhttp_request *_req, bool _replySent)
     : req(_req), replySent(_replySent) {}
 HTTPRequest::~HTTPRequest() {
+    if (chunkedReply) {
+        // The status is already sent, the best we can do is to complete the
+        // reply with what has been written so far.
+        LogPrintf("%s: Unterminated chunked reply\n", __func__);
+        EndChunkedReply();
+    }
     if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
@@ -592,6 +820,17 @@ std::string HTTPRequest::ReadBody() {
     return rv;
 }
 
+std::string HTTPRequest::PeekBody(size_t maxSize) const {
+    struct evbuffer *buf = evhttp_request_get_input_buffer(req);
+    if (!buf) {
+        return "";
+    }
+    std::string rv(std::min(evbuffer_get_length(buf), maxSize), '\0');
+    ev_ssize_t copied = evbuffer_copyout(buf, rv.data(), rv.size());
+    rv.resize(std::max<ev_ssize_t>(copied, 0));
+    return rv;
+}
+
 void HTTPRequest::WriteHeader(const std::string &hdr,
                               const std::string &value) {
     struct evkeyvalq *headers = evhttp_request_get_output_headers(req);
@@ -635,6 +874,140 @@ void HTTPRequest::WriteReply(int nStatus, const std::string &strReply) {
     req = nullptr;
 }
 
+struct HTTPRequest::ChunkedReplyState {
+    Mutex cs;
+    std::condition_variable cond;
+    //! Number of bytes written by the worker thread
+    uint64_t written GUARDED_BY(cs){0};
+    //! Number of bytes flushed to the socket by the event loop thread
+    uint64_t flushed GUARDED_BY(cs){0};
+    //! Whether the client closed the connection
+    bool closed GUARDED_BY(cs){false};
+
+    //! Only accessed from the event loop thread
+    uint64_t handedToLibevent{0};
+
+    void SetFlushed(uint64_t size) EXCLUSIVE_LOCKS_REQUIRED(!cs) {
+        LOCK(cs);
+        flushed = size;
+        cond.notify_all();
+    }
+
+    void SetClosed() EXCLUSIVE_LOCKS_REQUIRED(!cs) {
+        LOCK(cs);
+        closed = true;
+        cond.notify_all();
+    }
+};
+
+#if LIBEVENT_VERSION_NUMBER >= 0x02010100
+/** Called by libevent once the output buffer is flushed to the socket */
+static void http_reply_chunk_flushed_cb(struct evhttp_connection *,
+                                        void *arg) {
+    auto *state = static_cast<HTTPRequest::ChunkedReplyState *>(arg);
+    state->SetFlushed(state->handedToLibevent);
+}
+#endif
+
+/** Called by libevent when the client closes the connection */
+static void http_reply_connection_closed_cb(struct evhttp_connection *,
+                                            void *arg) {
+    static_cast<HTTPRequest::ChunkedReplyState *>(arg)->SetClosed();
+}
+
+void HTTPRequest::StartChunkedReply(int nStatus) {
+    assert(!replySent && !chunkedReply && req);
+    if (ShutdownRequested()) {
+        WriteHeader("Connection", "close");
+    }
+
+    chunkedReply = std::make_shared<ChunkedReplyState>();
+    auto req_copy = req;
+    auto state = chunkedReply;
+    HTTPEvent *ev = new HTTPEvent(eventBase, true, [req_copy, nStatus, state] {
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+        evhttp_connection *conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(
+                conn, http_reply_connection_closed_cb, state.get());
+        } else {
+            state->SetClosed();
+        }
+    });
+    ev->trigger(nullptr);
+}
+
+void HTTPRequest::WriteReplyChunk(const std::string &chunk) {
+    assert(!replySent && chunkedReply && req);
+    if (chunk.empty()) {
+        return;
+    }
+
+    WITH_LOCK(chunkedReply->cs, chunkedReply->written += chunk.size());
+
+    struct evbuffer *evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, chunk.data(), chunk.size());
+    auto req_copy = req;
+    auto state = chunkedReply;
+    const uint64_t size = chunk.size();
+    HTTPEvent *ev = new HTTPEvent(eventBase, true, [req_copy, evb, state,
+                                                    size] {
+        state->handedToLibevent += size;
+#if LIBEVENT_VERSION_NUMBER >= 0x02010100
+        evhttp_send_reply_chunk_with_cb(req_copy, evb,
+                                        http_reply_chunk_flushed_cb,
+                                        state.get());
+#else
+        evhttp_send_reply_chunk(req_copy, evb);
+        state->SetFlushed(state->handedToLibevent);
+#endif
+        evbuffer_free(evb);
+    });
+    ev->trigger(nullptr);
+}
+
+bool HTTPRequest::WaitForPendingReplyChunks(size_t maxPendingSize) {
+    assert(!replySent && chunkedReply && req);
+    WAIT_LOCK(chunkedReply->cs, lock);
+    chunkedReply->cond.wait(
+        lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(chunkedReply->cs) {
+            return chunkedReply->closed ||
+                   chunkedReply->written - chunkedReply->flushed <=
+                       maxPendingSize;
+        });
+    return !chunkedReply->closed;
+}
+
+void HTTPRequest::EndChunkedReply() {
+    assert(!replySent && chunkedReply && req);
+    auto req_copy = req;
+    // Keep the state alive until the callbacks are unregistered
+    auto state = chunkedReply;
+    HTTPEvent *ev = new HTTPEvent(eventBase, true, [req_copy, state] {
+        evhttp_connection *conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, nullptr, nullptr);
+        }
+        // This frees the request if the connection is already closed.
+        evhttp_send_reply_end(req_copy);
+        // Re-enable reading from the socket. This is the second part of the
+        // libevent workaround in http_request_cb.
+        if (conn && event_get_version_number() >= 0x02010600 &&
+            event_get_version_number() < 0x02020001) {
+            bufferevent *bev = evhttp_connection_get_bufferevent(conn);
+            if (bev) {
+                bufferevent_enable(bev, EV_READ | EV_WRITE);
+            }
+        }
+    });
+    ev->trigger(nullptr);
+    chunkedReply.reset();
+    replySent = true;
+    // transferred back to main thread.
+    req = nullptr;
+}
+
 CService HTTPRequest::GetPeer() const {
     evhttp_connection *con = evhttp_request_get_connection(req);
     CService peer;
@@ -670,10 +1043,12 @@ HTTPRequest::RequestMethod HTTPRequest::GetRequestMethod() const {
 }
 
 void RegisterHTTPHandler(const std::string &prefix, bool exactMatch,
-                         const HTTPRequestHandler &handler) {
+                         const HTTPRequestHandler &handler,
+                         const HTTPWorkQueueSelector &selector) {
     LogPrint(BCLog::HTTP, "Registering HTTP handler for %s (exactmatch %d)\n",
              prefix, exactMatch);
-    pathHandlers.push_back(HTTPPathHandler(prefix, exactMatch, handler));
+    pathHandlers.push_back(
+        HTTPPathHandler(prefix, exactMatch, handler, selector));
 }
 
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch) {
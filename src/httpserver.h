@@ -6,13 +6,77 @@
 #ifndef BITCOIN_HTTPSERVER_H
 #define BITCOIN_HTTPSERVER_H
 
+#include <util/histogram.h>
+
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 static const int DEFAULT_HTTP_THREADS = 4;
 static const int DEFAULT_HTTP_WORKQUEUE = 16;
+static const int DEFAULT_HTTP_SLOW_THREADS = 2;
+static const int DEFAULT_HTTP_SLOW_WORKQUEUE = 16;
+static const int DEFAULT_HTTP_REST_THREADS = 2;
+static const int DEFAULT_HTTP_REST_WORKQUEUE = 16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT = 30;
 
+/**
+ * Maximum number of bytes of a chunked reply that can be waiting to be sent to
+ * the client before the worker thread producing the reply is paused.
+ */
+static const size_t MAX_HTTP_PENDING_REPLY_CHUNKS_SIZE = 4 * 1024 * 1024;
+
+/**
+ * The HTTP requests are dispatched to one of these work queues, each one being
+ * served by its own pool of worker threads. This prevents the expensive
+ * requests from starving the cheap ones.
+ */
+enum class HTTPWorkQueueType {
+    //! JSON-RPC requests (-rpcthreads, -rpcworkqueue)
+    RPC,
+    //! JSON-RPC requests for known expensive methods (-rpcslowthreads,
+    //! -rpcslowworkqueue)
+    RPC_SLOW,
+    //! REST requests (-restthreads, -restworkqueue)
+    REST,
+};
+
+/** Name of the work queue type, e.g. for use in the RPC interface */
+std::string HTTPWorkQueueTypeName(HTTPWorkQueueType type);
+
+/** Snapshot of a work queue statistics */
+struct HTTPWorkQueueStats {
+    HTTPWorkQueueType type;
+    //! Number of worker threads serving the queue
+    int threads{0};
+    //! Current number of requests waiting in the queue
+    size_t depth{0};
+    //! Maximum number of requests that can wait in the queue
+    size_t max_depth{0};
+    //! Number of processed requests
+    uint64_t processed{0};
+    //! Number of requests rejected because the queue was full
+    uint64_t rejected{0};
+    //! Time spent waiting in the queue, in microseconds
+    Log2Histogram queue_time;
+    //! Time spent by the worker thread handling the request, in microseconds
+    Log2Histogram run_time;
+};
+
+/**
+ * Run independent tasks in parallel using the calling thread and up to
+ * maxParallelism - 1 idle worker threads from the given work queue. Returns
+ * once all the tasks are completed. The tasks must not throw.
+ */
+void RunOnHTTPWorkers(HTTPWorkQueueType type,
+                      const std::vector<std::function<void()>> &tasks,
+                      size_t maxParallelism);
+
+/** Return the statistics for all the work queues. */
+std::vector<HTTPWorkQueueStats> GetHTTPWorkQueueStats();
+
 struct evhttp_request;
 struct event_base;
 
@@ -50,13 +114,23 @@ typedef std::function<bool(Config &config, HTTPRequest *req,
                            const std::string &)>
     HTTPRequestHandler;
 
+/**
+ * Select the work queue a request should be dispatched to. This is called from
+ * the HTTP event loop thread and must be cheap.
+ */
+typedef std::function<HTTPWorkQueueType(HTTPRequest *req)>
+    HTTPWorkQueueSelector;
+
 /**
  * Register handler for prefix.
  * If multiple handlers match a prefix, the first-registered one will
  * be invoked.
+ * If no queue selector is provided, the requests are dispatched to the RPC work
+ * queue.
  */
 void RegisterHTTPHandler(const std::string &prefix, bool exactMatch,
-                         const HTTPRequestHandler &handler);
+                         const HTTPRequestHandler &handler,
+                         const HTTPWorkQueueSelector &selector = nullptr);
 
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
@@ -76,6 +150,13 @@ private:
     struct evhttp_request *req;
     bool replySent;
 
+public:
+    /** State of a chunked reply, shared with the event loop thread */
+    struct ChunkedReplyState;
+
+private:
+    std::shared_ptr<ChunkedReplyState> chunkedReply;
+
 public:
     explicit HTTPRequest(struct evhttp_request *req, bool replySent = false);
     ~HTTPRequest();
@@ -105,6 +186,12 @@ public:
      */
     std::string ReadBody();
 
+    /**
+     * Copy up to maxSize bytes from the start of the request body without
+     * consuming it.
+     */
+    std::string PeekBody(size_t maxSize) const;
+
     /**
      * Write output header.
      *
@@ -123,6 +210,34 @@ public:
      * this.
      */
     void WriteReply(int nStatus, const std::string &strReply = "");
+
+    /**
+     * Start a chunked HTTP reply, so the body can be sent incrementally while
+     * it is produced with WriteReplyChunk. The reply must then be completed
+     * with EndChunkedReply.
+     *
+     * @note call this instead of WriteReply, after the headers are written.
+     */
+    void StartChunkedReply(int nStatus);
+
+    /** Send a chunk of the reply body. This never blocks. */
+    void WriteReplyChunk(const std::string &chunk);
+
+    /**
+     * Wait until no more than maxPendingSize bytes of the previously written
+     * chunks are waiting to be sent to the client. Returns false if the client
+     * closed the connection, in which case the following chunks are dropped.
+     */
+    bool WaitForPendingReplyChunks(
+        size_t maxPendingSize = MAX_HTTP_PENDING_REPLY_CHUNKS_SIZE);
+
+    /**
+     * Complete a chunked HTTP reply.
+     *
+     * @note As this will give the request back to the main thread, do not call
+     * any other HTTPRequest methods after calling this.
+     */
+    void EndChunkedReply();
 };
 
 /** Event handler closure */
@@ -82,6 +82,7 @@
 #if ENABLE_ZMQ
 #include <zmq/zmqabstractnotifier.h>
 #include <zmq/zmqnotificationinterface.h>
+#include <zmq/zmqpublisher.h>
 #include <zmq/zmqrpc.h>
 #endif
 
@@ -276,6 +277,15 @@ void Shutdown(NodeContext &node) {
         DumpMempool(*node.mempool);
     }
 
+    // The caches are only worth saving once the mempool they were filled by
+    // has been loaded.
+    if (node.mempool && node.mempool->IsLoaded() &&
+        node.args->GetBoolArg("-persistsigcache", DEFAULT_PERSIST_SIGCACHE)) {
+        DumpSignatureCache(node.args->GetDataDirNet() / "sigcache.dat");
+        DumpScriptExecutionCache(node.args->GetDataDirNet() /
+                                 "scriptcache.dat");
+    }
+
     // FlushStateToDisk generates a ChainStateFlushed callback, which we should
     // avoid missing
     if (node.chainman) {
@@ -514,6 +524,13 @@ void SetupServerArgs(NodeContext &node) {
         strprintf("Set database cache size in MiB (%d to %d, default: %d)",
                   MIN_DB_CACHE_MB, MAX_DB_CACHE_MB, DEFAULT_DB_CACHE_MB),
         ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg(
+        "-dbwritethreads=<n>",
+        strprintf("Number of threads writing the large flushes of the coins "
+                  "database (0 to %d, 0 = one per core, default: %d)",
+                  MAX_DB_WRITE_THREADS, DEFAULT_DB_WRITE_THREADS),
+        ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY,
+        OptionsCategory::OPTIONS);
     argsman.AddArg(
         "-includeconf=<file>",
         "Specify additional configuration file, relative to the -datadir path "
@@ -558,6 +575,12 @@ void SetupServerArgs(NodeContext &node) {
                              "on restart (default: %u)",
                              DEFAULT_PERSIST_MEMPOOL),
                    ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-persistsigcache",
+                   strprintf("Whether to save the signature and script "
+                             "execution caches on shutdown and load them on "
+                             "restart (default: %u)",
+                             DEFAULT_PERSIST_SIGCACHE),
+                   ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg(
         "-pid=<file>",
         strprintf("Specify pid file. Relative paths will be prefixed "
@@ -953,6 +976,12 @@ void SetupServerArgs(NodeContext &node) {
                              " (default: %d)",
                              CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM),
                    ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg(
+        "-zmqqueuesize=<n>",
+        strprintf("Maximum number of messages waiting to be published, the "
+                  "new messages are dropped when it is reached (default: %u)",
+                  CZMQPublisher::DEFAULT_ZMQ_QUEUE_SIZE),
+        ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     hidden_args.emplace_back("-zmqpubhashblock=<address>");
     hidden_args.emplace_back("-zmqpubhashtx=<address>");
@@ -964,6 +993,7 @@ void SetupServerArgs(NodeContext &node) {
     hidden_args.emplace_back("-zmqpubrawblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
+    hidden_args.emplace_back("-zmqqueuesize=<n>");
 #endif
 
     argsman.AddArg(
@@ -1244,6 +1274,48 @@ void SetupServerArgs(NodeContext &node) {
                              DEFAULT_HTTP_WORKQUEUE),
                    ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY,
                    OptionsCategory::RPC);
+    argsman.AddArg(
+        "-rpcslowthreads=<n>",
+        strprintf("Set the number of threads to service the RPC calls to the "
+                  "methods selected by -rpcslowmethod and the batches "
+                  "(default: %d)",
+                  DEFAULT_HTTP_SLOW_THREADS),
+        ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-rpcslowworkqueue=<n>",
+                   strprintf("Set the depth of the work queue to service the "
+                             "RPC calls selected by -rpcslowmethod and the "
+                             "batches (default: %d)",
+                             DEFAULT_HTTP_SLOW_WORKQUEUE),
+                   ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY,
+                   OptionsCategory::RPC);
+    argsman.AddArg(
+        "-rpcslowmethod=<method>",
+        strprintf("Service the calls to this RPC method with the slow RPC "
+                  "threads, so they don't delay the other calls. This option "
+                  "can be specified multiple times and overrides the default "
+                  "list (default: %s)",
+                  Join(DEFAULT_RPC_SLOW_METHODS, ", ")),
+        ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg(
+        "-rpcbatchparallelism=<n>",
+        strprintf("Set the maximum number of threads executing the calls of a "
+                  "JSON-RPC batch concurrently. The calling thread is helped "
+                  "by the idle slow RPC threads (see -rpcslowthreads). Set to "
+                  "1 to execute the calls sequentially (default: %d)",
+                  DEFAULT_RPC_BATCH_PARALLELISM),
+        ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg(
+        "-restthreads=<n>",
+        strprintf(
+            "Set the number of threads to service REST requests (default: %d)",
+            DEFAULT_HTTP_REST_THREADS),
+        ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-restworkqueue=<n>",
+                   strprintf("Set the depth of the work queue to service REST "
+                             "requests (default: %d)",
+                             DEFAULT_HTTP_REST_WORKQUEUE),
+                   ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY,
+                   OptionsCategory::RPC);
     argsman.AddArg("-rpcservertimeout=<n>",
                    strprintf("Timeout during HTTP requests (default: %d)",
                              DEFAULT_HTTP_SERVER_TIMEOUT),
@@ -1362,6 +1434,24 @@ void SetupServerArgs(NodeContext &node) {
             "%u).",
             DEFAULT_MAX_AVALANCHE_OUTBOUND_CONNECTIONS),
         ArgsManager::ALLOW_INT, OptionsCategory::AVALANCHE);
+    argsman.AddArg(
+        "-avalatencylogperiod=<n>",
+        strprintf("Log a summary of the avalanche latencies every <n> seconds, "
+                  "0 to disable (default: %u)",
+                  AVALANCHE_DEFAULT_LATENCY_LOG_PERIOD.count()),
+        ArgsManager::ALLOW_ANY, OptionsCategory::AVALANCHE);
+    argsman.AddArg(
+        "-avamempoolsync",
+        strprintf("Periodically send a sketch of the mempool to the avalanche "
+                  "peers to fetch the transactions that either side is "
+                  "missing (default: %u)",
+                  AVALANCHE_DEFAULT_MEMPOOL_SYNC),
+        ArgsManager::ALLOW_ANY, OptionsCategory::AVALANCHE);
+    argsman.AddArg("-persistavapeers",
+                   strprintf("Whether to save the avalanche peers on shutdown "
+                             "and load them on restart (default: %u)",
+                             AVALANCHE_DEFAULT_PERSIST_PEERS),
+                   ArgsManager::ALLOW_ANY, OptionsCategory::AVALANCHE);
 
     hidden_args.emplace_back("-avalanchepreconsensus");
 
@@ -2120,6 +2210,10 @@ bool AppInitMain(Config &config, RPCServer &rpcServer,
 
     InitSignatureCache();
     InitScriptExecutionCache();
+    if (args.GetBoolArg("-persistsigcache", DEFAULT_PERSIST_SIGCACHE)) {
+        LoadSignatureCache(args.GetDataDirNet() / "sigcache.dat");
+        LoadScriptExecutionCache(args.GetDataDirNet() / "scriptcache.dat");
+    }
 
     int script_threads = args.GetIntArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
     if (script_threads <= 0) {
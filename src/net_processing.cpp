@@ -8,6 +8,7 @@
 #include <addrman.h>
 #include <avalanche/avalanche.h>
 #include <avalanche/compactproofs.h>
+#include <avalanche/mempoolsketch.h>
 #include <avalanche/peermanager.h>
 #include <avalanche/processor.h>
 #include <avalanche/proof.h>
@@ -51,7 +52,9 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <typeinfo>
+#include <unordered_set>
 
 using node::fImporting;
 using node::fPruneMode;
@@ -116,6 +119,20 @@ static constexpr auto GETAVAADDR_INTERVAL{2min};
  */
 static constexpr auto AVALANCHE_AVAPROOFS_TIMEOUT{2min};
 
+/** Average delay between 2 mempool sketches sent to the same avalanche peer */
+static constexpr auto AVALANCHE_MEMPOOL_SKETCH_INTERVAL{30s};
+/**
+ * Minimum time between 2 mempool sketches from the same peer, so it can't make
+ * us compute them over our whole mempool in a loop.
+ */
+static constexpr auto AVALANCHE_MEMPOOL_SKETCH_MIN_INTERVAL{10s};
+/**
+ * Number of transactions a mempool sketch can recover when the difference with
+ * the peer's mempool is unknown. The capacity is then adapted to the size of
+ * the previous differences.
+ */
+static constexpr size_t AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY{64};
+
 struct DataRequestParameters {
     /**
      * Maximum number of in-flight data requests from a peer. It is not a hard
@@ -460,6 +477,21 @@ struct Peer {
     /** Work queue of items requested by this peer **/
     std::deque<CInv> m_getdata_requests GUARDED_BY(m_getdata_requests_mutex);
 
+    /** Protects the mempool sketch data members */
+    Mutex m_mempool_sketch_mutex;
+    /** The mempool sketch we sent to this peer, until it responds */
+    std::optional<avalanche::MempoolSketch>
+        m_mempool_sketch_sent GUARDED_BY(m_mempool_sketch_mutex);
+    /** Number of transactions the next sketch we send can recover */
+    size_t m_mempool_sketch_capacity GUARDED_BY(m_mempool_sketch_mutex){
+        AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY};
+    /** When to send the next mempool sketch to this peer */
+    std::chrono::microseconds
+        m_next_mempool_sketch GUARDED_BY(m_mempool_sketch_mutex){0};
+    /** When this peer last sent us a mempool sketch */
+    std::chrono::microseconds
+        m_last_mempool_sketch_recv GUARDED_BY(m_mempool_sketch_mutex){0};
+
     explicit Peer(NodeId id) : m_id(id) {}
 };
 
@@ -648,6 +680,25 @@ private:
     void MaybeSendFeefilter(CNode &node,
                             std::chrono::microseconds current_time);
 
+    /**
+     * Send `avasketch` messages to our outbound avalanche peers on a regular
+     * schedule, so we can both fetch the transactions we are missing before
+     * they get mined.
+     */
+    void MaybeSendMempoolSketch(CNode &node, Peer &peer,
+                                std::chrono::microseconds current_time);
+
+    /** Add all the transactions from our mempool to the sketch */
+    void AddMempoolToSketch(avalanche::MempoolSketch &sketch);
+
+    /**
+     * Announce to the peer the transactions from our mempool which short ids
+     * are in the list.
+     */
+    void AnnounceSketchTransactions(CNode &node,
+                                    const avalanche::MempoolSketch &sketch,
+                                    const std::vector<uint64_t> &shortids);
+
     /**
      * Relay (gossip) an address to a few randomly chosen nodes.
      *
@@ -684,6 +735,9 @@ private:
     /** Whether this node is running in blocks only mode */
     const bool m_ignore_incoming_txs;
 
+    /** Whether we send mempool sketches to our avalanche peers */
+    const bool m_avalanche_mempool_sync;
+
     /**
      * Whether we've completed initial sync yet, for determining when to turn
      * on extra block-relay-only peers.
@@ -2145,7 +2199,9 @@ PeerManagerImpl::PeerManagerImpl(const CChainParams &chainparams,
                                  CTxMemPool &pool, bool ignore_incoming_txs)
     : m_chainparams(chainparams), m_connman(connman), m_addrman(addrman),
       m_banman(banman), m_chainman(chainman), m_mempool(pool),
-      m_ignore_incoming_txs(ignore_incoming_txs) {
+      m_ignore_incoming_txs(ignore_incoming_txs),
+      m_avalanche_mempool_sync(gArgs.GetBoolArg(
+          "-avamempoolsync", AVALANCHE_DEFAULT_MEMPOOL_SYNC)) {
     {
         LOCK(cs_invalidProofs);
         invalidProofs = std::make_unique<CRollingBloomFilter>(100000, 0.000001);
@@ -3372,7 +3428,9 @@ bool IsAvalancheMessageType(const std::string &msg_type) {
            msg_type == NetMsgType::GETAVAADDR ||
            msg_type == NetMsgType::GETAVAPROOFS ||
            msg_type == NetMsgType::AVAPROOFS ||
-           msg_type == NetMsgType::AVAPROOFSREQ;
+           msg_type == NetMsgType::AVAPROOFSREQ ||
+           msg_type == NetMsgType::AVASKETCH ||
+           msg_type == NetMsgType::AVADIFF;
 }
 
 uint32_t
@@ -5353,9 +5411,22 @@ void PeerManagerImpl::ProcessMessage(
             return;
         }
 
-        // If there are prefilled proofs, process them first
+        // If there are prefilled proofs, process them first. Their signatures
+        // are checked all at once beforehand so the work is spread over
+        // several threads.
+        const auto &prefilledProofs = compactProofs.getPrefilledProofs();
+        if (prefilledProofs.size() > 1 &&
+            !m_chainman.ActiveChainstate().IsInitialBlockDownload()) {
+            std::vector<avalanche::ProofRef> proofs;
+            proofs.reserve(prefilledProofs.size());
+            for (const auto &prefilledProof : prefilledProofs) {
+                proofs.push_back(prefilledProof.proof);
+            }
+            avalanche::VerifyProofSignatures(proofs);
+        }
+
         std::set<uint32_t> prefilledIndexes;
-        for (const auto &prefilledProof : compactProofs.getPrefilledProofs()) {
+        for (const auto &prefilledProof : prefilledProofs) {
             if (!ReceivedAvalancheProof(pfrom, prefilledProof.proof)) {
                 // If we got an invalid proof, the peer is getting banned and we
                 // can bail out.
@@ -5468,6 +5539,94 @@ void PeerManagerImpl::ProcessMessage(
         return;
     }
 
+    if (msg_type == NetMsgType::AVASKETCH) {
+        if (!pfrom.m_avalanche_enabled || !pfrom.m_tx_relay ||
+            m_ignore_incoming_txs) {
+            return;
+        }
+
+        avalanche::MempoolSketch theirSketch;
+        try {
+            vRecv >> theirSketch;
+        } catch (std::ios_base::failure &e) {
+            Misbehaving(pfrom, 100, "avasketch-bad-size");
+            return;
+        }
+
+        const auto now = GetTime<std::chrono::microseconds>();
+        {
+            LOCK(peer->m_mempool_sketch_mutex);
+            if (now < peer->m_last_mempool_sketch_recv +
+                          AVALANCHE_MEMPOOL_SKETCH_MIN_INTERVAL) {
+                LogPrint(BCLog::AVALANCHE,
+                         "Ignoring avasketch sent too early (peer %d)\n",
+                         pfrom.GetId());
+                return;
+            }
+            peer->m_last_mempool_sketch_recv = now;
+        }
+
+        // Our mempool is not worth reconciling until we are synced
+        if (m_chainman.ActiveChainstate().IsInitialBlockDownload()) {
+            return;
+        }
+
+        avalanche::MempoolSketch ourSketch = theirSketch.emptyCopy();
+        AddMempoolToSketch(ourSketch);
+
+        avalanche::MempoolSketchDiff diff;
+        std::vector<uint64_t> onlyOurs;
+        diff.decoded = ourSketch.diff(theirSketch, onlyOurs, diff.shortids);
+        if (diff.decoded) {
+            diff.differenceSize = onlyOurs.size() + diff.shortids.size();
+            AnnounceSketchTransactions(pfrom, ourSketch, onlyOurs);
+        } else {
+            diff.shortids.clear();
+        }
+
+        LogPrint(BCLog::AVALANCHE,
+                 "Reconciled the mempool with peer %d: %s, %u missing "
+                 "transactions on our side, %u on theirs\n",
+                 pfrom.GetId(), diff.decoded ? "success" : "failure",
+                 diff.shortids.size(), onlyOurs.size());
+        m_connman.PushMessage(&pfrom,
+                              msgMaker.Make(NetMsgType::AVADIFF, diff));
+        return;
+    }
+
+    if (msg_type == NetMsgType::AVADIFF) {
+        avalanche::MempoolSketchDiff diff;
+        vRecv >> diff;
+
+        std::optional<avalanche::MempoolSketch> sketch;
+        {
+            LOCK(peer->m_mempool_sketch_mutex);
+            if (!peer->m_mempool_sketch_sent) {
+                LogPrint(BCLog::AVALANCHE, "Ignoring unsolicited avadiff\n");
+                return;
+            }
+            sketch.swap(peer->m_mempool_sketch_sent);
+
+            // Leave room for the difference to grow until the next sketch, or
+            // double the capacity if it was too small.
+            size_t &capacity = peer->m_mempool_sketch_capacity;
+            capacity = diff.decoded ? 2 * size_t(diff.differenceSize)
+                                    : 2 * capacity;
+            capacity =
+                std::clamp(capacity, AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY,
+                           avalanche::MAX_MEMPOOL_SKETCH_CAPACITY);
+        }
+
+        // The peer can't be missing more transactions than the sketch can
+        // recover.
+        if (diff.decoded &&
+            diff.shortids.size() <= sketch->getSketch().getCellCount()) {
+            AnnounceSketchTransactions(pfrom, *sketch, diff.shortids);
+        }
+
+        return;
+    }
+
     if (msg_type == NetMsgType::GETADDR) {
         // This asymmetric behavior for inbound and outbound connections was
         // introduced to prevent a fingerprinting attack: an attacker can send
@@ -6461,6 +6620,77 @@ void PeerManagerImpl::MaybeSendFeefilter(
     }
 }
 
+void PeerManagerImpl::MaybeSendMempoolSketch(
+    CNode &node, Peer &peer, std::chrono::microseconds current_time) {
+    if (!m_avalanche_mempool_sync || m_ignore_incoming_txs) {
+        return;
+    }
+    if (!node.m_avalanche_enabled || node.IsInboundConn() || !node.m_tx_relay) {
+        return;
+    }
+    // Our mempool is not worth reconciling until we are synced
+    if (m_chainman.ActiveChainstate().IsInitialBlockDownload()) {
+        return;
+    }
+
+    LOCK(peer.m_mempool_sketch_mutex);
+    if (current_time < peer.m_next_mempool_sketch) {
+        return;
+    }
+    peer.m_next_mempool_sketch =
+        PoissonNextSend(current_time, AVALANCHE_MEMPOOL_SKETCH_INTERVAL);
+
+    // If the peer didn't respond to the previous sketch it is dropped, the
+    // response would be outdated anyway.
+    avalanche::MempoolSketch sketch(peer.m_mempool_sketch_capacity);
+    AddMempoolToSketch(sketch);
+
+    LogPrint(BCLog::AVALANCHE,
+             "Sending a mempool sketch of %u cells to peer %d\n",
+             sketch.getSketch().getCellCount(), node.GetId());
+    m_connman.PushMessage(&node, CNetMsgMaker(node.GetCommonVersion())
+                                     .Make(NetMsgType::AVASKETCH, sketch));
+    peer.m_mempool_sketch_sent = std::move(sketch);
+}
+
+void PeerManagerImpl::AddMempoolToSketch(avalanche::MempoolSketch &sketch) {
+    LOCK(m_mempool.cs);
+    for (const CTxMemPoolEntry &entry : m_mempool.mapTx) {
+        sketch.addTx(entry.GetTx().GetId());
+    }
+}
+
+void PeerManagerImpl::AnnounceSketchTransactions(
+    CNode &node, const avalanche::MempoolSketch &sketch,
+    const std::vector<uint64_t> &shortids) {
+    if (shortids.empty() || !node.m_tx_relay) {
+        return;
+    }
+
+    const std::unordered_set<uint64_t> shortidSet(shortids.begin(),
+                                                  shortids.end());
+    std::vector<TxId> txids;
+    {
+        LOCK(m_mempool.cs);
+        for (const CTxMemPoolEntry &entry : m_mempool.mapTx) {
+            const TxId &txid = entry.GetTx().GetId();
+            if (shortidSet.count(sketch.getShortID(txid))) {
+                txids.push_back(txid);
+            }
+
+            if (txids.size() == shortidSet.size()) {
+                break;
+            }
+        }
+    }
+
+    // The transactions go through the regular trickling, which applies the
+    // peer's filters.
+    for (const TxId &txid : txids) {
+        node.PushTxInventory(txid);
+    }
+}
+
 namespace {
 class CompareInvMempoolOrder {
     CTxMemPool *mp;
@@ -7173,6 +7403,7 @@ bool PeerManagerImpl::SendMessages(const Config &config, CNode *pto) {
 
     } // release cs_main
     MaybeSendFeefilter(*pto, current_time);
+    MaybeSendMempoolSketch(*pto, *peer, current_time);
     return true;
 }
 
@@ -13,9 +13,14 @@
 #include <serialize.h>
 #include <util/check.h>
 #include <util/system.h>
+#include <util/threadnames.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <future>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace node {
 uint64_t GetBogoSize(const CScript &script_pub_key) {
@@ -70,8 +75,7 @@ static void ApplyHash(MuHash3072 &muhash, const TxId &txid,
                       const std::map<uint32_t, Coin> &outputs) {
     for (auto it = outputs.begin(); it != outputs.end(); ++it) {
         COutPoint outpoint = COutPoint(txid, it->first);
-        Coin coin = it->second;
-        muhash.Insert(MakeUCharSpan(TxOutSer(outpoint, coin)));
+        muhash.Insert(MakeUCharSpan(TxOutSer(outpoint, it->second)));
     }
 }
 
@@ -86,14 +90,112 @@ static void ApplyStats(CCoinsStats &stats, const TxId &txid,
     }
 }
 
+//! Apply the statistics and hash of all the coins of a cursor
+template <typename T>
+static bool ApplyCoins(CCoinsViewCursor &cursor, CCoinsStats &stats,
+                       T &hash_obj,
+                       const std::function<void()> &interruption_point) {
+    TxId prevkey;
+    std::map<uint32_t, Coin> outputs;
+    while (cursor.Valid()) {
+        interruption_point();
+        COutPoint key;
+        Coin coin;
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
+            if (!outputs.empty() && key.GetTxId() != prevkey) {
+                ApplyStats(stats, prevkey, outputs);
+                ApplyHash(hash_obj, prevkey, outputs);
+                outputs.clear();
+            }
+            prevkey = key.GetTxId();
+            outputs[key.GetN()] = std::move(coin);
+            stats.coins_count++;
+        } else {
+            return error("%s: unable to read value", __func__);
+        }
+        cursor.Next();
+    }
+    if (!outputs.empty()) {
+        ApplyStats(stats, prevkey, outputs);
+        ApplyHash(hash_obj, prevkey, outputs);
+    }
+    return true;
+}
+
+using CoinsCursors = std::vector<std::unique_ptr<CCoinsViewCursor>>;
+
+//! The legacy hash depends on the order of the coins, so they are hashed
+//! sequentially.
+static CoinsCursors GetCursors(CCoinsView *view, const CHashWriter &ss) {
+    CoinsCursors cursors;
+    cursors.emplace_back(view->Cursor());
+    return cursors;
+}
+static bool ApplyAllCoins(const CoinsCursors &cursors, CCoinsStats &stats,
+                          CHashWriter &ss,
+                          const std::function<void()> &interruption_point) {
+    for (const auto &cursor : cursors) {
+        assert(cursor);
+        if (!ApplyCoins(*cursor, stats, ss, interruption_point)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! MuHash is commutative, so ranges of the coins are hashed in parallel and
+//! the partial products are combined.
+template <typename T>
+static CoinsCursors GetCursors(CCoinsView *view, const T &hash_obj) {
+    return view->RangeCursors(
+        std::clamp(GetNumCores(), 1, MAX_UTXO_STATS_THREADS));
+}
+
+static void CombineHash(MuHash3072 &muhash, const MuHash3072 &partial) {
+    muhash *= partial;
+}
+static void CombineHash(std::nullptr_t, std::nullptr_t) {}
+
+template <typename T>
+static bool ApplyAllCoins(const CoinsCursors &cursors, CCoinsStats &stats,
+                          T &hash_obj,
+                          const std::function<void()> &interruption_point) {
+    std::vector<CCoinsStats> partial_stats(cursors.size(),
+                                           CCoinsStats(stats.m_hash_type));
+    std::vector<T> partial_hashes(cursors.size());
+    // Declared last so the destructors wait for all the tasks to complete,
+    // even if one of them throws.
+    std::vector<std::future<bool>> results;
+    for (size_t i = 0; i < cursors.size(); ++i) {
+        assert(cursors[i]);
+        results.push_back(std::async(std::launch::async, [&, i] {
+            util::ThreadRename(strprintf("utxostats.%i", i));
+            return ApplyCoins(*cursors[i], partial_stats[i],
+                              partial_hashes[i], interruption_point);
+        }));
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < cursors.size(); ++i) {
+        success &= results[i].get();
+
+        stats.nTransactions += partial_stats[i].nTransactions;
+        stats.nTransactionOutputs += partial_stats[i].nTransactionOutputs;
+        stats.nTotalAmount += partial_stats[i].nTotalAmount;
+        stats.nBogoSize += partial_stats[i].nBogoSize;
+        stats.coins_count += partial_stats[i].coins_count;
+        CombineHash(hash_obj, partial_hashes[i]);
+    }
+    return success;
+}
+
 //! Calculate statistics about the unspent transaction output set
 template <typename T>
 static bool GetUTXOStats(CCoinsView *view, BlockManager &blockman,
                          CCoinsStats &stats, T hash_obj,
                          const std::function<void()> &interruption_point,
                          const CBlockIndex *pindex) {
-    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
-    assert(pcursor);
+    const CoinsCursors cursors = GetCursors(view, hash_obj);
 
     if (!pindex) {
         LOCK(cs_main);
@@ -113,29 +215,8 @@ static bool GetUTXOStats(CCoinsView *view, BlockManager &blockman,
 
     PrepareHash(hash_obj, stats);
 
-    TxId prevkey;
-    std::map<uint32_t, Coin> outputs;
-    while (pcursor->Valid()) {
-        interruption_point();
-        COutPoint key;
-        Coin coin;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            if (!outputs.empty() && key.GetTxId() != prevkey) {
-                ApplyStats(stats, prevkey, outputs);
-                ApplyHash(hash_obj, prevkey, outputs);
-                outputs.clear();
-            }
-            prevkey = key.GetTxId();
-            outputs[key.GetN()] = std::move(coin);
-            stats.coins_count++;
-        } else {
-            return error("%s: unable to read value", __func__);
-        }
-        pcursor->Next();
-    }
-    if (!outputs.empty()) {
-        ApplyStats(stats, prevkey, outputs);
-        ApplyHash(hash_obj, prevkey, outputs);
+    if (!ApplyAllCoins(cursors, stats, hash_obj, interruption_point)) {
+        return false;
     }
 
     FinalizeHash(hash_obj, stats);
@@ -22,6 +22,9 @@ class BlockManager;
 } // namespace node
 
 namespace node {
+//! Maximum number of threads hashing the UTXO set in parallel
+static constexpr int MAX_UTXO_STATS_THREADS = 16;
+
 enum class CoinStatsHashType {
     HASH_SERIALIZED,
     MUHASH,
@@ -0,0 +1,92 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/utxo_snapshot.h>
+
+#include <hash.h>
+#include <streams.h>
+#include <version.h>
+
+#include <exception>
+
+namespace node {
+void SnapshotChunkWriter::FlushTxId() {
+    if (m_txid_outputs == 0) {
+        return;
+    }
+
+    CVectorWriter writer(SER_DISK, PROTOCOL_VERSION, m_chunk.m_data,
+                         m_chunk.m_data.size());
+    writer << m_txid << COMPACTSIZE(m_txid_outputs);
+    m_chunk.m_data.insert(m_chunk.m_data.end(), m_txid_data.begin(),
+                          m_txid_data.end());
+
+    m_txid_outputs = 0;
+    m_txid_data.clear();
+}
+
+void SnapshotChunkWriter::Add(const COutPoint &outpoint, const Coin &coin) {
+    if (outpoint.GetTxId() != m_txid) {
+        FlushTxId();
+        m_txid = outpoint.GetTxId();
+    }
+
+    uint32_t n = outpoint.GetN();
+    CVectorWriter writer(SER_DISK, PROTOCOL_VERSION, m_txid_data,
+                         m_txid_data.size());
+    writer << VARINT(n) << coin;
+
+    ++m_txid_outputs;
+    ++m_chunk.m_coins_count;
+}
+
+bool SnapshotChunkWriter::IsFull() const {
+    return m_chunk.m_coins_count >= SNAPSHOT_CHUNK_MAX_COINS ||
+           m_chunk.m_data.size() + m_txid_data.size() >=
+               SNAPSHOT_CHUNK_TARGET_SIZE;
+}
+
+SnapshotChunk SnapshotChunkWriter::Finalize() {
+    FlushTxId();
+    m_chunk.m_hash = Hash(m_chunk.m_data);
+
+    SnapshotChunk chunk = std::move(m_chunk);
+    m_chunk = SnapshotChunk();
+    return chunk;
+}
+
+bool DecodeSnapshotChunk(const SnapshotChunk &chunk,
+                         std::vector<std::pair<COutPoint, Coin>> &coins) {
+    if (Hash(chunk.m_data) != chunk.m_hash ||
+        chunk.m_coins_count > SNAPSHOT_CHUNK_MAX_COINS) {
+        return false;
+    }
+
+    coins.clear();
+    coins.reserve(chunk.m_coins_count);
+    try {
+        CDataStream stream(chunk.m_data, SER_DISK, PROTOCOL_VERSION);
+        while (!stream.empty()) {
+            TxId txid;
+            uint64_t outputs;
+            stream >> txid >> COMPACTSIZE(outputs);
+            if (outputs == 0 ||
+                outputs > chunk.m_coins_count - coins.size()) {
+                return false;
+            }
+
+            for (uint64_t i = 0; i < outputs; ++i) {
+                uint32_t n;
+                Coin coin;
+                stream >> VARINT(n) >> coin;
+                coins.emplace_back(COutPoint(txid, n), std::move(coin));
+            }
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    return coins.size() == chunk.m_coins_count;
+}
+} // namespace node
@@ -6,14 +6,36 @@
 #ifndef BITCOIN_NODE_UTXO_SNAPSHOT_H
 #define BITCOIN_NODE_UTXO_SNAPSHOT_H
 
+#include <coins.h>
 #include <primitives/blockhash.h>
+#include <primitives/transaction.h>
+#include <primitives/txid.h>
 #include <serialize.h>
+#include <uint256.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace node {
+//! Version of the UTXO snapshot format. Since version 2 the coins are
+//! stored in independently hashed chunks.
+static constexpr uint16_t SNAPSHOT_VERSION = 2;
+//! Maximum number of coins in a chunk of a UTXO snapshot
+static constexpr uint32_t SNAPSHOT_CHUNK_MAX_COINS = 100000;
+//! A chunk of a UTXO snapshot is closed once its data reaches this size
+static constexpr size_t SNAPSHOT_CHUNK_TARGET_SIZE = 8 << 20;
+//! Maximum number of threads dumping or loading a UTXO snapshot
+static constexpr int MAX_SNAPSHOT_THREADS = 16;
+
 //! Metadata describing a serialized version of a UTXO set from which an
 //! assumeutxo Chainstate can be constructed.
 class SnapshotMetadata {
 public:
+    //! The version of the snapshot format.
+    uint16_t m_version{SNAPSHOT_VERSION};
+
     //! The hash of the block that reflects the tip of the chain for the
     //! UTXO set contained in this snapshot.
     BlockHash m_base_blockhash;
@@ -28,9 +50,60 @@ public:
         : m_base_blockhash(base_blockhash), m_coins_count(coins_count) {}
 
     SERIALIZE_METHODS(SnapshotMetadata, obj) {
-        READWRITE(obj.m_base_blockhash, obj.m_coins_count);
+        READWRITE(obj.m_version, obj.m_base_blockhash, obj.m_coins_count);
     }
 };
+
+/**
+ * A chunk of the coins of a UTXO snapshot, following the metadata.
+ *
+ * The coins are sorted by outpoint and grouped by txid, so each txid is only
+ * stored once. The data is hashed, so every chunk can be verified and loaded
+ * independently of the others.
+ */
+class SnapshotChunk {
+public:
+    uint32_t m_coins_count{0};
+    //! The hash of m_data
+    uint256 m_hash;
+    std::vector<uint8_t> m_data;
+
+    SERIALIZE_METHODS(SnapshotChunk, obj) {
+        READWRITE(obj.m_coins_count, obj.m_hash, obj.m_data);
+    }
+};
+
+/** Build the chunks of a UTXO snapshot from coins sorted by outpoint. */
+class SnapshotChunkWriter {
+private:
+    SnapshotChunk m_chunk;
+
+    //! The serialized outputs of the current txid, which are only appended to
+    //! the chunk once all of them are known.
+    TxId m_txid;
+    uint64_t m_txid_outputs{0};
+    std::vector<uint8_t> m_txid_data;
+
+    void FlushTxId();
+
+public:
+    //! Add a coin to the chunk. The coins must be added in outpoint order.
+    void Add(const COutPoint &outpoint, const Coin &coin);
+
+    bool IsEmpty() const { return m_chunk.m_coins_count == 0; }
+    //! Whether the chunk has reached its maximum size and should be closed
+    bool IsFull() const;
+
+    //! Return the chunk with the coins added so far and start a new one.
+    SnapshotChunk Finalize();
+};
+
+/**
+ * Verify the hash of a snapshot chunk and deserialize its coins. Returns false
+ * if the chunk is invalid.
+ */
+bool DecodeSnapshotChunk(const SnapshotChunk &chunk,
+                         std::vector<std::pair<COutPoint, Coin>> &coins);
 } // namespace node
 
 #endif // BITCOIN_NODE_UTXO_SNAPSHOT_H
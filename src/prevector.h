@@ -368,7 +368,7 @@ public:
         fill(item_ptr(0), other.begin(), other.end());
     }
 
-    prevector(prevector<N, T, Size, Diff> &&other) { swap(other); }
+    prevector(prevector<N, T, Size, Diff> &&other) noexcept { swap(other); }
 
     prevector &operator=(const prevector<N, T, Size, Diff> &other) {
         if (&other == this) {
@@ -378,7 +378,7 @@ public:
         return *this;
     }
 
-    prevector &operator=(prevector<N, T, Size, Diff> &&other) {
+    prevector &operator=(prevector<N, T, Size, Diff> &&other) noexcept {
         swap(other);
         return *this;
     }
@@ -52,6 +52,24 @@ public:
     int64_t GetBlockTime() const { return (int64_t)nTime; }
 };
 
+/**
+ * Formatter for the transactions of a block. They are deserialized first and
+ * their ids are then computed all at once by MakeTransactionRefs.
+ */
+struct BlockTransactionsFormatter {
+    template <typename Stream>
+    void Ser(Stream &s, const std::vector<CTransactionRef> &vtx) {
+        s << vtx;
+    }
+
+    template <typename Stream>
+    void Unser(Stream &s, std::vector<CTransactionRef> &vtx) {
+        std::vector<CMutableTransaction> txs;
+        s >> txs;
+        vtx = MakeTransactionRefs(std::move(txs));
+    }
+};
+
 class CBlock : public CBlockHeader {
 public:
     // network and disk
@@ -69,7 +87,7 @@ public:
 
     SERIALIZE_METHODS(CBlock, obj) {
         READWRITEAS(CBlockHeader, obj);
-        READWRITE(obj.vtx);
+        READWRITE(Using<BlockTransactionsFormatter>(obj.vtx));
     }
 
     void SetNull() {
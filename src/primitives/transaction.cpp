@@ -6,7 +6,9 @@
 #include <primitives/transaction.h>
 
 #include <consensus/amount.h>
+#include <crypto/sha256.h>
 #include <hash.h>
+#include <streams.h>
 #include <tinyformat.h>
 #include <util/strencodings.h>
 
@@ -73,6 +75,59 @@ CTransaction::CTransaction(const CMutableTransaction &tx)
 CTransaction::CTransaction(CMutableTransaction &&tx)
     : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion),
       nLockTime(tx.nLockTime), hash(ComputeHash()) {}
+CTransaction::CTransaction(CMutableTransaction &&tx, const uint256 &hashIn,
+                           PrecomputedHashKey)
+    : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion),
+      nLockTime(tx.nLockTime), hash(hashIn) {}
+
+/**
+ * Maximum size of the serialized transactions hashed at once by
+ * MakeTransactionRefs, to bound the memory used by very large blocks.
+ */
+static constexpr size_t MAX_TXIDS_BATCH_SIZE = 1 << 20;
+
+std::vector<CTransactionRef>
+MakeTransactionRefs(std::vector<CMutableTransaction> &&txs) {
+    std::vector<CTransactionRef> refs;
+    refs.reserve(txs.size());
+
+    std::vector<uint8_t> serialized;
+    std::vector<size_t> ends;
+    std::vector<const uint8_t *> inputs;
+    std::vector<size_t> lengths;
+    std::vector<uint256> hashes;
+    size_t begin = 0;
+    while (begin < txs.size()) {
+        serialized.clear();
+        ends.clear();
+        size_t end = begin;
+        while (end < txs.size() && serialized.size() < MAX_TXIDS_BATCH_SIZE) {
+            CVectorWriter(SER_GETHASH, 0, serialized, serialized.size(),
+                          txs[end++]);
+            ends.push_back(serialized.size());
+        }
+
+        const size_t count = end - begin;
+        inputs.resize(count);
+        lengths.resize(count);
+        hashes.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const size_t start = i > 0 ? ends[i - 1] : 0;
+            inputs[i] = serialized.data() + start;
+            lengths[i] = ends[i] - start;
+        }
+        SHA256DMulti(hashes[0].begin(), inputs.data(), lengths.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            refs.push_back(std::make_shared<const CTransaction>(
+                std::move(txs[begin + i]), hashes[i],
+                CTransaction::PrecomputedHashKey()));
+        }
+        begin = end;
+    }
+
+    return refs;
+}
 
 Amount CTransaction::GetValueOut() const {
     Amount nValueOut = Amount::zero();
@@ -217,12 +217,24 @@ private:
     uint256 ComputeHash() const;
 
 public:
+    /**
+     * Restrict the construction from a precomputed hash to
+     * MakeTransactionRefs, while still allowing std::make_shared.
+     */
+    class PrecomputedHashKey {
+        PrecomputedHashKey() {}
+        friend std::vector<std::shared_ptr<const CTransaction>>
+        MakeTransactionRefs(std::vector<CMutableTransaction> &&txs);
+    };
+
     /** Construct a CTransaction that qualifies as IsNull() */
     CTransaction();
 
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction &tx);
     explicit CTransaction(CMutableTransaction &&tx);
+    CTransaction(CMutableTransaction &&tx, const uint256 &hashIn,
+                 PrecomputedHashKey);
 
     template <typename Stream> inline void Serialize(Stream &s) const {
         SerializeTransaction(*this, s);
@@ -323,6 +335,13 @@ static inline CTransactionRef MakeTransactionRef(Tx &&txIn) {
     return std::make_shared<const CTransaction>(std::forward<Tx>(txIn));
 }
 
+/**
+ * Convert many CMutableTransactions into CTransactionRefs, computing their
+ * hashes all at once so they can be hashed in parallel (see SHA256DMulti).
+ */
+std::vector<CTransactionRef>
+MakeTransactionRefs(std::vector<CMutableTransaction> &&txs);
+
 /** Precompute sighash midstate to avoid quadratic hashing */
 struct PrecomputedTransactionData {
     uint256 hashPrevouts, hashSequence, hashOutputs;
@@ -321,6 +321,20 @@ extern const char *AVAPROOFS;
  */
 extern const char *AVAPROOFSREQ;
 
+/**
+ * The avasketch message contains a sketch of the short txids of all the
+ * transactions in the sender's mempool. It is sent periodically to the
+ * avalanche peers so they can find out which transactions either of them is
+ * missing.
+ */
+extern const char *AVASKETCH;
+
+/**
+ * Sent in response to an "avasketch" message, containing the short txids of the
+ * transactions in the sketch which are missing from the receiver's mempool.
+ */
+extern const char *AVADIFF;
+
 /**
  * Indicate if the message is used to transmit the content of a block.
  * These messages can be significantly larger than usual messages and therefore
@@ -170,7 +170,7 @@ int ecdsa_signature_parse_der_lax(const secp256k1_context *ctx,
 }
 
 bool CPubKey::VerifyECDSA(const uint256 &hash,
-                          const std::vector<uint8_t> &vchSig) const {
+                          Span<const uint8_t> vchSig) const {
     if (!IsValid()) {
         return false;
     }
@@ -213,7 +213,7 @@ bool CPubKey::VerifySchnorr(
 }
 
 bool CPubKey::VerifySchnorr(const uint256 &hash,
-                            const std::vector<uint8_t> &vchSig) const {
+                            Span<const uint8_t> vchSig) const {
     if (vchSig.size() != SCHNORR_SIZE) {
         return false;
     }
@@ -338,13 +338,12 @@ bool CExtPubKey::Derive(CExtPubKey &out, unsigned int _nChild) const {
     return pubkey.Derive(out.pubkey, out.chaincode, _nChild, chaincode);
 }
 
-bool CPubKey::CheckLowS(
-    const boost::sliced_range<const std::vector<uint8_t>> &vchSig) {
+bool CPubKey::CheckLowS(Span<const uint8_t> vchSig) {
     secp256k1_ecdsa_signature sig;
     assert(secp256k1_context_verify &&
            "secp256k1_context_verify must be initialized to use CPubKey.");
     if (!ecdsa_signature_parse_der_lax(secp256k1_context_verify, &sig,
-                                       &vchSig.front(), vchSig.size())) {
+                                       vchSig.data(), vchSig.size())) {
         return false;
     }
     return (!secp256k1_ecdsa_signature_normalize(secp256k1_context_verify,
@@ -9,9 +9,9 @@
 
 #include <hash.h>
 #include <serialize.h>
+#include <span.h>
 #include <uint256.h>
 
-#include <boost/range/adaptor/sliced.hpp>
 
 #include <stdexcept>
 #include <vector>
@@ -162,8 +162,7 @@ public:
      * Verify a DER-serialized ECDSA signature (~72 bytes).
      * If this public key is not fully valid, the return value will be false.
      */
-    bool VerifyECDSA(const uint256 &hash,
-                     const std::vector<uint8_t> &vchSig) const;
+    bool VerifyECDSA(const uint256 &hash, Span<const uint8_t> vchSig) const;
 
     /**
      * Verify a Schnorr signature (=64 bytes).
@@ -171,17 +170,12 @@ public:
      */
     bool VerifySchnorr(const uint256 &hash,
                        const std::array<uint8_t, SCHNORR_SIZE> &sig) const;
-    bool VerifySchnorr(const uint256 &hash,
-                       const std::vector<uint8_t> &vchSig) const;
+    bool VerifySchnorr(const uint256 &hash, Span<const uint8_t> vchSig) const;
 
     /**
      * Check whether a DER-serialized ECDSA signature is normalized (lower-S).
      */
-    static bool
-    CheckLowS(const boost::sliced_range<const std::vector<uint8_t>> &vchSig);
-    static bool CheckLowS(const std::vector<uint8_t> &vchSig) {
-        return CheckLowS(vchSig | boost::adaptors::sliced(0, vchSig.size()));
-    }
+    static bool CheckLowS(Span<const uint8_t> vchSig);
 
     //! Recover a public key from a compact ECDSA signature.
     bool RecoverCompact(const uint256 &hash,
@@ -7,6 +7,7 @@
 #include <chainparams.h>
 #include <config.h>
 #include <core_io.h>
+#include <httprpc.h>
 #include <httpserver.h>
 #include <index/txindex.h>
 #include <node/blockstorage.h>
@@ -339,6 +340,20 @@ static bool rest_block(const Config &config, const std::any &context,
         }
 
         case RetFormat::JSON: {
+            if (showTxDetails) {
+                HTTPResultStream stream(req, "", "\n");
+                try {
+                    blockToJSONStream(stream, chainman.m_blockman, block, tip,
+                                      pblockindex);
+                } catch (const std::exception &) {
+                    // An error response is sent if nothing was streamed yet
+                    stream.Finish(false);
+                    return false;
+                }
+                stream.Finish();
+                return true;
+            }
+
             UniValue objBlock = blockToJSON(chainman.m_blockman, block, tip,
                                             pblockindex, showTxDetails);
             std::string strJSON = objBlock.write() + "\n";
@@ -442,11 +457,14 @@ static bool rest_mempool_contents(Config &config, const std::any &context,
 
     switch (rf) {
         case RetFormat::JSON: {
-            UniValue mempoolObject = MempoolToJSON(*mempool, true);
-
-            std::string strJSON = mempoolObject.write() + "\n";
-            req->WriteHeader("Content-Type", "application/json");
-            req->WriteReply(HTTP_OK, strJSON);
+            HTTPResultStream stream(req, "", "\n");
+            try {
+                MempoolToJSONStream(stream, *mempool);
+            } catch (const std::exception &) {
+                stream.Finish(false);
+                return false;
+            }
+            stream.Finish();
             return true;
         }
         default: {
@@ -836,7 +854,9 @@ void StartREST(const std::any &context) {
                                      const std::string &prefix) {
             return up.handler(config, context, req, prefix);
         };
-        RegisterHTTPHandler(up.prefix, false, handler);
+        RegisterHTTPHandler(
+            up.prefix, false, handler,
+            [](HTTPRequest *) { return HTTPWorkQueueType::REST; });
     }
 }
 
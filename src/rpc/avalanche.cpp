@@ -25,6 +25,9 @@
 
 #include <univalue.h>
 
+#include <algorithm>
+#include <vector>
+
 using node::GetTransaction;
 using node::NodeContext;
 
@@ -730,6 +733,24 @@ static RPCHelpMan getavalancheinfo() {
                      {RPCResult::Type::NUM, "pending_node_count",
                       "The number of avalanche nodes pending for a proof."},
                  }},
+                {RPCResult::Type::OBJ,
+                 "polling",
+                 "Statistics about the polls sent to the connected avalanche "
+                 "nodes.",
+                 {
+                     {RPCResult::Type::NUM, "node_count",
+                      "The number of connected nodes that have been polled."},
+                     {RPCResult::Type::NUM, "response_count",
+                      "The number of responses received from these nodes."},
+                     {RPCResult::Type::NUM, "timeout_count",
+                      "The number of polls to these nodes that timed out."},
+                     {RPCResult::Type::NUM, "average_latency_ms",
+                      "The average time it takes for these nodes to respond, "
+                      "in milliseconds."},
+                     {RPCResult::Type::NUM, "average_poll_size",
+                      "The average number of items these nodes can be polled "
+                      "for at once. It shrinks when a node doesn't respond."},
+                 }},
             },
         },
         RPCExamples{HelpExampleCli("getavalancheinfo", "") +
@@ -842,6 +863,109 @@ static RPCHelpMan getavalancheinfo() {
                 ret.pushKV("network", network);
             });
 
+            const avalanche::PollStats pollStats = g_avalanche->getPollStats();
+            UniValue polling(UniValue::VOBJ);
+            polling.pushKV("node_count", uint64_t(pollStats.nodeCount));
+            polling.pushKV("response_count", pollStats.responses);
+            polling.pushKV("timeout_count", pollStats.timeouts);
+            polling.pushKV("average_latency_ms",
+                           pollStats.averageLatency.count() / 1000.);
+            polling.pushKV("average_poll_size", pollStats.averagePollSize);
+            ret.pushKV("polling", polling);
+
+            return ret;
+        },
+    };
+}
+
+static RPCHelpMan getavalanchelatencyinfo() {
+    return RPCHelpMan{
+        "getavalanchelatencyinfo",
+        "Returns histograms of the time it takes for avalanche to finalize the "
+        "items and of the time the nodes take to respond to the polls.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ,
+            "",
+            "",
+            {
+                {RPCResult::Type::OBJ,
+                 "finalization_time",
+                 "Time from the start of the vote on an item to its "
+                 "finalization or invalidation, in milliseconds",
+                 {
+                     HistogramRPCResult("blocks", "For the blocks"),
+                     HistogramRPCResult("proofs", "For the proofs"),
+                     HistogramRPCResult("transactions",
+                                        "For the transactions"),
+                 }},
+                HistogramRPCResult("poll_round_trip_time",
+                                   "Time between a poll and its response, in "
+                                   "microseconds"),
+                {RPCResult::Type::ARR,
+                 "nodes",
+                 "The round trip time for each connected node",
+                 {
+                     {RPCResult::Type::OBJ,
+                      "",
+                      "",
+                      {
+                          {RPCResult::Type::NUM, "nodeid", "The node id"},
+                          HistogramRPCResult("poll_round_trip_time",
+                                             "Time between a poll and its "
+                                             "response, in microseconds"),
+                      }},
+                 }},
+                HistogramRPCResult("votes_per_poll",
+                                   "Number of votes in each valid response"),
+                {RPCResult::Type::NUM, "timed_out_polls",
+                 "The number of polls that got no response in time"},
+            },
+        },
+        RPCExamples{HelpExampleCli("getavalanchelatencyinfo", "") +
+                    HelpExampleRpc("getavalanchelatencyinfo", "")},
+        [&](const RPCHelpMan &self, const Config &config,
+            const JSONRPCRequest &request) -> UniValue {
+            if (!g_avalanche) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR,
+                                   "Avalanche is not initialized");
+            }
+
+            const avalanche::LatencyStats stats =
+                g_avalanche->getLatencyStats();
+
+            UniValue finalizationTime(UniValue::VOBJ);
+            finalizationTime.pushKV(
+                "blocks", HistogramToJSON(stats.blockFinalizationTime));
+            finalizationTime.pushKV(
+                "proofs", HistogramToJSON(stats.proofFinalizationTime));
+            finalizationTime.pushKV(
+                "transactions", HistogramToJSON(stats.txFinalizationTime));
+
+            std::vector<NodeId> nodeids;
+            for (const auto &[nodeid, histogram] :
+                 stats.nodePollRoundTripTime) {
+                nodeids.push_back(nodeid);
+            }
+            std::sort(nodeids.begin(), nodeids.end());
+
+            UniValue nodes(UniValue::VARR);
+            for (const NodeId nodeid : nodeids) {
+                UniValue node(UniValue::VOBJ);
+                node.pushKV("nodeid", nodeid);
+                node.pushKV(
+                    "poll_round_trip_time",
+                    HistogramToJSON(stats.nodePollRoundTripTime.at(nodeid)));
+                nodes.push_back(node);
+            }
+
+            UniValue ret(UniValue::VOBJ);
+            ret.pushKV("finalization_time", finalizationTime);
+            ret.pushKV("poll_round_trip_time",
+                       HistogramToJSON(stats.pollRoundTripTime));
+            ret.pushKV("nodes", nodes);
+            ret.pushKV("votes_per_poll", HistogramToJSON(stats.votesPerPoll));
+            ret.pushKV("timed_out_polls", stats.timedOutPolls);
             return ret;
         },
     };
@@ -1343,6 +1467,7 @@ void RegisterAvalancheRPCCommands(CRPCTable &t) {
         { "avalanche",         delegateavalancheproof,    },
         { "avalanche",         decodeavalanchedelegation, },
         { "avalanche",         getavalancheinfo,          },
+        { "avalanche",         getavalanchelatencyinfo,   },
         { "avalanche",         getavalanchepeerinfo,      },
         { "avalanche",         getavalancheproofs,        },
         { "avalanche",         getrawavalancheproof,      },
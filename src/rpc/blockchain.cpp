@@ -34,16 +34,24 @@
 #include <txmempool.h>
 #include <undo.h>
 #include <util/check.h>
+#include <util/hasher.h>
 #include <util/strencodings.h>
+#include <util/system.h>
+#include <util/threadnames.h>
 #include <util/translation.h>
 #include <validation.h>
 #include <validationinterface.h>
 #include <warnings.h>
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
+#include <vector>
 
 using node::BlockManager;
 using node::CCoinsStats;
@@ -51,6 +59,9 @@ using node::CoinStatsHashType;
 using node::GetUTXOStats;
 using node::NodeContext;
 using node::ReadBlockFromDisk;
+using node::MAX_SNAPSHOT_THREADS;
+using node::SnapshotChunk;
+using node::SnapshotChunkWriter;
 using node::SnapshotMetadata;
 using node::UndoReadFromDisk;
 
@@ -161,6 +172,26 @@ UniValue blockheaderToJSON(const CBlockIndex *tip,
     return result;
 }
 
+/** Read the undo data of the block, if it is available. */
+static bool ReadBlockUndo(BlockManager &blockman, const CBlockIndex *blockindex,
+                          CBlockUndo &blockUndo) {
+    const bool is_not_pruned{
+        WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
+    return is_not_pruned && UndoReadFromDisk(blockUndo, blockindex);
+}
+
+/** Detailed description of the i-th transaction of the block */
+static UniValue blockTxToJSON(const CBlock &block, size_t i,
+                              const CBlockUndo *blockUndo) {
+    // coinbase transaction (i == 0) doesn't have undo data
+    const CTxUndo *txundo =
+        (blockUndo && i) ? &blockUndo->vtxundo.at(i - 1) : nullptr;
+    UniValue objTx(UniValue::VOBJ);
+    TxToUniv(*block.vtx.at(i), BlockHash(), objTx, true,
+             RPCSerializationFlags(), txundo);
+    return objTx;
+}
+
 UniValue blockToJSON(BlockManager &blockman, const CBlock &block,
                      const CBlockIndex *tip, const CBlockIndex *blockindex,
                      bool txDetails) {
@@ -170,19 +201,10 @@ UniValue blockToJSON(BlockManager &blockman, const CBlock &block,
     UniValue txs(UniValue::VARR);
     if (txDetails) {
         CBlockUndo blockUndo;
-        const bool is_not_pruned{
-            WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
-        const bool have_undo{is_not_pruned &&
-                             UndoReadFromDisk(blockUndo, blockindex)};
+        const bool have_undo{ReadBlockUndo(blockman, blockindex, blockUndo)};
         for (size_t i = 0; i < block.vtx.size(); ++i) {
-            const CTransactionRef &tx = block.vtx.at(i);
-            // coinbase transaction (i == 0) doesn't have undo data
-            const CTxUndo *txundo =
-                (have_undo && i) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
-            UniValue objTx(UniValue::VOBJ);
-            TxToUniv(*tx, BlockHash(), objTx, true, RPCSerializationFlags(),
-                     txundo);
-            txs.push_back(objTx);
+            txs.push_back(
+                blockTxToJSON(block, i, have_undo ? &blockUndo : nullptr));
         }
     } else {
         for (const CTransactionRef &tx : block.vtx) {
@@ -194,6 +216,30 @@ UniValue blockToJSON(BlockManager &blockman, const CBlock &block,
     return result;
 }
 
+void blockToJSONStream(RPCResultStream &stream, BlockManager &blockman,
+                       const CBlock &block, const CBlockIndex *tip,
+                       const CBlockIndex *blockindex) {
+    CBlockUndo blockUndo;
+    const bool have_undo{ReadBlockUndo(blockman, blockindex, blockUndo)};
+
+    UniValue result = blockheaderToJSON(tip, blockindex);
+    result.pushKV("size", (int)::GetSerializeSize(block, PROTOCOL_VERSION));
+    // Leave the object open so the transactions can be appended.
+    std::string header = result.write();
+    header.pop_back();
+    stream.Write(header + ",\"tx\":[");
+
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        if (i > 0) {
+            stream.Write(",");
+        }
+        stream.Write(
+            blockTxToJSON(block, i, have_undo ? &blockUndo : nullptr).write());
+        stream.Flush();
+    }
+    stream.Write("]}");
+}
+
 static RPCHelpMan getblockcount() {
     return RPCHelpMan{
         "getblockcount",
@@ -574,6 +620,27 @@ UniValue MempoolToJSON(const CTxMemPool &pool, bool verbose,
     }
 }
 
+void MempoolToJSONStream(RPCResultStream &stream, const CTxMemPool &pool) {
+    {
+        LOCK(pool.cs);
+        stream.Write("{");
+        bool first = true;
+        for (const CTxMemPoolEntry &e : pool.mapTx) {
+            UniValue info(UniValue::VOBJ);
+            entryToJSON(pool, info, e);
+            if (!first) {
+                stream.Write(",");
+            }
+            first = false;
+            stream.Write(UniValue(e.GetTx().GetId().ToString()).write() + ":" +
+                         info.write());
+        }
+        stream.Write("}");
+    }
+    // Don't hold the mempool lock while waiting for the client.
+    stream.Flush();
+}
+
 static RPCHelpMan getrawmempool() {
     return RPCHelpMan{
         "getrawmempool",
@@ -634,8 +701,14 @@ static RPCHelpMan getrawmempool() {
                 include_mempool_sequence = request.params[1].get_bool();
             }
 
-            return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose,
-                                 include_mempool_sequence);
+            const CTxMemPool &mempool = EnsureAnyMemPool(request.context);
+            if (fVerbose && !include_mempool_sequence &&
+                request.resultStream) {
+                MempoolToJSONStream(*request.resultStream, mempool);
+                return NullUniValue;
+            }
+
+            return MempoolToJSON(mempool, fVerbose, include_mempool_sequence);
         },
     };
 }
@@ -1168,6 +1241,12 @@ static RPCHelpMan getblock() {
                 return strHex;
             }
 
+            if (verbosity >= 2 && request.resultStream) {
+                blockToJSONStream(*request.resultStream, chainman.m_blockman,
+                                  block, tip, pblockindex);
+                return NullUniValue;
+            }
+
             return blockToJSON(chainman.m_blockman, block, tip, pblockindex,
                                verbosity >= 2);
         },
@@ -2709,14 +2788,32 @@ static RPCHelpMan savemempool() {
 }
 
 namespace {
-//! Search for a given set of pubkey scripts
-static bool FindScriptPubKey(std::atomic<int> &scan_progress,
+//! Maximum number of threads scanning the txout set in parallel
+static constexpr int MAX_SCAN_TXOUTSET_THREADS = 16;
+//! Hashed set of the pubkey scripts to search for
+using ScriptNeedles = std::unordered_set<CScript, SaltedSipHasher>;
+
+//! Position of an outpoint in the txout set, in units of 1/65536 of the
+//! txid space
+static uint32_t ScanPosition(const COutPoint &outpoint) {
+    const TxId &txid = outpoint.GetTxId();
+    return 0x100 * *txid.begin() + *(txid.begin() + 1);
+}
+
+/**
+ * Search for a given set of pubkey scripts in a range of the txout set.
+ * The range covers the positions from range_begin to range_end, and the
+ * scanned reference is updated with the number of positions that have been
+ * scanned so far.
+ */
+static bool FindScriptPubKey(std::atomic<uint32_t> &scanned,
+                             uint32_t range_begin, uint32_t range_end,
                              const std::atomic<bool> &should_abort,
                              int64_t &count, CCoinsViewCursor *cursor,
-                             const std::set<CScript> &needles,
+                             const ScriptNeedles &needles,
                              std::map<COutPoint, Coin> &out_results,
                              std::function<void()> &interruption_point) {
-    scan_progress = 0;
+    scanned = 0;
     count = 0;
     while (cursor->Valid()) {
         COutPoint key;
@@ -2733,18 +2830,72 @@ static bool FindScriptPubKey(std::atomic<int> &scan_progress,
         }
         if (count % 256 == 0) {
             // update progress reference every 256 item
-            const TxId &txid = key.GetTxId();
-            uint32_t high = 0x100 * *txid.begin() + *(txid.begin() + 1);
-            scan_progress = int(high * 100.0 / 65536.0 + 0.5);
+            scanned = ScanPosition(key) - range_begin;
         }
         if (needles.count(coin.GetTxOut().scriptPubKey)) {
             out_results.emplace(key, coin);
         }
         cursor->Next();
     }
-    scan_progress = 100;
+    scanned = range_end - range_begin;
     return true;
 }
+
+/**
+ * Search for a given set of pubkey scripts in the whole txout set, scanning
+ * ranges of the coins database in parallel.
+ */
+static bool FindScriptPubKey(std::atomic<int> &scan_progress,
+                             const std::atomic<bool> &should_abort,
+                             int64_t &count, CCoinsView &view,
+                             const ScriptNeedles &needles,
+                             std::map<COutPoint, Coin> &out_results,
+                             std::function<void()> &interruption_point) {
+    scan_progress = 0;
+    count = 0;
+
+    const std::vector<std::unique_ptr<CCoinsViewCursor>> cursors =
+        view.RangeCursors(
+            std::clamp(GetNumCores(), 1, MAX_SCAN_TXOUTSET_THREADS));
+    const size_t n_ranges = cursors.size();
+
+    std::vector<std::atomic<uint32_t>> scanned(n_ranges);
+    std::vector<int64_t> counts(n_ranges, 0);
+    std::vector<std::map<COutPoint, Coin>> results(n_ranges);
+    // Declared last so the destructors wait for all the tasks to complete,
+    // even if one of them throws.
+    std::vector<std::future<bool>> tasks;
+    for (size_t i = 0; i < n_ranges; ++i) {
+        CCoinsViewCursor *cursor = CHECK_NONFATAL(cursors[i].get());
+        tasks.push_back(std::async(std::launch::async, [&, i, cursor] {
+            util::ThreadRename(strprintf("scantxoutset.%i", i));
+            // The ranges are split on the first byte of the txids, see
+            // CCoinsViewDB::RangeCursors.
+            const uint32_t range_begin = 0x100 * (i * 0x100 / n_ranges);
+            const uint32_t range_end = 0x100 * ((i + 1) * 0x100 / n_ranges);
+            return FindScriptPubKey(scanned[i], range_begin, range_end,
+                                    should_abort, counts[i], cursor, needles,
+                                    results[i], interruption_point);
+        }));
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < n_ranges; ++i) {
+        while (tasks[i].wait_for(std::chrono::milliseconds{100}) !=
+               std::future_status::ready) {
+            uint32_t total_scanned = 0;
+            for (const std::atomic<uint32_t> &range_scanned : scanned) {
+                total_scanned += range_scanned;
+            }
+            scan_progress = int(total_scanned * 100.0 / 65536.0 + 0.5);
+        }
+        success &= tasks[i].get();
+        count += counts[i];
+        out_results.merge(results[i]);
+    }
+    scan_progress = 100;
+    return success;
+}
 } // namespace
 
 /** RAII object to prevent concurrency issue when scanning the txout set */
@@ -2925,7 +3076,7 @@ static RPCHelpMan scantxoutset() {
                                        "the start action");
                 }
 
-                std::set<CScript> needles;
+                ScriptNeedles needles;
                 std::map<CScript, std::string> descriptors;
                 Amount total_in = Amount::zero();
 
@@ -2951,7 +3102,7 @@ static RPCHelpMan scantxoutset() {
                 g_should_abort_scan = false;
                 g_scan_progress = 0;
                 int64_t count = 0;
-                std::unique_ptr<CCoinsViewCursor> pcursor;
+                CCoinsViewDB *coins_db;
                 const CBlockIndex *tip;
                 NodeContext &node = EnsureAnyNodeContext(request.context);
                 {
@@ -2959,12 +3110,11 @@ static RPCHelpMan scantxoutset() {
                     LOCK(cs_main);
                     Chainstate &active_chainstate = chainman.ActiveChainstate();
                     active_chainstate.ForceFlushStateToDisk();
-                    pcursor = CHECK_NONFATAL(std::unique_ptr<CCoinsViewCursor>(
-                        active_chainstate.CoinsDB().Cursor()));
+                    coins_db = &active_chainstate.CoinsDB();
                     tip = CHECK_NONFATAL(active_chainstate.m_chain.Tip());
                 }
                 bool res = FindScriptPubKey(
-                    g_scan_progress, g_should_abort_scan, count, pcursor.get(),
+                    g_scan_progress, g_should_abort_scan, count, *coins_db,
                     needles, coins, node.rpc_interruption_point);
                 result.pushKV("success", res);
                 result.pushKV("txouts", count);
@@ -3153,9 +3303,43 @@ static RPCHelpMan dumptxoutset() {
     };
 }
 
+//! Number of ranges of the UTXO set serialized independently by dumptxoutset
+static constexpr size_t SNAPSHOT_DUMP_RANGES = 256;
+
+//! Serialize the coins of a range of the UTXO set into snapshot chunks
+static std::vector<SnapshotChunk>
+SerializeSnapshotChunks(CCoinsViewCursor &cursor,
+                        const std::function<void()> &interruption_point) {
+    std::vector<SnapshotChunk> chunks;
+    SnapshotChunkWriter writer;
+    COutPoint key;
+    Coin coin;
+    unsigned int iter{0};
+
+    while (cursor.Valid()) {
+        if (iter % 5000 == 0) {
+            interruption_point();
+        }
+        ++iter;
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
+            writer.Add(key, coin);
+            if (writer.IsFull()) {
+                chunks.push_back(writer.Finalize());
+            }
+        }
+
+        cursor.Next();
+    }
+
+    if (!writer.IsEmpty()) {
+        chunks.push_back(writer.Finalize());
+    }
+    return chunks;
+}
+
 UniValue CreateUTXOSnapshot(NodeContext &node, Chainstate &chainstate,
                             CAutoFile &afile) {
-    std::unique_ptr<CCoinsViewCursor> pcursor;
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
     CCoinsStats stats{CoinStatsHashType::NONE};
     const CBlockIndex *tip;
 
@@ -3163,11 +3347,11 @@ UniValue CreateUTXOSnapshot(NodeContext &node, Chainstate &chainstate,
         // We need to lock cs_main to ensure that the coinsdb isn't
         // written to between (i) flushing coins cache to disk
         // (coinsdb), (ii) getting stats based upon the coinsdb, and
-        // (iii) constructing a cursor to the coinsdb for use below this
+        // (iii) constructing the cursors to the coinsdb for use below this
         // block.
         //
         // Cursors returned by leveldb iterate over snapshots, so the
-        // contents of the pcursor will not be affected by simultaneous
+        // contents of the cursors will not be affected by simultaneous
         // writes during use below this block.
         //
         // See discussion here:
@@ -3182,8 +3366,7 @@ UniValue CreateUTXOSnapshot(NodeContext &node, Chainstate &chainstate,
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
         }
 
-        pcursor =
-            std::unique_ptr<CCoinsViewCursor>(chainstate.CoinsDB().Cursor());
+        cursors = chainstate.CoinsDB().RangeCursors(SNAPSHOT_DUMP_RANGES);
         tip = CHECK_NONFATAL(
             chainstate.m_blockman.LookupBlockIndex(stats.hashBlock));
     }
@@ -3193,21 +3376,26 @@ UniValue CreateUTXOSnapshot(NodeContext &node, Chainstate &chainstate,
 
     afile << metadata;
 
-    COutPoint key;
-    Coin coin;
-    unsigned int iter{0};
-
-    while (pcursor->Valid()) {
-        if (iter % 5000 == 0) {
-            node.rpc_interruption_point();
+    // The ranges are serialized in parallel, in batches of one range per
+    // thread, and written in order so the snapshot is deterministic.
+    const size_t n_threads =
+        std::clamp(GetNumCores(), 1, MAX_SNAPSHOT_THREADS);
+    for (size_t begin = 0; begin < cursors.size(); begin += n_threads) {
+        const size_t end = std::min(begin + n_threads, cursors.size());
+        std::vector<std::vector<SnapshotChunk>> chunks(end - begin);
+        std::vector<std::future<void>> tasks;
+        for (size_t i = begin; i < end; ++i) {
+            tasks.push_back(std::async(std::launch::async, [&, i] {
+                chunks[i - begin] = SerializeSnapshotChunks(
+                    *CHECK_NONFATAL(cursors[i]), node.rpc_interruption_point);
+            }));
         }
-        ++iter;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            afile << key;
-            afile << coin;
+        for (size_t i = begin; i < end; ++i) {
+            tasks[i - begin].get();
+            for (const SnapshotChunk &chunk : chunks[i - begin]) {
+                afile << chunk;
+            }
         }
-
-        pcursor->Next();
     }
 
     afile.fclose();
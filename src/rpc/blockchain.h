@@ -19,6 +19,7 @@ class Chainstate;
 class ChainstateManager;
 class CTxMemPool;
 class RPCHelpMan;
+class RPCResultStream;
 namespace node {
 struct NodeContext;
 } // namespace node
@@ -43,6 +44,14 @@ UniValue blockToJSON(node::BlockManager &blockman, const CBlock &block,
                      const CBlockIndex *tip, const CBlockIndex *blockindex,
                      bool txDetails = false) LOCKS_EXCLUDED(cs_main);
 
+/**
+ * Write the same JSON as blockToJSON with txDetails to the stream, without
+ * holding the description of all the transactions in memory.
+ */
+void blockToJSONStream(RPCResultStream &stream, node::BlockManager &blockman,
+                       const CBlock &block, const CBlockIndex *tip,
+                       const CBlockIndex *blockindex) LOCKS_EXCLUDED(cs_main);
+
 /** Mempool information to JSON */
 UniValue MempoolInfoToJSON(const CTxMemPool &pool);
 
@@ -50,6 +59,9 @@ UniValue MempoolInfoToJSON(const CTxMemPool &pool);
 UniValue MempoolToJSON(const CTxMemPool &pool, bool verbose = false,
                        bool include_mempool_sequence = false);
 
+/** Write the same JSON as the verbose MempoolToJSON to the stream */
+void MempoolToJSONStream(RPCResultStream &stream, const CTxMemPool &pool);
+
 /** Block header to JSON */
 UniValue blockheaderToJSON(const CBlockIndex *tip,
                            const CBlockIndex *blockindex)
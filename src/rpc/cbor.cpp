@@ -0,0 +1,431 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/cbor.h>
+
+#include <util/strencodings.h>
+#include <util/string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+enum MajorType : uint8_t {
+    UNSIGNED_INT = 0,
+    NEGATIVE_INT = 1,
+    BYTE_STRING = 2,
+    TEXT_STRING = 3,
+    ARRAY = 4,
+    MAP = 5,
+    TAG = 6,
+    SIMPLE = 7,
+};
+
+//! Additional information values of the simple/float major type
+constexpr uint8_t SIMPLE_FALSE = 20;
+constexpr uint8_t SIMPLE_TRUE = 21;
+constexpr uint8_t SIMPLE_NULL = 22;
+constexpr uint8_t SIMPLE_UNDEFINED = 23;
+constexpr uint8_t SIMPLE_FLOAT16 = 25;
+constexpr uint8_t SIMPLE_FLOAT32 = 26;
+constexpr uint8_t SIMPLE_FLOAT64 = 27;
+
+//! RFC 8949 section 3.4.4
+constexpr uint64_t TAG_DECIMAL_FRACTION = 4;
+
+/**
+ * Maximum number of fractional digits of a decoded decimal fraction. This is
+ * way more than any number returned by the RPC, and prevents a tiny document
+ * from decoding to a huge string.
+ */
+constexpr uint64_t MAX_DECIMAL_FRACTION_DIGITS = 64;
+
+void WriteHead(std::string &out, uint8_t major, uint64_t arg) {
+    const uint8_t type = major << 5;
+    if (arg < 24) {
+        out.push_back(char(type | arg));
+        return;
+    }
+
+    int size = 8;
+    uint8_t info = 27;
+    if (arg <= 0xff) {
+        size = 1;
+        info = 24;
+    } else if (arg <= 0xffff) {
+        size = 2;
+        info = 25;
+    } else if (arg <= 0xffffffff) {
+        size = 4;
+        info = 26;
+    }
+
+    out.push_back(char(type | info));
+    for (int i = size - 1; i >= 0; i--) {
+        out.push_back(char(arg >> (8 * i)));
+    }
+}
+
+void WriteInt(std::string &out, int64_t value) {
+    if (value >= 0) {
+        WriteHead(out, UNSIGNED_INT, value);
+    } else {
+        // -1 - value, which can't overflow
+        WriteHead(out, NEGATIVE_INT, ~uint64_t(value));
+    }
+}
+
+bool IsLowerHex(const std::string &str) {
+    return !str.empty() && str.size() % 2 == 0 &&
+           std::all_of(str.begin(), str.end(), [](char c) {
+               return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+           });
+}
+
+/** Format mantissa * 10^-fracDigits with exactly fracDigits decimals. */
+std::string FormatDecimal(int64_t mantissa, uint64_t fracDigits) {
+    const bool negative = mantissa < 0;
+    const uint64_t abs = negative ? ~uint64_t(mantissa) + 1 : mantissa;
+    std::string digits = ToString(abs);
+    if (fracDigits == 0) {
+        return (negative ? "-" : "") + digits;
+    }
+    if (digits.size() <= fracDigits) {
+        digits.insert(0, fracDigits + 1 - digits.size(), '0');
+    }
+    digits.insert(digits.size() - fracDigits, ".");
+    return (negative ? "-" : "") + digits;
+}
+
+/**
+ * Parse a "[-]digits.digits" number as a decimal fraction. Returns false if
+ * the number has another format, if the mantissa overflows or if the number
+ * can't be formatted back to the same string.
+ */
+bool ParseDecimal(const std::string &str, int64_t &mantissa,
+                  uint64_t &fracDigits) {
+    const size_t start = str.size() > 0 && str[0] == '-' ? 1 : 0;
+    const size_t point = str.find('.');
+    if (point == std::string::npos || point == start ||
+        point + 1 == str.size() ||
+        str.size() - point - 1 > MAX_DECIMAL_FRACTION_DIGITS) {
+        return false;
+    }
+
+    uint64_t abs = 0;
+    for (size_t i = start; i < str.size(); i++) {
+        if (i == point) {
+            continue;
+        }
+        const char c = str[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        if (abs > (uint64_t(std::numeric_limits<int64_t>::max()) - (c - '0')) /
+                      10) {
+            return false;
+        }
+        abs = abs * 10 + (c - '0');
+    }
+
+    mantissa = start ? -int64_t(abs) : int64_t(abs);
+    fracDigits = str.size() - point - 1;
+    return FormatDecimal(mantissa, fracDigits) == str;
+}
+
+void WriteDouble(std::string &out, double value) {
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value));
+    std::memcpy(&bits, &value, sizeof(bits));
+    out.push_back(char((SIMPLE << 5) | SIMPLE_FLOAT64));
+    for (int i = 7; i >= 0; i--) {
+        out.push_back(char(bits >> (8 * i)));
+    }
+}
+
+void WriteNumber(std::string &out, const UniValue &value) {
+    const std::string &str = value.getValStr();
+
+    int64_t i64;
+    if (ParseInt64(str, &i64) && ToString(i64) == str) {
+        WriteInt(out, i64);
+        return;
+    }
+    uint64_t u64;
+    if (ParseUInt64(str, &u64) && ToString(u64) == str) {
+        WriteHead(out, UNSIGNED_INT, u64);
+        return;
+    }
+
+    int64_t mantissa;
+    uint64_t fracDigits;
+    if (ParseDecimal(str, mantissa, fracDigits)) {
+        WriteHead(out, TAG, TAG_DECIMAL_FRACTION);
+        WriteHead(out, ARRAY, 2);
+        WriteInt(out, -int64_t(fracDigits));
+        WriteInt(out, mantissa);
+        return;
+    }
+
+    WriteDouble(out, value.get_real());
+}
+
+void Write(std::string &out, const UniValue &value) {
+    switch (value.getType()) {
+        case UniValue::VNULL:
+            out.push_back(char((SIMPLE << 5) | SIMPLE_NULL));
+            return;
+        case UniValue::VBOOL:
+            out.push_back(char((SIMPLE << 5) |
+                               (value.get_bool() ? SIMPLE_TRUE : SIMPLE_FALSE)));
+            return;
+        case UniValue::VNUM:
+            WriteNumber(out, value);
+            return;
+        case UniValue::VSTR: {
+            const std::string &str = value.get_str();
+            if (IsLowerHex(str)) {
+                const std::vector<uint8_t> bytes = ParseHex(str);
+                WriteHead(out, BYTE_STRING, bytes.size());
+                out.append(bytes.begin(), bytes.end());
+            } else {
+                WriteHead(out, TEXT_STRING, str.size());
+                out.append(str);
+            }
+            return;
+        }
+        case UniValue::VARR:
+            WriteHead(out, ARRAY, value.size());
+            for (const UniValue &item : value.getValues()) {
+                Write(out, item);
+            }
+            return;
+        case UniValue::VOBJ: {
+            const std::vector<std::string> &keys = value.getKeys();
+            const std::vector<UniValue> &values = value.getValues();
+            WriteHead(out, MAP, keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                WriteHead(out, TEXT_STRING, keys[i].size());
+                out.append(keys[i]);
+                Write(out, values[i]);
+            }
+            return;
+        }
+    }
+}
+
+class Decoder {
+    Span<const uint8_t> data;
+    size_t pos{0};
+
+    size_t Remaining() const { return data.size() - pos; }
+
+    bool ReadHead(uint8_t &major, uint8_t &info, uint64_t &arg) {
+        if (Remaining() < 1) {
+            return false;
+        }
+        major = data[pos] >> 5;
+        info = data[pos] & 0x1f;
+        pos++;
+
+        if (info < 24) {
+            arg = info;
+            return true;
+        }
+        if (info > 27) {
+            // Reserved values and indefinite lengths
+            return false;
+        }
+
+        const size_t size = size_t(1) << (info - 24);
+        if (Remaining() < size) {
+            return false;
+        }
+        arg = 0;
+        for (size_t i = 0; i < size; i++) {
+            arg = (arg << 8) | data[pos++];
+        }
+        return true;
+    }
+
+    bool ReadInt(int64_t &value) {
+        uint8_t major, info;
+        uint64_t arg;
+        if (!ReadHead(major, info, arg) ||
+            arg > uint64_t(std::numeric_limits<int64_t>::max())) {
+            return false;
+        }
+        if (major == UNSIGNED_INT) {
+            value = arg;
+            return true;
+        }
+        if (major == NEGATIVE_INT) {
+            value = -1 - int64_t(arg);
+            return true;
+        }
+        return false;
+    }
+
+    bool ReadDecimalFraction(UniValue &value) {
+        uint8_t major, info;
+        uint64_t size;
+        if (!ReadHead(major, info, size) || major != ARRAY || size != 2) {
+            return false;
+        }
+        int64_t exponent, mantissa;
+        if (!ReadInt(exponent) || !ReadInt(mantissa) || exponent > 0 ||
+            uint64_t(-exponent) > MAX_DECIMAL_FRACTION_DIGITS) {
+            return false;
+        }
+        return value.setNumStr(FormatDecimal(mantissa, -exponent));
+    }
+
+    static double DecodeHalfFloat(uint16_t half) {
+        const int exp = (half >> 10) & 0x1f;
+        const int mant = half & 0x3ff;
+        double val;
+        if (exp == 0) {
+            val = std::ldexp(mant, -24);
+        } else if (exp != 31) {
+            val = std::ldexp(mant + 1024, exp - 25);
+        } else {
+            val = mant == 0 ? std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::quiet_NaN();
+        }
+        return half & 0x8000 ? -val : val;
+    }
+
+    bool ReadSimple(uint8_t info, uint64_t arg, UniValue &value) {
+        double real;
+        switch (info) {
+            case SIMPLE_FALSE:
+            case SIMPLE_TRUE:
+                value.setBool(info == SIMPLE_TRUE);
+                return true;
+            case SIMPLE_NULL:
+            case SIMPLE_UNDEFINED:
+                value.setNull();
+                return true;
+            case SIMPLE_FLOAT16:
+                real = DecodeHalfFloat(arg);
+                break;
+            case SIMPLE_FLOAT32: {
+                const uint32_t bits = arg;
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                real = f;
+                break;
+            }
+            case SIMPLE_FLOAT64:
+                std::memcpy(&real, &arg, sizeof(real));
+                break;
+            default:
+                return false;
+        }
+        // JSON has no representation for the infinites and NaN
+        return std::isfinite(real) && value.setFloat(real);
+    }
+
+    bool Read(UniValue &value, unsigned int depth) {
+        uint8_t major, info;
+        uint64_t arg;
+        if (!ReadHead(major, info, arg)) {
+            return false;
+        }
+
+        switch (major) {
+            case UNSIGNED_INT:
+                value = UniValue(arg);
+                return true;
+            case NEGATIVE_INT:
+                if (arg > uint64_t(std::numeric_limits<int64_t>::max())) {
+                    return false;
+                }
+                value = UniValue(-1 - int64_t(arg));
+                return true;
+            case BYTE_STRING:
+            case TEXT_STRING: {
+                if (arg > Remaining()) {
+                    return false;
+                }
+                const auto str = data.subspan(pos, arg);
+                pos += arg;
+                value = major == BYTE_STRING
+                            ? UniValue(HexStr(str))
+                            : UniValue(std::string(str.begin(), str.end()));
+                return true;
+            }
+            case ARRAY: {
+                // Each item is at least 1 byte long
+                if (depth >= MAX_CBOR_DEPTH || arg > Remaining()) {
+                    return false;
+                }
+                value.setArray();
+                value.reserve(arg);
+                for (uint64_t i = 0; i < arg; i++) {
+                    UniValue item;
+                    if (!Read(item, depth + 1)) {
+                        return false;
+                    }
+                    value.push_back(std::move(item));
+                }
+                return true;
+            }
+            case MAP: {
+                // Each key and value is at least 1 byte long
+                if (depth >= MAX_CBOR_DEPTH || arg > Remaining() / 2) {
+                    return false;
+                }
+                value.setObject();
+                value.reserve(arg);
+                for (uint64_t i = 0; i < arg; i++) {
+                    UniValue key;
+                    if (Remaining() < 1 || data[pos] >> 5 != TEXT_STRING ||
+                        !Read(key, depth + 1)) {
+                        return false;
+                    }
+                    UniValue item;
+                    if (!Read(item, depth + 1)) {
+                        return false;
+                    }
+                    value.__pushKV(key.get_str(), std::move(item));
+                }
+                return true;
+            }
+            case TAG:
+                return arg == TAG_DECIMAL_FRACTION &&
+                       ReadDecimalFraction(value);
+            case SIMPLE:
+                return ReadSimple(info, arg, value);
+        }
+        return false;
+    }
+
+public:
+    explicit Decoder(Span<const uint8_t> dataIn) : data(dataIn) {}
+
+    bool Decode(UniValue &value) {
+        return Read(value, 0) && Remaining() == 0;
+    }
+};
+
+} // namespace
+
+std::string EncodeCBOR(const UniValue &value) {
+    std::string out;
+    Write(out, value);
+    return out;
+}
+
+bool DecodeCBOR(Span<const uint8_t> data, UniValue &value) {
+    UniValue decoded;
+    if (!Decoder(data).Decode(decoded)) {
+        return false;
+    }
+    value = std::move(decoded);
+    return true;
+}
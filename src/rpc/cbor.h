@@ -0,0 +1,44 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_RPC_CBOR_H
+#define BITCOIN_RPC_CBOR_H
+
+#include <span.h>
+
+#include <univalue.h>
+
+#include <cstdint>
+#include <string>
+
+/** HTTP Content-Type of the CBOR encoded RPC requests and replies */
+static const std::string CBOR_CONTENT_TYPE = "application/cbor";
+
+/** Maximum nesting depth of the CBOR documents that can be decoded */
+static constexpr unsigned int MAX_CBOR_DEPTH = 512;
+
+/**
+ * Encode a UniValue as CBOR (RFC 8949), a compact binary alternative to the
+ * JSON serialization of the RPC requests and replies.
+ *
+ * The encoding is designed so that decoding gives back the exact same JSON:
+ *  - The strings made of an even number of lowercase hex digits, like the
+ *    hashes and the serialized blocks and transactions, are encoded as byte
+ *    strings, halving their size. They are decoded back to the same hex.
+ *  - The integers are encoded as CBOR integers.
+ *  - The fixed point numbers like the amounts are encoded as decimal
+ *    fractions (tag 4) so their exact representation is preserved.
+ *  - The other numbers are encoded as double precision floats.
+ *  - The objects are encoded as maps, with the keys in the same order.
+ */
+std::string EncodeCBOR(const UniValue &value);
+
+/**
+ * Decode a CBOR document produced by EncodeCBOR, or any CBOR document made of
+ * the same types with definite lengths. Returns false if the data is invalid
+ * or uses features that can't be represented in JSON.
+ */
+bool DecodeCBOR(Span<const uint8_t> data, UniValue &value);
+
+#endif // BITCOIN_RPC_CBOR_H
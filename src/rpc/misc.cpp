@@ -21,6 +21,8 @@
 #include <rpc/util.h>
 #include <scheduler.h>
 #include <script/descriptor.h>
+#include <script/scriptcache.h>
+#include <script/sigcache.h>
 #include <timedata.h>
 #include <util/check.h>
 #include <util/message.h> // For MessageSign(), MessageVerify()
@@ -647,6 +649,65 @@ static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     }
 }
 
+static UniValue ScriptCacheStatsToJSON(const ScriptCacheStats &stats) {
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("shards", uint64_t(stats.shards));
+    obj.pushKV("capacity", uint64_t(stats.capacity));
+    obj.pushKV("insertions", stats.insertions);
+    obj.pushKV("hits", stats.hits);
+    obj.pushKV("misses", stats.misses);
+    const uint64_t lookups = stats.hits + stats.misses;
+    obj.pushKV("hitrate", lookups > 0 ? double(stats.hits) / lookups : 0.);
+    obj.pushKV("contentions", stats.contentions);
+    return obj;
+}
+
+static RPCHelpMan getscriptcacheinfo() {
+    const std::vector<RPCResult> stats_results{
+        {RPCResult::Type::NUM, "shards",
+         "Number of independently locked shards"},
+        {RPCResult::Type::NUM, "capacity",
+         "Maximum number of entries the cache can hold"},
+        {RPCResult::Type::NUM, "insertions",
+         "Number of entries inserted since startup"},
+        {RPCResult::Type::NUM, "hits", "Number of successful lookups"},
+        {RPCResult::Type::NUM, "misses", "Number of failed lookups"},
+        {RPCResult::Type::NUM, "hitrate",
+         "Ratio of the successful lookups, between 0 and 1"},
+        {RPCResult::Type::NUM, "contentions",
+         "Number of accesses that had to wait for another thread to release "
+         "the lock of their shard"},
+    };
+
+    return RPCHelpMan{
+        "getscriptcacheinfo",
+        "Returns usage statistics of the signature and script execution "
+        "caches.\n",
+        {},
+        RPCResult{RPCResult::Type::OBJ,
+                  "",
+                  "",
+                  {
+                      {RPCResult::Type::OBJ, "signature",
+                       "Statistics of the signature cache", stats_results},
+                      {RPCResult::Type::OBJ, "script",
+                       "Statistics of the script execution cache",
+                       stats_results},
+                  }},
+        RPCExamples{HelpExampleCli("getscriptcacheinfo", "") +
+                    HelpExampleRpc("getscriptcacheinfo", "")},
+        [&](const RPCHelpMan &self, const Config &config,
+            const JSONRPCRequest &request) -> UniValue {
+            UniValue obj(UniValue::VOBJ);
+            obj.pushKV("signature",
+                       ScriptCacheStatsToJSON(GetSignatureCacheStats()));
+            obj.pushKV("script",
+                       ScriptCacheStatsToJSON(GetScriptExecutionCacheStats()));
+            return obj;
+        },
+    };
+}
+
 static RPCHelpMan logging() {
     return RPCHelpMan{
         "logging",
@@ -933,6 +994,7 @@ void RegisterMiscRPCCommands(CRPCTable &t) {
         //  category            actor (function)
         //  ------------------  ----------------------
         { "control",            getmemoryinfo,           },
+        { "control",            getscriptcacheinfo,      },
         { "control",            logging,                 },
         { "util",               validateaddress,         },
         { "util",               createmultisig,          },
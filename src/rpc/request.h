@@ -27,6 +27,31 @@ void DeleteAuthCookie();
 /** Parse JSON-RPC batch reply into a vector */
 std::vector<UniValue> JSONRPCProcessBatchReply(const UniValue &in);
 
+/**
+ * Sink receiving the serialized JSON result of a RPC call. The methods that can
+ * return very large results may write them incrementally to the stream when
+ * one is available, instead of building the whole UniValue tree. A method
+ * writing to the stream must write its complete result to it, and the value it
+ * returns is ignored.
+ */
+class RPCResultStream {
+public:
+    virtual ~RPCResultStream() {}
+
+    /** Append serialized JSON to the result. This never blocks. */
+    virtual void Write(const std::string &json) = 0;
+
+    /**
+     * Give the consumer a chance to catch up. This may block until enough of
+     * the previously written data is consumed, so don't call it while holding
+     * a lock.
+     */
+    virtual void Flush() = 0;
+
+    /** Whether something has been written to the stream. */
+    virtual bool IsStarted() const = 0;
+};
+
 class JSONRPCRequest {
 public:
     UniValue id;
@@ -37,6 +62,8 @@ public:
     std::string authUser;
     std::string peerAddr;
     std::any context;
+    //! Optional stream the result can be written to, not owned
+    RPCResultStream *resultStream = nullptr;
 
     void parse(const UniValue &valRequest);
 };
@@ -7,6 +7,7 @@
 #include <rpc/server.h>
 
 #include <config.h>
+#include <httpserver.h>
 #include <rpc/util.h>
 #include <shutdown.h>
 #include <sync.h>
@@ -276,6 +277,36 @@ static RPCHelpMan getrpcinfo() {
                        }},
                       {RPCResult::Type::STR, "logpath",
                        "The complete file path to the debug log"},
+                      {RPCResult::Type::OBJ_DYN,
+                       "work_queues",
+                       "The HTTP work queues statistics",
+                       {
+                           {RPCResult::Type::OBJ,
+                            "name",
+                            "The work queue name (rpc, rpc_slow or rest)",
+                            {
+                                {RPCResult::Type::NUM, "threads",
+                                 "The number of worker threads"},
+                                {RPCResult::Type::NUM, "depth",
+                                 "The number of requests in the queue"},
+                                {RPCResult::Type::NUM, "max_depth",
+                                 "The maximum number of requests in the "
+                                 "queue"},
+                                {RPCResult::Type::NUM, "processed",
+                                 "The number of processed requests"},
+                                {RPCResult::Type::NUM, "rejected",
+                                 "The number of requests rejected because "
+                                 "the queue was full"},
+                                HistogramRPCResult(
+                                    "queue_time",
+                                    "Time spent by the requests in the "
+                                    "queue, in microseconds"),
+                                HistogramRPCResult(
+                                    "run_time",
+                                    "Time spent processing the requests, in "
+                                    "microseconds"),
+                            }},
+                       }},
                   }},
         RPCExamples{HelpExampleCli("getrpcinfo", "") +
                     HelpExampleRpc("getrpcinfo", "")},
@@ -299,6 +330,20 @@ static RPCHelpMan getrpcinfo() {
             UniValue log_path(UniValue::VSTR, path);
             result.pushKV("logpath", log_path);
 
+            UniValue work_queues(UniValue::VOBJ);
+            for (const HTTPWorkQueueStats &stats : GetHTTPWorkQueueStats()) {
+                UniValue queue(UniValue::VOBJ);
+                queue.pushKV("threads", stats.threads);
+                queue.pushKV("depth", uint64_t(stats.depth));
+                queue.pushKV("max_depth", uint64_t(stats.max_depth));
+                queue.pushKV("processed", stats.processed);
+                queue.pushKV("rejected", stats.rejected);
+                queue.pushKV("queue_time", HistogramToJSON(stats.queue_time));
+                queue.pushKV("run_time", HistogramToJSON(stats.run_time));
+                work_queues.pushKV(HTTPWorkQueueTypeName(stats.type), queue);
+            }
+            result.pushKV("work_queues", work_queues);
+
             return result;
         }};
 }
@@ -429,14 +474,31 @@ static UniValue JSONRPCExecOne(const Config &config, RPCServer &rpcServer,
     return rpc_result;
 }
 
-std::string JSONRPCExecBatch(const Config &config, RPCServer &rpcServer,
-                             const JSONRPCRequest &jreq, const UniValue &vReq) {
-    UniValue ret(UniValue::VARR);
-    for (size_t i = 0; i < vReq.size(); i++) {
-        ret.push_back(JSONRPCExecOne(config, rpcServer, jreq, vReq[i]));
+UniValue JSONRPCExecBatch(const Config &config, RPCServer &rpcServer,
+                          const JSONRPCRequest &jreq, const UniValue &vReq,
+                          const RPCParallelRunner &runner) {
+    // Each request writes its own slot so the replies order matches the
+    // requests order regardless of the execution order.
+    std::vector<UniValue> replies(vReq.size());
+    if (runner && vReq.size() > 1) {
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(vReq.size());
+        for (size_t i = 0; i < vReq.size(); i++) {
+            tasks.emplace_back([&, i]() {
+                replies[i] = JSONRPCExecOne(config, rpcServer, jreq, vReq[i]);
+            });
+        }
+        runner(tasks);
+    } else {
+        for (size_t i = 0; i < vReq.size(); i++) {
+            replies[i] = JSONRPCExecOne(config, rpcServer, jreq, vReq[i]);
+        }
     }
 
-    return ret.write() + "\n";
+    UniValue ret(UniValue::VARR);
+    ret.push_backV(replies);
+
+    return ret;
 }
 
 /**
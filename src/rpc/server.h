@@ -19,6 +19,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 static const unsigned int DEFAULT_RPC_SERIALIZE_VERSION = 1;
 
@@ -233,8 +234,22 @@ extern CRPCTable tableRPC;
 void StartRPC();
 void InterruptRPC();
 void StopRPC();
-std::string JSONRPCExecBatch(const Config &config, RPCServer &rpcServer,
-                             const JSONRPCRequest &req, const UniValue &vReq);
+
+/**
+ * Run a set of independent tasks, possibly in parallel, and return once they
+ * are all completed.
+ */
+using RPCParallelRunner =
+    std::function<void(const std::vector<std::function<void()>> &tasks)>;
+
+/**
+ * Execute a batch of requests and return the array of replies, in the same
+ * order as the requests. If a runner is provided, it is used to execute the
+ * requests in parallel.
+ */
+UniValue JSONRPCExecBatch(const Config &config, RPCServer &rpcServer,
+                          const JSONRPCRequest &req, const UniValue &vReq,
+                          const RPCParallelRunner &runner = nullptr);
 
 /**
  * Retrieves any serialization flags requested in command line argument
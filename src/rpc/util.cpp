@@ -568,6 +568,11 @@ UniValue RPCHelpMan::HandleRequest(const Config &config,
         throw std::runtime_error(ToString());
     }
     const UniValue ret = m_fun(*this, config, request);
+    if (request.resultStream && request.resultStream->IsStarted()) {
+        // The result has been written to the stream instead
+        CHECK_NONFATAL(ret.isNull());
+        return ret;
+    }
     CHECK_NONFATAL(std::any_of(
         m_results.m_results.begin(), m_results.m_results.end(),
         [ret](const RPCResult &res) { return res.MatchesType(ret); }));
@@ -1079,3 +1084,64 @@ UniValue GetServicesNames(ServiceFlags services) {
 
     return servicesNames;
 }
+
+UniValue HistogramToJSON(const Log2Histogram &histogram) {
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("count", histogram.GetCount());
+    ret.pushKV("mean", histogram.GetMean());
+    ret.pushKV("max", histogram.GetMax());
+    ret.pushKV("p50", histogram.GetPercentileUpperBound(50));
+    ret.pushKV("p90", histogram.GetPercentileUpperBound(90));
+    ret.pushKV("p99", histogram.GetPercentileUpperBound(99));
+
+    UniValue buckets(UniValue::VARR);
+    const auto &counts = histogram.GetBuckets();
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        UniValue bucket(UniValue::VOBJ);
+        if (i < counts.size() - 1) {
+            bucket.pushKV("max", Log2Histogram::GetBucketUpperBound(i));
+        }
+        bucket.pushKV("count", counts[i]);
+        buckets.push_back(bucket);
+    }
+    ret.pushKV("buckets", buckets);
+
+    return ret;
+}
+
+RPCResult HistogramRPCResult(const std::string &key_name,
+                             const std::string &description) {
+    return RPCResult{
+        RPCResult::Type::OBJ,
+        key_name,
+        description,
+        {
+            {RPCResult::Type::NUM, "count", "The number of recorded values"},
+            {RPCResult::Type::NUM, "mean", "The mean of the recorded values"},
+            {RPCResult::Type::NUM, "max", "The maximum recorded value"},
+            {RPCResult::Type::NUM, "p50",
+             "An upper bound of the median of the recorded values"},
+            {RPCResult::Type::NUM, "p90",
+             "An upper bound of the 90th percentile of the recorded values"},
+            {RPCResult::Type::NUM, "p99",
+             "An upper bound of the 99th percentile of the recorded values"},
+            {RPCResult::Type::ARR,
+             "buckets",
+             "The non empty buckets of the histogram",
+             {
+                 {RPCResult::Type::OBJ,
+                  "",
+                  "",
+                  {
+                      {RPCResult::Type::NUM, "max", /* optional */ true,
+                       "The upper bound of the values in this bucket, absent "
+                       "for the last bucket"},
+                      {RPCResult::Type::NUM, "count",
+                       "The number of values in this bucket"},
+                  }},
+             }},
+        }};
+}
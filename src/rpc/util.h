@@ -16,6 +16,7 @@
 #include <script/standard.h> // For CTxDestination
 #include <univalue.h>
 #include <util/check.h>
+#include <util/histogram.h>
 
 #include <string>
 #include <variant>
@@ -125,6 +126,12 @@ EvalDescriptorStringOrObject(const UniValue &scanobject,
  */
 UniValue GetServicesNames(ServiceFlags services);
 
+/**
+ * Summarize a histogram: count, mean, max, percentiles upper bounds and the
+ * non empty buckets.
+ */
+UniValue HistogramToJSON(const Log2Histogram &histogram);
+
 /**
  * Serializing JSON objects depends on the outer type. Only arrays and
  * dictionaries can be nested in json. The top-level outer type is "NONE".
@@ -329,6 +336,10 @@ struct RPCResults {
     std::string ToDescriptionString() const;
 };
 
+/** Describe the object returned by HistogramToJSON. */
+RPCResult HistogramRPCResult(const std::string &key_name,
+                             const std::string &description);
+
 struct RPCExamples {
     const std::string m_examples;
     explicit RPCExamples(std::string examples)
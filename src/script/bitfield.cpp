@@ -9,8 +9,8 @@
 #include <cstddef>
 #include <limits>
 
-bool DecodeBitfield(const std::vector<uint8_t> &vch, unsigned size,
-                    uint32_t &bitfield, ScriptError *serror) {
+bool DecodeBitfield(Span<const uint8_t> vch, unsigned size, uint32_t &bitfield,
+                    ScriptError *serror) {
     if (size > 32) {
         return set_error(serror, ScriptError::INVALID_BITFIELD_SIZE);
     }
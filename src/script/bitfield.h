@@ -5,12 +5,13 @@
 #ifndef BITCOIN_SCRIPT_BITFIELD_H
 #define BITCOIN_SCRIPT_BITFIELD_H
 
+#include <span.h>
+
 #include <cstdint>
-#include <vector>
 
 enum class ScriptError;
 
-bool DecodeBitfield(const std::vector<uint8_t> &vch, unsigned size,
-                    uint32_t &bitfield, ScriptError *serror);
+bool DecodeBitfield(Span<const uint8_t> vch, unsigned size, uint32_t &bitfield,
+                    ScriptError *serror);
 
 #endif // BITCOIN_SCRIPT_BITFIELD_H
@@ -9,14 +9,21 @@
 #include <crypto/ripemd160.h>
 #include <crypto/sha1.h>
 #include <crypto/sha256.h>
+#include <hash.h>
 #include <pubkey.h>
 #include <script/bitfield.h>
 #include <script/script.h>
 #include <script/sigencoding.h>
+#include <streams.h>
 #include <uint256.h>
 #include <util/bitmanip.h>
 
-bool CastToBool(const valtype &vch) {
+#include <algorithm>
+#include <array>
+
+typedef StackElement valtype;
+
+bool CastToBool(Span<const uint8_t> vch) {
     for (size_t i = 0; i < vch.size(); i++) {
         if (vch[i] != 0) {
             // Can be negative zero
@@ -70,13 +77,14 @@ int FindAndDelete(CScript &script, const CScript &b) {
     return nFound;
 }
 
-static void CleanupScriptCode(CScript &scriptCode,
-                              const std::vector<uint8_t> &vchSig,
+static void CleanupScriptCode(CScript &scriptCode, Span<const uint8_t> vchSig,
                               uint32_t flags) {
     // Drop the signature in scripts when SIGHASH_FORKID is not used.
     SigHashType sigHashType = GetHashType(vchSig);
     if (!(flags & SCRIPT_ENABLE_SIGHASH_FORKID) || !sigHashType.hasForkId()) {
-        FindAndDelete(scriptCode, CScript() << vchSig);
+        FindAndDelete(scriptCode,
+                      CScript() << std::vector<uint8_t>(vchSig.begin(),
+                                                        vchSig.end()));
     }
 }
 
@@ -170,7 +178,8 @@ public:
  * returned, the fSuccess variable indicates whether the signature check itself
  * succeeded.
  */
-static bool EvalChecksig(const valtype &vchSig, const valtype &vchPubKey,
+static bool EvalChecksig(Span<const uint8_t> vchSig,
+                         Span<const uint8_t> vchPubKey,
                          CScript::const_iterator pbegincodehash,
                          CScript::const_iterator pend, uint32_t flags,
                          const BaseSignatureChecker &checker,
@@ -206,13 +215,13 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
     static const CScriptNum bnZero(0);
     static const CScriptNum bnOne(1);
     static const valtype vchFalse(0);
-    static const valtype vchTrue(1, 1);
+    static const valtype vchTrue(1, uint8_t(1));
 
     CScript::const_iterator pc = script.begin();
     CScript::const_iterator pend = script.end();
     CScript::const_iterator pbegincodehash = script.begin();
     opcodetype opcode;
-    valtype vchPushValue;
+    Span<const uint8_t> vchPushValue;
     ConditionStack vfExec;
     std::vector<valtype> altstack;
     set_error(serror, ScriptError::UNKNOWN);
@@ -251,7 +260,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                     !CheckMinimalPush(vchPushValue, opcode)) {
                     return set_error(serror, ScriptError::MINIMALDATA);
                 }
-                stack.push_back(vchPushValue);
+                stack.emplace_back(vchPushValue.begin(), vchPushValue.end());
             } else if (fExec || (OP_IF <= opcode && opcode <= OP_ENDIF)) {
                 switch (opcode) {
                     //
@@ -276,7 +285,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                     case OP_16: {
                         // ( -- value)
                         CScriptNum bn((int)opcode - (int)(OP_1 - 1));
-                        stack.push_back(bn.getvch());
+                        stack.push_back(bn.getvch<valtype>());
                         // The result of these opcodes should always be the
                         // minimal way to push the data they push, so no need
                         // for a CheckMinimalPush here.
@@ -545,8 +554,8 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                             return set_error(
                                 serror, ScriptError::INVALID_STACK_OPERATION);
                         }
-                        swap(stacktop(-4), stacktop(-2));
-                        swap(stacktop(-3), stacktop(-1));
+                        std::swap(stacktop(-4), stacktop(-2));
+                        std::swap(stacktop(-3), stacktop(-1));
                     } break;
 
                     case OP_IFDUP: {
@@ -564,7 +573,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                     case OP_DEPTH: {
                         // -- stacksize
                         CScriptNum bn(stack.size());
-                        stack.push_back(bn.getvch());
+                        stack.push_back(bn.getvch<valtype>());
                     } break;
 
                     case OP_DROP: {
@@ -635,8 +644,8 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                             return set_error(
                                 serror, ScriptError::INVALID_STACK_OPERATION);
                         }
-                        swap(stacktop(-3), stacktop(-2));
-                        swap(stacktop(-2), stacktop(-1));
+                        std::swap(stacktop(-3), stacktop(-2));
+                        std::swap(stacktop(-2), stacktop(-1));
                     } break;
 
                     case OP_SWAP: {
@@ -645,7 +654,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                             return set_error(
                                 serror, ScriptError::INVALID_STACK_OPERATION);
                         }
-                        swap(stacktop(-2), stacktop(-1));
+                        std::swap(stacktop(-2), stacktop(-1));
                     } break;
 
                     case OP_TUCK: {
@@ -665,7 +674,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                                 serror, ScriptError::INVALID_STACK_OPERATION);
                         }
                         CScriptNum bn(stacktop(-1).size());
-                        stack.push_back(bn.getvch());
+                        stack.push_back(bn.getvch<valtype>());
                     } break;
 
                     //
@@ -788,7 +797,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                                 break;
                         }
                         popstack(stack);
-                        stack.push_back(bn.getvch());
+                        stack.push_back(bn.getvch<valtype>());
                     } break;
 
                     case OP_ADD:
@@ -880,7 +889,7 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
                         }
                         popstack(stack);
                         popstack(stack);
-                        stack.push_back(bn.getvch());
+                        stack.push_back(bn.getvch<valtype>());
 
                         if (opcode == OP_NUMEQUALVERIFY) {
                             if (CastToBool(stacktop(-1))) {
@@ -1003,12 +1012,14 @@ bool EvalScript(std::vector<valtype> &stack, const CScript &script,
 
                         bool fSuccess = false;
                         if (vchSig.size()) {
-                            valtype vchHash(32);
+                            uint256 messageHash;
                             CSHA256()
                                 .Write(vchMessage.data(), vchMessage.size())
-                                .Finalize(vchHash.data());
+                                .Finalize(messageHash.begin());
                             fSuccess = checker.VerifySignature(
-                                vchSig, CPubKey(vchPubKey), uint256(vchHash));
+                                vchSig,
+                                CPubKey(vchPubKey.begin(), vchPubKey.end()),
+                                messageHash);
                             metrics.nSigChecks += 1;
 
                             if (!fSuccess && (flags & SCRIPT_VERIFY_NULLFAIL)) {
@@ -1562,6 +1573,69 @@ template PrecomputedTransactionData::PrecomputedTransactionData(
 template PrecomputedTransactionData::PrecomputedTransactionData(
     const CMutableTransaction &txTo);
 
+/**
+ * Maximum size of the serialized data hashed at once by
+ * PrecomputeTransactionsData, to bound the memory used by very large blocks.
+ */
+static constexpr size_t MAX_PRECOMPUTE_BATCH_SIZE = 1 << 20;
+
+std::vector<PrecomputedTransactionData>
+PrecomputeTransactionsData(Span<const CTransactionRef> txs) {
+    std::vector<PrecomputedTransactionData> txsdata(txs.size());
+
+    // Each transaction is made of 3 messages: the prevouts, the sequences and
+    // the outputs.
+    std::vector<uint8_t> serialized;
+    std::vector<size_t> ends;
+    std::vector<const uint8_t *> inputs;
+    std::vector<size_t> lengths;
+    std::vector<uint256> hashes;
+    size_t begin = 0;
+    while (begin < txs.size()) {
+        serialized.clear();
+        ends.clear();
+        size_t end = begin;
+        while (end < txs.size() &&
+               serialized.size() < MAX_PRECOMPUTE_BATCH_SIZE) {
+            const CTransaction &tx = *txs[end++];
+            CVectorWriter writer(SER_GETHASH, 0, serialized, serialized.size());
+            for (const auto &txin : tx.vin) {
+                writer << txin.prevout;
+            }
+            ends.push_back(serialized.size());
+            for (const auto &txin : tx.vin) {
+                writer << txin.nSequence;
+            }
+            ends.push_back(serialized.size());
+            for (const auto &txout : tx.vout) {
+                writer << txout;
+            }
+            ends.push_back(serialized.size());
+        }
+
+        const size_t count = ends.size();
+        inputs.resize(count);
+        lengths.resize(count);
+        hashes.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const size_t start = i > 0 ? ends[i - 1] : 0;
+            inputs[i] = serialized.data() + start;
+            lengths[i] = ends[i] - start;
+        }
+        SHA256DMulti(hashes[0].begin(), inputs.data(), lengths.data(), count);
+
+        for (size_t i = begin; i < end; i++) {
+            const uint256 *txhashes = &hashes[3 * (i - begin)];
+            txsdata[i].hashPrevouts = txhashes[0];
+            txsdata[i].hashSequence = txhashes[1];
+            txsdata[i].hashOutputs = txhashes[2];
+        }
+        begin = end;
+    }
+
+    return txsdata;
+}
+
 template <class T>
 uint256 SignatureHash(const CScript &scriptCode, const T &txTo,
                       unsigned int nIn, SigHashType sigHashType,
@@ -1643,7 +1717,7 @@ uint256 SignatureHash(const CScript &scriptCode, const T &txTo,
     return ss.GetHash();
 }
 
-bool BaseSignatureChecker::VerifySignature(const std::vector<uint8_t> &vchSig,
+bool BaseSignatureChecker::VerifySignature(Span<const uint8_t> vchSig,
                                            const CPubKey &pubkey,
                                            const uint256 &sighash) const {
     if (vchSig.size() == 64) {
@@ -1655,20 +1729,19 @@ bool BaseSignatureChecker::VerifySignature(const std::vector<uint8_t> &vchSig,
 
 template <class T>
 bool GenericTransactionSignatureChecker<T>::CheckSig(
-    const std::vector<uint8_t> &vchSigIn, const std::vector<uint8_t> &vchPubKey,
+    Span<const uint8_t> vchSigIn, Span<const uint8_t> vchPubKey,
     const CScript &scriptCode, uint32_t flags) const {
-    CPubKey pubkey(vchPubKey);
+    CPubKey pubkey(vchPubKey.begin(), vchPubKey.end());
     if (!pubkey.IsValid()) {
         return false;
     }
 
     // Hash type is one byte tacked on to the end of the signature
-    std::vector<uint8_t> vchSig(vchSigIn);
-    if (vchSig.empty()) {
+    if (vchSigIn.empty()) {
         return false;
     }
-    SigHashType sigHashType = GetHashType(vchSig);
-    vchSig.pop_back();
+    SigHashType sigHashType = GetHashType(vchSigIn);
+    Span<const uint8_t> vchSig = vchSigIn.first(vchSigIn.size() - 1);
 
     uint256 sighash = SignatureHash(scriptCode, *txTo, nIn, sigHashType, amount,
                                     this->txdata, flags);
@@ -1774,9 +1847,326 @@ bool GenericTransactionSignatureChecker<T>::CheckSequence(
 template class GenericTransactionSignatureChecker<CTransaction>;
 template class GenericTransactionSignatureChecker<CMutableTransaction>;
 
+namespace {
+/**
+ * The largest number of data pushes in the scriptSig of a standard template,
+ * i.e. the dummy element, a signature for each key and the redeem script of a
+ * 16 keys P2SH multisig.
+ */
+constexpr size_t MAX_STANDARD_SCRIPTSIG_PUSHES = 16 + 2;
+
+/** The data pushed by a scriptSig, pointing into the script. */
+struct ScriptSigPushes {
+    std::array<Span<const uint8_t>, MAX_STANDARD_SCRIPTSIG_PUSHES> data;
+    size_t size = 0;
+};
+} // namespace
+
+/**
+ * Get the data pushed by a scriptSig, if it is only made of push opcodes that
+ * EvalScript accepts.
+ */
+static bool GetStandardScriptSigPushes(const CScript &scriptSig,
+                                       uint32_t flags,
+                                       ScriptSigPushes &pushes) {
+    if (scriptSig.size() > MAX_SCRIPT_SIZE) {
+        return false;
+    }
+
+    // The data pushed by OP_1NEGATE, OP_RESERVED (unused) and OP_1 to OP_16
+    static const std::array<uint8_t, OP_16 - OP_1NEGATE + 1> smallIntegers{
+        {0x81, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+
+    const bool fRequireMinimal = (flags & SCRIPT_VERIFY_MINIMALDATA) != 0;
+    CScript::const_iterator pc = scriptSig.begin();
+    opcodetype opcode;
+    Span<const uint8_t> data;
+    while (pc < scriptSig.end()) {
+        if (pushes.size == pushes.data.size() ||
+            !scriptSig.GetOp(pc, opcode, data) || opcode > OP_16 ||
+            opcode == OP_RESERVED) {
+            return false;
+        }
+
+        if (opcode >= OP_1NEGATE) {
+            // Like the Schnorr multisig bitfield
+            pushes.data[pushes.size++] =
+                Span<const uint8_t>(&smallIntegers[opcode - OP_1NEGATE], 1);
+            continue;
+        }
+
+        if (data.size() > MAX_SCRIPT_ELEMENT_SIZE ||
+            (fRequireMinimal && !CheckMinimalPush(data, opcode))) {
+            return false;
+        }
+
+        pushes.data[pushes.size++] = data;
+    }
+
+    return true;
+}
+
+static bool IsPayToPubKeyHash(const CScript &script) {
+    // OP_DUP OP_HASH160 <20 bytes> OP_EQUALVERIFY OP_CHECKSIG
+    return script.size() == 25 && script[0] == OP_DUP &&
+           script[1] == OP_HASH160 && script[2] == 20 &&
+           script[23] == OP_EQUALVERIFY && script[24] == OP_CHECKSIG;
+}
+
+static bool IsPayToPubKey(const CScript &script) {
+    // <33 or 65 bytes> OP_CHECKSIG
+    return (script.size() == CPubKey::COMPRESSED_SIZE + 2 ||
+            script.size() == CPubKey::SIZE + 2) &&
+           script[0] == script.size() - 2 && script.back() == OP_CHECKSIG;
+}
+
+static bool MatchesHash160(Span<const uint8_t> data,
+                           CScript::const_iterator hash) {
+    std::array<uint8_t, CHash160::OUTPUT_SIZE> dataHash;
+    CHash160().Write(data).Finalize(dataHash);
+    return std::equal(dataHash.begin(), dataHash.end(), hash);
+}
+
+/**
+ * Get the public keys and the number of required signatures of a redeem
+ * script made of OP_m <pubkey> ... <pubkey> OP_n OP_CHECKMULTISIG, with
+ * 1 <= m <= n.
+ */
+static bool MatchMultisigRedeemScript(Span<const uint8_t> script, int &nSigs,
+                                      std::vector<Span<const uint8_t>> &keys) {
+    if (script.size() < 3 || script.back() != OP_CHECKMULTISIG ||
+        script[0] < OP_1 || script[0] > OP_16) {
+        return false;
+    }
+    nSigs = script[0] - (OP_1 - 1);
+
+    size_t pos = 1;
+    while (pos < script.size() && (script[pos] == CPubKey::COMPRESSED_SIZE ||
+                                   script[pos] == CPubKey::SIZE)) {
+        const size_t keySize = script[pos];
+        if (script.size() - pos - 1 < keySize) {
+            return false;
+        }
+        keys.push_back(script.subspan(pos + 1, keySize));
+        pos += 1 + keySize;
+    }
+
+    // OP_n OP_CHECKMULTISIG
+    return pos + 2 == script.size() && script[pos] >= OP_1 &&
+           script[pos] <= OP_16 &&
+           size_t(script[pos] - (OP_1 - 1)) == keys.size() &&
+           size_t(nSigs) <= keys.size();
+}
+
+/**
+ * Evaluate the OP_CHECKMULTISIG of a standard multisig redeem script, exactly
+ * like EvalScript does.
+ */
+static bool EvalStandardMultisig(const ScriptSigPushes &pushes, int nSigsCount,
+                                 const std::vector<Span<const uint8_t>> &keys,
+                                 const CScript &scriptCode, uint32_t flags,
+                                 const BaseSignatureChecker &checker,
+                                 ScriptExecutionMetrics &metrics,
+                                 ScriptError *serror, bool &fSuccess) {
+    const int nKeysCount = keys.size();
+    const Span<const uint8_t> dummy = pushes.data[0];
+
+    // The signatures are pushed between the dummy element and the redeem
+    // script, in the order of the keys.
+    const Span<const Span<const uint8_t>> sigs(pushes.data.data() + 1,
+                                               nSigsCount);
+
+    if ((flags & SCRIPT_ENABLE_SCHNORR_MULTISIG) && dummy.size() != 0) {
+        // SCHNORR MULTISIG
+        uint32_t checkBits = 0;
+        if (!DecodeBitfield(dummy, nKeysCount, checkBits, serror)) {
+            // serror is set
+            return false;
+        }
+
+        if (countBits(checkBits) != uint32_t(nSigsCount)) {
+            return set_error(serror, ScriptError::INVALID_BIT_COUNT);
+        }
+
+        // The bitfield has exactly nSigsCount bits set within the keys range,
+        // so there is always a key for each signature.
+        int iKey = 0;
+        for (int iSig = 0; iSig < nSigsCount; iSig++, iKey++) {
+            while (((checkBits >> iKey) & 0x01) == 0) {
+                iKey++;
+            }
+
+            const Span<const uint8_t> vchSig = sigs[iSig];
+            const Span<const uint8_t> vchPubKey = keys[iKey];
+            if (!CheckTransactionSchnorrSignatureEncoding(vchSig, flags,
+                                                          serror) ||
+                !CheckPubKeyEncoding(vchPubKey, flags, serror)) {
+                // serror is set
+                return false;
+            }
+
+            if (!checker.CheckSig(vchSig, vchPubKey, scriptCode, flags)) {
+                return set_error(serror, ScriptError::SIG_NULLFAIL);
+            }
+
+            metrics.nSigChecks += 1;
+        }
+
+        fSuccess = true;
+        return true;
+    }
+
+    // LEGACY MULTISIG (ECDSA / NULL), the signatures and keys are checked
+    // starting from the top of the stack.
+    CScript legacyScriptCode = scriptCode;
+    for (int k = nSigsCount - 1; k >= 0; k--) {
+        CleanupScriptCode(legacyScriptCode, sigs[k], flags);
+    }
+
+    fSuccess = true;
+    int nSigsRemaining = nSigsCount;
+    int nKeysRemaining = nKeysCount;
+    while (fSuccess && nSigsRemaining > 0) {
+        const Span<const uint8_t> vchSig = sigs[nSigsRemaining - 1];
+        const Span<const uint8_t> vchPubKey = keys[nKeysRemaining - 1];
+
+        if (!CheckTransactionECDSASignatureEncoding(vchSig, flags, serror) ||
+            !CheckPubKeyEncoding(vchPubKey, flags, serror)) {
+            // serror is set
+            return false;
+        }
+
+        if (checker.CheckSig(vchSig, vchPubKey, legacyScriptCode, flags)) {
+            nSigsRemaining--;
+        }
+        nKeysRemaining--;
+
+        if (nSigsRemaining > nKeysRemaining) {
+            fSuccess = false;
+        }
+    }
+
+    const bool areAllSignaturesNull =
+        std::all_of(sigs.begin(), sigs.end(),
+                    [](Span<const uint8_t> sig) { return sig.empty(); });
+    if (!fSuccess && (flags & SCRIPT_VERIFY_NULLFAIL) &&
+        !areAllSignaturesNull) {
+        return set_error(serror, ScriptError::SIG_NULLFAIL);
+    }
+
+    if (!areAllSignaturesNull) {
+        metrics.nSigChecks += nKeysCount;
+    }
+
+    return true;
+}
+
+std::optional<bool> VerifyStandardScript(const CScript &scriptSig,
+                                         const CScript &scriptPubKey,
+                                         uint32_t flags,
+                                         const BaseSignatureChecker &checker,
+                                         ScriptExecutionMetrics &metricsOut,
+                                         ScriptError *serror) {
+    // If FORKID is enabled, we also ensure strict encoding.
+    if (flags & SCRIPT_ENABLE_SIGHASH_FORKID) {
+        flags |= SCRIPT_VERIFY_STRICTENC;
+    }
+
+    // A scriptSig made of data pushes only passes the SIGPUSHONLY check.
+    ScriptSigPushes pushes;
+    if (!GetStandardScriptSigPushes(scriptSig, flags, pushes)) {
+        return std::nullopt;
+    }
+
+    ScriptExecutionMetrics metrics = {};
+    bool fSuccess = false;
+    if (IsPayToPubKeyHash(scriptPubKey)) {
+        // <sig> <pubkey>
+        if (pushes.size != 2 ||
+            !MatchesHash160(pushes.data[1], scriptPubKey.begin() + 3)) {
+            return std::nullopt;
+        }
+
+        if (!EvalChecksig(pushes.data[0], pushes.data[1], scriptPubKey.begin(),
+                          scriptPubKey.end(), flags, checker, metrics, serror,
+                          fSuccess)) {
+            return false;
+        }
+    } else if (IsPayToPubKey(scriptPubKey)) {
+        // <sig>
+        if (pushes.size != 1) {
+            return std::nullopt;
+        }
+
+        const Span<const uint8_t> vchPubKey(scriptPubKey.data() + 1,
+                                            scriptPubKey.size() - 2);
+        if (!EvalChecksig(pushes.data[0], vchPubKey, scriptPubKey.begin(),
+                          scriptPubKey.end(), flags, checker, metrics, serror,
+                          fSuccess)) {
+            return false;
+        }
+    } else if ((flags & SCRIPT_VERIFY_P2SH) &&
+               scriptPubKey.IsPayToScriptHash()) {
+        // <dummy> <sig> ... <sig> <redeem script>
+        if (pushes.size < 3) {
+            return std::nullopt;
+        }
+
+        const Span<const uint8_t> redeemScript = pushes.data[pushes.size - 1];
+        int nSigsCount;
+        std::vector<Span<const uint8_t>> keys;
+        if (!MatchesHash160(redeemScript, scriptPubKey.begin() + 2) ||
+            !MatchMultisigRedeemScript(redeemScript, nSigsCount, keys) ||
+            pushes.size != size_t(nSigsCount) + 2) {
+            return std::nullopt;
+        }
+
+        const CScript scriptCode(redeemScript.begin(), redeemScript.end());
+        if (!EvalStandardMultisig(pushes, nSigsCount, keys, scriptCode, flags,
+                                  checker, metrics, serror, fSuccess)) {
+            return false;
+        }
+    } else {
+        return std::nullopt;
+    }
+
+    if (!fSuccess) {
+        return set_error(serror, ScriptError::EVAL_FALSE);
+    }
+
+    // The templates always leave a single element on the stack, so they pass
+    // the CLEANSTACK check.
+    assert(!(flags & SCRIPT_VERIFY_CLEANSTACK) || (flags & SCRIPT_VERIFY_P2SH));
+
+    // Same as VerifyScript
+    if ((flags & SCRIPT_VERIFY_INPUT_SIGCHECKS) &&
+        int(scriptSig.size()) < metrics.nSigChecks * 43 - 60) {
+        return set_error(serror, ScriptError::INPUT_SIGCHECKS);
+    }
+
+    metricsOut = metrics;
+    return set_success(serror);
+}
+
 bool VerifyScript(const CScript &scriptSig, const CScript &scriptPubKey,
                   uint32_t flags, const BaseSignatureChecker &checker,
                   ScriptExecutionMetrics &metricsOut, ScriptError *serror) {
+    // Most of the inputs spend standard outputs, which don't need the generic
+    // interpreter.
+    if (const std::optional<bool> ret = VerifyStandardScript(
+            scriptSig, scriptPubKey, flags, checker, metricsOut, serror)) {
+        return *ret;
+    }
+
+    return VerifyScriptWithInterpreter(scriptSig, scriptPubKey, flags, checker,
+                                       metricsOut, serror);
+}
+
+bool VerifyScriptWithInterpreter(const CScript &scriptSig,
+                                 const CScript &scriptPubKey, uint32_t flags,
+                                 const BaseSignatureChecker &checker,
+                                 ScriptExecutionMetrics &metricsOut,
+                                 ScriptError *serror) {
     set_error(serror, ScriptError::UNKNOWN);
 
     // If FORKID is enabled, we also ensure strict encoding.
@@ -1827,7 +2217,8 @@ bool VerifyScript(const CScript &scriptSig, const CScript &scriptPubKey,
         assert(!stack.empty());
 
         const valtype &pubKeySerialized = stack.back();
-        CScript pubKey2(pubKeySerialized.begin(), pubKeySerialized.end());
+        CScript pubKey2(pubKeySerialized.data(),
+                        pubKeySerialized.data() + pubKeySerialized.size());
         popstack(stack);
 
         // Bail out early if SCRIPT_DISALLOW_SEGWIT_RECOVERY is not set, the
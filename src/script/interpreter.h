@@ -7,13 +7,16 @@
 #ifndef BITCOIN_SCRIPT_INTERPRETER_H
 #define BITCOIN_SCRIPT_INTERPRETER_H
 
+#include <prevector.h>
 #include <primitives/transaction.h>
 #include <script/script_error.h>
 #include <script/script_flags.h>
 #include <script/script_metrics.h>
 #include <script/sighashtype.h>
+#include <span.h>
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 class CPubKey;
@@ -28,14 +31,31 @@ uint256 SignatureHash(const CScript &scriptCode, const T &txTo,
                       const PrecomputedTransactionData *cache = nullptr,
                       uint32_t flags = SCRIPT_ENABLE_SIGHASH_FORKID);
 
+/**
+ * Compute the PrecomputedTransactionData of many transactions at once, so the
+ * hashes of all of them can be computed in parallel (see SHA256DMulti).
+ */
+std::vector<PrecomputedTransactionData>
+PrecomputeTransactionsData(Span<const CTransactionRef> txs);
+
+/**
+ * Number of bytes a script stack element can hold without allocating memory.
+ * This covers the signatures with their hash type, the public keys and the
+ * hashes, which make up most of the stack elements.
+ */
+static constexpr unsigned int STACK_ELEMENT_INLINE_SIZE = 76;
+
+/** An element of the script interpreter stack */
+typedef prevector<STACK_ELEMENT_INLINE_SIZE, uint8_t> StackElement;
+
 class BaseSignatureChecker {
 public:
-    virtual bool VerifySignature(const std::vector<uint8_t> &vchSig,
+    virtual bool VerifySignature(Span<const uint8_t> vchSig,
                                  const CPubKey &vchPubKey,
                                  const uint256 &sighash) const;
 
-    virtual bool CheckSig(const std::vector<uint8_t> &vchSigIn,
-                          const std::vector<uint8_t> &vchPubKey,
+    virtual bool CheckSig(Span<const uint8_t> vchSigIn,
+                          Span<const uint8_t> vchPubKey,
                           const CScript &scriptCode, uint32_t flags) const {
         return false;
     }
@@ -69,8 +89,7 @@ public:
         : txTo(txToIn), nIn(nInIn), amount(amountIn), txdata(&txdataIn) {}
 
     // The overridden functions are now final.
-    bool CheckSig(const std::vector<uint8_t> &vchSigIn,
-                  const std::vector<uint8_t> &vchPubKey,
+    bool CheckSig(Span<const uint8_t> vchSigIn, Span<const uint8_t> vchPubKey,
                   const CScript &scriptCode,
                   uint32_t flags) const final override;
     bool CheckLockTime(const CScriptNum &nLockTime) const final override;
@@ -82,10 +101,10 @@ using TransactionSignatureChecker =
 using MutableTransactionSignatureChecker =
     GenericTransactionSignatureChecker<CMutableTransaction>;
 
-bool EvalScript(std::vector<std::vector<uint8_t>> &stack, const CScript &script,
+bool EvalScript(std::vector<StackElement> &stack, const CScript &script,
                 uint32_t flags, const BaseSignatureChecker &checker,
                 ScriptExecutionMetrics &metrics, ScriptError *error = nullptr);
-static inline bool EvalScript(std::vector<std::vector<uint8_t>> &stack,
+static inline bool EvalScript(std::vector<StackElement> &stack,
                               const CScript &script, uint32_t flags,
                               const BaseSignatureChecker &checker,
                               ScriptError *error = nullptr) {
@@ -112,6 +131,32 @@ static inline bool VerifyScript(const CScript &scriptSig,
                         serror);
 }
 
+/**
+ * Verify the spend of a standard P2PKH, P2PK or P2SH multisig output without
+ * the generic script interpreter, and without copying the pushed data.
+ *
+ * The result, error and metrics are the same as VerifyScript. Returns
+ * std::nullopt if the scripts don't match one of these templates or fail
+ * before any signature is checked, in which case they must be verified by the
+ * interpreter.
+ */
+std::optional<bool> VerifyStandardScript(const CScript &scriptSig,
+                                         const CScript &scriptPubKey,
+                                         uint32_t flags,
+                                         const BaseSignatureChecker &checker,
+                                         ScriptExecutionMetrics &metricsOut,
+                                         ScriptError *serror = nullptr);
+
+/**
+ * Same as VerifyScript, but always uses the generic interpreter. This is the
+ * reference VerifyStandardScript is tested against.
+ */
+bool VerifyScriptWithInterpreter(const CScript &scriptSig,
+                                 const CScript &scriptPubKey, uint32_t flags,
+                                 const BaseSignatureChecker &checker,
+                                 ScriptExecutionMetrics &metricsOut,
+                                 ScriptError *serror = nullptr);
+
 int FindAndDelete(CScript &script, const CScript &b);
 
 #endif // BITCOIN_SCRIPT_INTERPRETER_H
@@ -265,7 +265,7 @@ std::string GetOpName(opcodetype opcode) {
     }
 }
 
-bool CheckMinimalPush(const std::vector<uint8_t> &data, opcodetype opcode) {
+bool CheckMinimalPush(Span<const uint8_t> data, opcodetype opcode) {
     // Excludes OP_1NEGATE, OP_1-16 since they are by definition minimal
     assert(0 <= opcode && opcode <= OP_PUSHDATA4);
     if (data.size() == 0) {
@@ -296,7 +296,7 @@ bool CheckMinimalPush(const std::vector<uint8_t> &data, opcodetype opcode) {
     return true;
 }
 
-bool CScriptNum::IsMinimallyEncoded(const std::vector<uint8_t> &vch,
+bool CScriptNum::IsMinimallyEncoded(Span<const uint8_t> vch,
                                     const size_t nMaxNumSize) {
     if (vch.size() > nMaxNumSize) {
         return false;
@@ -324,27 +324,26 @@ bool CScriptNum::IsMinimallyEncoded(const std::vector<uint8_t> &vch,
     return true;
 }
 
-bool CScriptNum::MinimallyEncode(std::vector<uint8_t> &data) {
+size_t CScriptNum::GetMinimalEncodingSize(Span<uint8_t> data) {
     if (data.size() == 0) {
-        return false;
+        return 0;
     }
 
     // If the last byte is not 0x00 or 0x80, we are minimally encoded.
     uint8_t last = data.back();
     if (last & 0x7f) {
-        return false;
+        return data.size();
     }
 
     // If the script is one byte long, then we have a zero, which encodes as an
     // empty array.
     if (data.size() == 1) {
-        data = {};
-        return true;
+        return 0;
     }
 
     // If the next byte has it sign bit set, then we are minimaly encoded.
     if (data[data.size() - 2] & 0x80) {
-        return false;
+        return data.size();
     }
 
     // We are not minimally encoded, we need to figure out how much to trim.
@@ -360,14 +359,12 @@ bool CScriptNum::MinimallyEncode(std::vector<uint8_t> &data) {
                 data[i - 1] |= last;
             }
 
-            data.resize(i);
-            return true;
+            return i;
         }
     }
 
     // If we the whole thing is zeros, then we have a zero.
-    data = {};
-    return true;
+    return 0;
 }
 
 bool CScript::IsPayToScriptHash() const {
@@ -446,10 +443,10 @@ bool CScript::IsPushOnly() const {
 
 bool GetScriptOp(CScriptBase::const_iterator &pc,
                  CScriptBase::const_iterator end, opcodetype &opcodeRet,
-                 std::vector<uint8_t> *pvchRet) {
+                 Span<const uint8_t> *pdataRet) {
     opcodeRet = OP_INVALIDOPCODE;
-    if (pvchRet) {
-        pvchRet->clear();
+    if (pdataRet) {
+        *pdataRet = Span<const uint8_t>();
     }
     if (pc >= end) {
         return false;
@@ -488,8 +485,8 @@ bool GetScriptOp(CScriptBase::const_iterator &pc,
         if (end - pc < 0 || uint32_t(end - pc) < nSize) {
             return false;
         }
-        if (pvchRet) {
-            pvchRet->assign(pc, pc + nSize);
+        if (pdataRet && nSize > 0) {
+            *pdataRet = Span<const uint8_t>(&pc[0], nSize);
         }
         pc += nSize;
     }
@@ -10,6 +10,7 @@
 #include <crypto/common.h>
 #include <prevector.h>
 #include <serialize.h>
+#include <span.h>
 
 #include <cassert>
 #include <climits>
@@ -205,7 +206,7 @@ std::string GetOpName(opcodetype opcode);
  * Check whether the given stack element data would be minimally pushed using
  * the given opcode.
  */
-bool CheckMinimalPush(const std::vector<uint8_t> &data, opcodetype opcode);
+bool CheckMinimalPush(Span<const uint8_t> data, opcodetype opcode);
 
 class scriptnum_error : public std::runtime_error {
 public:
@@ -228,7 +229,7 @@ public:
 
     explicit CScriptNum(const int64_t &n) { m_value = n; }
 
-    explicit CScriptNum(const std::vector<uint8_t> &vch, bool fRequireMinimal,
+    explicit CScriptNum(Span<const uint8_t> vch, bool fRequireMinimal,
                         const size_t nMaxNumSize = MAXIMUM_ELEMENT_SIZE) {
         if (vch.size() > nMaxNumSize) {
             throw scriptnum_error("script number overflow");
@@ -240,10 +241,22 @@ public:
     }
 
     static bool IsMinimallyEncoded(
-        const std::vector<uint8_t> &vch,
+        Span<const uint8_t> vch,
         const size_t nMaxNumSize = CScriptNum::MAXIMUM_ELEMENT_SIZE);
 
-    static bool MinimallyEncode(std::vector<uint8_t> &data);
+    /**
+     * Trim the encoding of a number to its minimal size. The data can be a
+     * std::vector or a prevector, like the script stack elements.
+     */
+    template <typename T> static bool MinimallyEncode(T &data) {
+        const size_t size = GetMinimalEncodingSize(data);
+        if (size == data.size()) {
+            return false;
+        }
+
+        data.resize(size);
+        return true;
+    }
 
     inline bool operator==(const int64_t &rhs) const { return m_value == rhs; }
     inline bool operator!=(const int64_t &rhs) const { return m_value != rhs; }
@@ -358,14 +371,17 @@ public:
         return m_value;
     }
 
-    std::vector<uint8_t> getvch() const { return serialize(m_value); }
+    template <typename T = std::vector<uint8_t>> T getvch() const {
+        return serialize<T>(m_value);
+    }
 
-    static std::vector<uint8_t> serialize(const int64_t &value) {
+    template <typename T = std::vector<uint8_t>>
+    static T serialize(const int64_t &value) {
         if (value == 0) {
             return {};
         }
 
-        std::vector<uint8_t> result;
+        T result;
         const bool neg = value < 0;
         uint64_t absvalue = neg ? ~static_cast<uint64_t>(value) + 1
                                 : static_cast<uint64_t>(value);
@@ -393,7 +409,13 @@ public:
     }
 
 private:
-    static int64_t set_vch(const std::vector<uint8_t> &vch) {
+    /**
+     * Get the size of the minimal encoding of a number, moving its sign bit
+     * in place if it is not minimally encoded.
+     */
+    static size_t GetMinimalEncodingSize(Span<uint8_t> data);
+
+    static int64_t set_vch(Span<const uint8_t> vch) {
         if (vch.empty()) {
             return 0;
         }
@@ -425,7 +447,7 @@ typedef prevector<28, uint8_t> CScriptBase;
 
 bool GetScriptOp(CScriptBase::const_iterator &pc,
                  CScriptBase::const_iterator end, opcodetype &opcodeRet,
-                 std::vector<uint8_t> *pvchRet);
+                 Span<const uint8_t> *pdataRet);
 
 /** Serialized script, used inside transaction inputs and outputs */
 class CScript : public CScriptBase {
@@ -501,7 +523,19 @@ public:
 
     bool GetOp(const_iterator &pc, opcodetype &opcodeRet,
                std::vector<uint8_t> &vchRet) const {
-        return GetScriptOp(pc, end(), opcodeRet, &vchRet);
+        Span<const uint8_t> data;
+        const bool ret = GetScriptOp(pc, end(), opcodeRet, &data);
+        vchRet.assign(data.begin(), data.end());
+        return ret;
+    }
+
+    /**
+     * Same as above, but the pushed data points into the script instead of
+     * being copied.
+     */
+    bool GetOp(const_iterator &pc, opcodetype &opcodeRet,
+               Span<const uint8_t> &dataRet) const {
+        return GetScriptOp(pc, end(), opcodeRet, &dataRet);
     }
 
     bool GetOp(const_iterator &pc, opcodetype &opcodeRet) const {
@@ -5,13 +5,10 @@
 #include <script/scriptcache.h>
 
 #include <crypto/sha256.h>
-#include <cuckoocache.h>
 #include <primitives/transaction.h>
 #include <random.h>
 #include <script/sigcache.h>
-#include <sync.h>
 #include <util/system.h>
-#include <validation.h>
 
 /**
  * In future if many more values are added, it should be considered to
@@ -34,6 +31,10 @@ struct ScriptCacheElement {
         : key(keyIn), nSigChecks(nSigChecksIn) {}
 
     const KeyType &getKey() const { return key; }
+
+    SERIALIZE_METHODS(ScriptCacheElement, obj) {
+        READWRITE(obj.key, obj.nSigChecks);
+    }
 };
 
 static_assert(sizeof(ScriptCacheElement) == 32,
@@ -69,18 +70,24 @@ public:
     }
 };
 
-static CuckooCache::cache<ScriptCacheElement, ScriptCacheHasher>
+static ShardedCuckooCache<ScriptCacheElement, ScriptCacheHasher>
     g_scriptExecutionCache;
 static CSHA256 g_scriptExecutionCacheHasher;
+static uint256 g_scriptExecutionCacheNonce;
 
-void InitScriptExecutionCache() {
-    // Setup the salted hasher
-    uint256 nonce = GetRandHash();
+static void SetScriptExecutionCacheNonce(const uint256 &nonce) {
+    g_scriptExecutionCacheNonce = nonce;
     // We want the nonce to be 64 bytes long to force the hasher to process
     // this chunk, which makes later hash computations more efficient. We
     // just write our 32-byte entropy twice to fill the 64 bytes.
+    g_scriptExecutionCacheHasher = CSHA256();
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
+}
+
+void InitScriptExecutionCache() {
+    // Setup the salted hasher
+    SetScriptExecutionCacheNonce(GetRandHash());
     // nMaxCacheSize is unsigned. If -maxscriptcachesize is set to zero,
     // setup_bytes creates the minimum possible cache (2 elements).
     size_t nMaxCacheSize =
@@ -107,10 +114,6 @@ ScriptCacheKey::ScriptCacheKey(const CTransaction &tx, uint32_t flags) {
 }
 
 bool IsKeyInScriptCache(ScriptCacheKey key, bool erase, int &nSigChecksOut) {
-    // TODO: Remove this requirement by making CuckooCache not require external
-    // locks
-    AssertLockHeld(cs_main);
-
     ScriptCacheElement elem(key, 0);
     bool ret = g_scriptExecutionCache.get(elem, erase);
     nSigChecksOut = elem.nSigChecks;
@@ -118,10 +121,24 @@ bool IsKeyInScriptCache(ScriptCacheKey key, bool erase, int &nSigChecksOut) {
 }
 
 void AddKeyInScriptCache(ScriptCacheKey key, int nSigChecks) {
-    // TODO: Remove this requirement by making CuckooCache not require external
-    // locks
-    AssertLockHeld(cs_main);
-
     ScriptCacheElement elem(key, nSigChecks);
     g_scriptExecutionCache.insert(elem);
 }
+
+ScriptCacheStats GetScriptExecutionCacheStats() {
+    return g_scriptExecutionCache.GetStats();
+}
+
+bool DumpScriptExecutionCache(const fs::path &path) {
+    return DumpScriptCache(g_scriptExecutionCache, g_scriptExecutionCacheNonce,
+                           path);
+}
+
+bool LoadScriptExecutionCache(const fs::path &path) {
+    uint256 nonce;
+    if (!LoadScriptCache(g_scriptExecutionCache, nonce, path)) {
+        return false;
+    }
+    SetScriptExecutionCacheNonce(nonce);
+    return true;
+}
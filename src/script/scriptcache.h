@@ -5,15 +5,13 @@
 #ifndef BITCOIN_SCRIPT_SCRIPTCACHE_H
 #define BITCOIN_SCRIPT_SCRIPTCACHE_H
 
+#include <fs.h>
+#include <script/shardedcache.h>
+#include <serialize.h>
+
 #include <array>
 #include <cstdint>
 
-#include <sync.h>
-
-// Actually declared in validation.cpp; can't include because of circular
-// dependency.
-extern RecursiveMutex cs_main;
-
 class CTransaction;
 
 /**
@@ -39,6 +37,8 @@ public:
         return rhs.data == data;
     }
 
+    SERIALIZE_METHODS(ScriptCacheKey, obj) { READWRITE(obj.data); }
+
     friend class ScriptCacheHasher;
 };
 
@@ -56,13 +56,23 @@ void InitScriptExecutionCache();
  * Check if a given key is in the cache, and if so, return its values.
  * (if not found, nSigChecks may or may not be set to an arbitrary value)
  */
-bool IsKeyInScriptCache(ScriptCacheKey key, bool erase, int &nSigChecksOut)
-    EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+bool IsKeyInScriptCache(ScriptCacheKey key, bool erase, int &nSigChecksOut);
 
 /**
  * Add an entry in the cache.
  */
-void AddKeyInScriptCache(ScriptCacheKey key, int nSigChecks)
-    EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+void AddKeyInScriptCache(ScriptCacheKey key, int nSigChecks);
+
+/** Get the usage statistics of the script execution cache */
+ScriptCacheStats GetScriptExecutionCacheStats();
+
+/** Dump the script execution cache to disk */
+bool DumpScriptExecutionCache(const fs::path &path);
+
+/**
+ * Load the script execution cache from disk. This replaces the nonce the keys
+ * are salted with, so it must be called before the cache is in use.
+ */
+bool LoadScriptExecutionCache(const fs::path &path);
 
 #endif // BITCOIN_SCRIPT_SCRIPTCACHE_H
@@ -0,0 +1,260 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SCRIPT_SHARDEDCACHE_H
+#define BITCOIN_SCRIPT_SHARDEDCACHE_H
+
+#include <clientversion.h>
+#include <cuckoocache.h>
+#include <fs.h>
+#include <logging.h>
+#include <streams.h>
+#include <uint256.h>
+#include <util/system.h>
+#include <util/time.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** Number of independently locked shards of the script validation caches */
+static constexpr size_t SCRIPT_CACHE_SHARDS = 16;
+
+/** Usage statistics of a ShardedCuckooCache, summed over all the shards */
+struct ScriptCacheStats {
+    size_t shards{0};
+    //! Maximum number of elements the cache can hold
+    size_t capacity{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t insertions{0};
+    //! Number of accesses that had to wait for another thread to release the
+    //! shard lock
+    uint64_t contentions{0};
+};
+
+/**
+ * A CuckooCache::cache split into shards, each protected by its own lock.
+ *
+ * The elements are assigned to a shard using bits of their first hash, so
+ * concurrent insertions and lookups of different elements only contend on
+ * the same lock with probability 1 / NUM_SHARDS. Lookups only need a shared
+ * lock, as setting the erase flag is atomic.
+ */
+template <typename Element, typename Hash,
+          size_t NUM_SHARDS = SCRIPT_CACHE_SHARDS>
+class ShardedCuckooCache {
+    static_assert(NUM_SHARDS > 0 && (NUM_SHARDS & (NUM_SHARDS - 1)) == 0,
+                  "The number of shards must be a power of two");
+
+    using Key = typename Element::KeyType;
+
+    /** Shards are aligned to avoid false sharing of the locks and counters */
+    struct alignas(64) Shard {
+        CuckooCache::cache<Element, Hash> cache;
+        mutable std::shared_mutex mutex;
+        mutable std::atomic<uint64_t> hits{0};
+        mutable std::atomic<uint64_t> misses{0};
+        mutable std::atomic<uint64_t> insertions{0};
+        mutable std::atomic<uint64_t> contentions{0};
+        uint32_t capacity{0};
+    };
+
+    std::array<Shard, NUM_SHARDS> shards;
+    const Hash hash_function{};
+
+    const Shard &GetShard(const Key &key) const {
+        // The cuckoo cache derives the locations from the high bits of the
+        // hashes, use the low bits to pick the shard.
+        return shards[hash_function.template operator()<0>(key) &
+                      (NUM_SHARDS - 1)];
+    }
+    Shard &GetShard(const Key &key) {
+        return const_cast<Shard &>(std::as_const(*this).GetShard(key));
+    }
+
+    template <typename Lock> static void Acquire(Lock &lock, const Shard &s) {
+        if (!lock.try_lock()) {
+            s.contentions.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+    }
+
+    static bool Count(const Shard &s, bool found) {
+        (found ? s.hits : s.misses).fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+
+public:
+    /**
+     * Split the requested amount of memory between the shards. Must be called
+     * before any other operation. Returns the total number of elements the
+     * cache can hold.
+     */
+    size_t setup_bytes(size_t bytes) {
+        size_t total = 0;
+        for (Shard &s : shards) {
+            std::unique_lock<std::shared_mutex> lock(s.mutex);
+            s.capacity = s.cache.setup_bytes(bytes / NUM_SHARDS);
+            total += s.capacity;
+        }
+        return total;
+    }
+
+    /** @see CuckooCache::cache::insert */
+    void insert(Element e, bool replace = false) {
+        Shard &s = GetShard(e.getKey());
+        std::unique_lock<std::shared_mutex> lock(s.mutex, std::defer_lock);
+        Acquire(lock, s);
+        s.cache.insert(std::move(e), replace);
+        s.insertions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @see CuckooCache::cache::contains */
+    bool contains(const Key &k, const bool erase) const {
+        const Shard &s = GetShard(k);
+        std::shared_lock<std::shared_mutex> lock(s.mutex, std::defer_lock);
+        Acquire(lock, s);
+        return Count(s, s.cache.contains(k, erase));
+    }
+
+    /** @see CuckooCache::cache::get */
+    bool get(Element &e, const bool erase) const {
+        const Shard &s = GetShard(e.getKey());
+        std::shared_lock<std::shared_mutex> lock(s.mutex, std::defer_lock);
+        Acquire(lock, s);
+        return Count(s, s.cache.get(e, erase));
+    }
+
+    /**
+     * Serialize the elements of all the shards that are not marked for
+     * garbage collection. The shards are locked one at a time, so the elements
+     * inserted concurrently may or may not be included.
+     */
+    template <typename Stream> void Serialize(Stream &s) const {
+        std::vector<Element> elements;
+        for (const Shard &shard : shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            shard.cache.for_each(
+                [&](const Element &e) { elements.push_back(e); });
+        }
+        s << elements;
+    }
+
+    /**
+     * Insert the serialized elements. Nothing is inserted if the
+     * deserialization fails.
+     */
+    template <typename Stream> void Unserialize(Stream &s) {
+        std::vector<Element> elements;
+        s >> elements;
+        for (Element &e : elements) {
+            insert(std::move(e));
+        }
+    }
+
+    ScriptCacheStats GetStats() const {
+        ScriptCacheStats stats;
+        stats.shards = NUM_SHARDS;
+        for (const Shard &s : shards) {
+            std::shared_lock<std::shared_mutex> lock(s.mutex);
+            stats.capacity += s.capacity;
+            stats.hits += s.hits.load(std::memory_order_relaxed);
+            stats.misses += s.misses.load(std::memory_order_relaxed);
+            stats.insertions += s.insertions.load(std::memory_order_relaxed);
+            stats.contentions += s.contentions.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+};
+
+static const uint64_t SCRIPT_CACHE_DUMP_VERSION = 1;
+
+/**
+ * Dump the content of a script validation cache, along with the nonce its
+ * entries are salted with, so it can be reloaded after a restart.
+ */
+template <typename Cache>
+bool DumpScriptCache(const Cache &cache, const uint256 &nonce,
+                     const fs::path &path) {
+    const int64_t start = GetTimeMillis();
+    const fs::path path_new = path + ".new";
+
+    try {
+        CAutoFile file(fsbridge::fopen(path_new, "wb"), SER_DISK,
+                       CLIENT_VERSION);
+        if (file.IsNull()) {
+            return false;
+        }
+
+        file << SCRIPT_CACHE_DUMP_VERSION;
+        file << CLIENT_VERSION;
+        file << nonce;
+        file << cache;
+
+        if (!FileCommit(file.Get())) {
+            throw std::runtime_error("FileCommit failed");
+        }
+        file.fclose();
+        if (!RenameOver(path_new, path)) {
+            throw std::runtime_error("Rename failed");
+        }
+    } catch (const std::exception &e) {
+        LogPrintf("Failed to dump %s: %s. Continuing anyway.\n",
+                  fs::PathToString(path.filename()), e.what());
+        return false;
+    }
+
+    LogPrintf("Dumped %s in %dms\n", fs::PathToString(path.filename()),
+              GetTimeMillis() - start);
+    return true;
+}
+
+/**
+ * Load the entries of a script validation cache dumped by DumpScriptCache
+ * and return the nonce they are salted with, which the caller must use for
+ * the new entries. The dumps from another client version are ignored, as the
+ * validation rules might have changed.
+ */
+template <typename Cache>
+bool LoadScriptCache(Cache &cache, uint256 &nonce, const fs::path &path) {
+    CAutoFile file(fsbridge::fopen(path, "rb"), SER_DISK, CLIENT_VERSION);
+    if (file.IsNull()) {
+        LogPrintf("Failed to open %s from disk. Continuing anyway.\n",
+                  fs::PathToString(path.filename()));
+        return false;
+    }
+
+    try {
+        uint64_t version;
+        int client_version;
+        file >> version;
+        file >> client_version;
+        if (version != SCRIPT_CACHE_DUMP_VERSION ||
+            client_version != CLIENT_VERSION) {
+            LogPrintf("Ignoring %s written by another client version\n",
+                      fs::PathToString(path.filename()));
+            return false;
+        }
+
+        file >> nonce;
+        file >> cache;
+    } catch (const std::exception &e) {
+        LogPrintf("Failed to deserialize %s: %s. Continuing anyway.\n",
+                  fs::PathToString(path.filename()), e.what());
+        return false;
+    }
+
+    LogPrintf("Imported %s from disk\n", fs::PathToString(path.filename()));
+    return true;
+}
+
+#endif // BITCOIN_SCRIPT_SHARDEDCACHE_H
@@ -5,15 +5,13 @@
 
 #include <script/sigcache.h>
 
-#include <cuckoocache.h>
 #include <pubkey.h>
 #include <random.h>
+#include <script/shardedcache.h>
 #include <uint256.h>
 #include <util/system.h>
 
 #include <algorithm>
-#include <mutex>
-#include <shared_mutex>
 #include <vector>
 
 namespace {
@@ -27,42 +25,54 @@ class CSignatureCache {
 private:
     //! Entries are SHA256(nonce || signature hash || public key || signature):
     CSHA256 m_salted_hasher;
-    typedef CuckooCache::cache<CuckooCache::KeyOnly<uint256>,
+    uint256 m_nonce;
+    typedef ShardedCuckooCache<CuckooCache::KeyOnly<uint256>,
                                SignatureCacheHasher>
         map_type;
     map_type setValid;
-    std::shared_mutex cs_sigcache;
 
 public:
-    CSignatureCache() {
-        uint256 nonce = GetRandHash();
+    CSignatureCache() { SetNonce(GetRandHash()); }
+
+    void SetNonce(const uint256 &nonce) {
+        m_nonce = nonce;
         // We want the nonce to be 64 bytes long to force the hasher to process
         // this chunk, which makes later hash computations more efficient. We
         // just write our 32-byte entropy twice to fill the 64 bytes.
+        m_salted_hasher = CSHA256();
         m_salted_hasher.Write(nonce.begin(), 32);
         m_salted_hasher.Write(nonce.begin(), 32);
     }
 
     void ComputeEntry(uint256 &entry, const uint256 &hash,
-                      const std::vector<uint8_t> &vchSig,
-                      const CPubKey &pubkey) {
+                      Span<const uint8_t> vchSig, const CPubKey &pubkey) {
         CSHA256 hasher = m_salted_hasher;
         hasher.Write(hash.begin(), 32)
             .Write(&pubkey[0], pubkey.size())
-            .Write(&vchSig[0], vchSig.size())
+            .Write(vchSig.data(), vchSig.size())
             .Finalize(entry.begin());
     }
 
     bool Get(const uint256 &entry, const bool erase) {
-        std::shared_lock<std::shared_mutex> lock(cs_sigcache);
         return setValid.contains(entry, erase);
     }
 
-    void Set(const uint256 &entry) {
-        std::unique_lock<std::shared_mutex> lock(cs_sigcache);
-        setValid.insert(entry);
+    void Set(const uint256 &entry) { setValid.insert(entry); }
+    size_t setup_bytes(size_t n) { return setValid.setup_bytes(n); }
+    ScriptCacheStats GetStats() const { return setValid.GetStats(); }
+
+    bool Dump(const fs::path &path) const {
+        return DumpScriptCache(setValid, m_nonce, path);
+    }
+
+    bool Load(const fs::path &path) {
+        uint256 nonce;
+        if (!LoadScriptCache(setValid, nonce, path)) {
+            return false;
+        }
+        SetNonce(nonce);
+        return true;
     }
-    uint32_t setup_bytes(size_t n) { return setValid.setup_bytes(n); }
 };
 
 /**
@@ -92,8 +102,20 @@ void InitSignatureCache() {
               (nElems * sizeof(uint256)) >> 20, nMaxCacheSize >> 20, nElems);
 }
 
+ScriptCacheStats GetSignatureCacheStats() {
+    return signatureCache.GetStats();
+}
+
+bool DumpSignatureCache(const fs::path &path) {
+    return signatureCache.Dump(path);
+}
+
+bool LoadSignatureCache(const fs::path &path) {
+    return signatureCache.Load(path);
+}
+
 template <typename F>
-bool RunMemoizedCheck(const std::vector<uint8_t> &vchSig, const CPubKey &pubkey,
+bool RunMemoizedCheck(Span<const uint8_t> vchSig, const CPubKey &pubkey,
                       const uint256 &sighash, bool storeOrErase, const F &fun) {
     uint256 entry;
     signatureCache.ComputeEntry(entry, sighash, vchSig, pubkey);
@@ -110,14 +132,14 @@ bool RunMemoizedCheck(const std::vector<uint8_t> &vchSig, const CPubKey &pubkey,
 }
 
 bool CachingTransactionSignatureChecker::IsCached(
-    const std::vector<uint8_t> &vchSig, const CPubKey &pubkey,
+    Span<const uint8_t> vchSig, const CPubKey &pubkey,
     const uint256 &sighash) const {
     return RunMemoizedCheck(vchSig, pubkey, sighash, true,
                             [] { return false; });
 }
 
 bool CachingTransactionSignatureChecker::VerifySignature(
-    const std::vector<uint8_t> &vchSig, const CPubKey &pubkey,
+    Span<const uint8_t> vchSig, const CPubKey &pubkey,
     const uint256 &sighash) const {
     return RunMemoizedCheck(vchSig, pubkey, sighash, store, [&] {
         return TransactionSignatureChecker::VerifySignature(vchSig, pubkey,
@@ -6,7 +6,9 @@
 #ifndef BITCOIN_SCRIPT_SIGCACHE_H
 #define BITCOIN_SCRIPT_SIGCACHE_H
 
+#include <fs.h>
 #include <script/interpreter.h>
+#include <script/shardedcache.h>
 #include <util/hasher.h>
 
 #include <vector>
@@ -17,6 +19,8 @@
 static const unsigned int DEFAULT_MAX_SIG_CACHE_SIZE = 32;
 // Maximum sig cache size allowed
 static const int64_t MAX_MAX_SIG_CACHE_SIZE = 16384;
+/** Default for -persistsigcache */
+static const bool DEFAULT_PERSIST_SIGCACHE = false;
 
 class CPubKey;
 
@@ -24,7 +28,7 @@ class CachingTransactionSignatureChecker : public TransactionSignatureChecker {
 private:
     bool store;
 
-    bool IsCached(const std::vector<uint8_t> &vchSig, const CPubKey &vchPubKey,
+    bool IsCached(Span<const uint8_t> vchSig, const CPubKey &vchPubKey,
                   const uint256 &sighash) const;
 
 public:
@@ -35,8 +39,7 @@ public:
         : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn),
           store(storeIn) {}
 
-    bool VerifySignature(const std::vector<uint8_t> &vchSig,
-                         const CPubKey &vchPubKey,
+    bool VerifySignature(Span<const uint8_t> vchSig, const CPubKey &vchPubKey,
                          const uint256 &sighash) const override;
 
     friend class TestCachingTransactionSignatureChecker;
@@ -44,4 +47,16 @@ public:
 
 void InitSignatureCache();
 
+/** Get the usage statistics of the signature cache */
+ScriptCacheStats GetSignatureCacheStats();
+
+/** Dump the signature cache to disk */
+bool DumpSignatureCache(const fs::path &path);
+
+/**
+ * Load the signature cache from disk. This replaces the nonce the entries are
+ * salted with, so it must be called before the cache is in use.
+ */
+bool LoadSignatureCache(const fs::path &path);
+
 #endif // BITCOIN_SCRIPT_SIGCACHE_H
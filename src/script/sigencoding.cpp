@@ -9,10 +9,6 @@
 #include <pubkey.h>
 #include <script/script_flags.h>
 
-#include <boost/range/adaptor/sliced.hpp>
-
-typedef boost::sliced_range<const valtype> slicedvaltype;
-
 /**
  * A canonical signature exists of: <30> <total len> <02> <len R> <R> <02> <len
  * S> <S>, where R and S are not negative (their first byte has its highest bit
@@ -24,7 +20,7 @@ typedef boost::sliced_range<const valtype> slicedvaltype;
  *
  * This function is consensus-critical since BIP66.
  */
-static bool IsValidDERSignatureEncoding(const slicedvaltype &sig) {
+static bool IsValidDERSignatureEncoding(Span<const uint8_t> sig) {
     // Format: 0x30 [total-length] 0x02 [R-length] [R] 0x02 [S-length] [S]
     // * total-length: 1-byte length descriptor of everything that follows,
     // excluding the sighash byte.
@@ -153,11 +149,11 @@ static bool IsValidDERSignatureEncoding(const slicedvaltype &sig) {
     return true;
 }
 
-static bool IsSchnorrSig(const slicedvaltype &sig) {
+static bool IsSchnorrSig(Span<const uint8_t> sig) {
     return sig.size() == 64;
 }
 
-static bool CheckRawECDSASignatureEncoding(const slicedvaltype &sig,
+static bool CheckRawECDSASignatureEncoding(Span<const uint8_t> sig,
                                            uint32_t flags,
                                            ScriptError *serror) {
     if (IsSchnorrSig(sig)) {
@@ -180,7 +176,7 @@ static bool CheckRawECDSASignatureEncoding(const slicedvaltype &sig,
     return true;
 }
 
-static bool CheckRawSchnorrSignatureEncoding(const slicedvaltype &sig,
+static bool CheckRawSchnorrSignatureEncoding(Span<const uint8_t> sig,
                                              uint32_t flags,
                                              ScriptError *serror) {
     if (IsSchnorrSig(sig)) {
@@ -189,7 +185,7 @@ static bool CheckRawSchnorrSignatureEncoding(const slicedvaltype &sig,
     return set_error(serror, ScriptError::SIG_NONSCHNORR);
 }
 
-static bool CheckRawSignatureEncoding(const slicedvaltype &sig, uint32_t flags,
+static bool CheckRawSignatureEncoding(Span<const uint8_t> sig, uint32_t flags,
                                       ScriptError *serror) {
     if (IsSchnorrSig(sig)) {
         // In a generic-signature context, 64-byte signatures are interpreted
@@ -199,7 +195,7 @@ static bool CheckRawSignatureEncoding(const slicedvaltype &sig, uint32_t flags,
     return CheckRawECDSASignatureEncoding(sig, flags, serror);
 }
 
-bool CheckDataSignatureEncoding(const valtype &vchSig, uint32_t flags,
+bool CheckDataSignatureEncoding(Span<const uint8_t> vchSig, uint32_t flags,
                                 ScriptError *serror) {
     // Empty signature. Not strictly DER encoded, but allowed to provide a
     // compact way to provide an invalid signature for use with CHECK(MULTI)SIG
@@ -207,11 +203,10 @@ bool CheckDataSignatureEncoding(const valtype &vchSig, uint32_t flags,
         return true;
     }
 
-    return CheckRawSignatureEncoding(
-        vchSig | boost::adaptors::sliced(0, vchSig.size()), flags, serror);
+    return CheckRawSignatureEncoding(vchSig, flags, serror);
 }
 
-static bool CheckSighashEncoding(const valtype &vchSig, uint32_t flags,
+static bool CheckSighashEncoding(Span<const uint8_t> vchSig, uint32_t flags,
                                  ScriptError *serror) {
     if (flags & SCRIPT_VERIFY_STRICTENC) {
         if (!GetHashType(vchSig).isDefined()) {
@@ -233,7 +228,7 @@ static bool CheckSighashEncoding(const valtype &vchSig, uint32_t flags,
 }
 
 template <typename F>
-static bool CheckTransactionSignatureEncodingImpl(const valtype &vchSig,
+static bool CheckTransactionSignatureEncodingImpl(Span<const uint8_t> vchSig,
                                                   uint32_t flags,
                                                   ScriptError *serror, F fun) {
     // Empty signature. Not strictly DER encoded, but allowed to provide a
@@ -242,8 +237,7 @@ static bool CheckTransactionSignatureEncodingImpl(const valtype &vchSig,
         return true;
     }
 
-    if (!fun(vchSig | boost::adaptors::sliced(0, vchSig.size() - 1), flags,
-             serror)) {
+    if (!fun(vchSig.first(vchSig.size() - 1), flags, serror)) {
         // serror is set
         return false;
     }
@@ -251,42 +245,42 @@ static bool CheckTransactionSignatureEncodingImpl(const valtype &vchSig,
     return CheckSighashEncoding(vchSig, flags, serror);
 }
 
-bool CheckTransactionSignatureEncoding(const valtype &vchSig, uint32_t flags,
-                                       ScriptError *serror) {
+bool CheckTransactionSignatureEncoding(Span<const uint8_t> vchSig,
+                                       uint32_t flags, ScriptError *serror) {
     return CheckTransactionSignatureEncodingImpl(
         vchSig, flags, serror,
-        [](const slicedvaltype &templateSig, uint32_t templateFlags,
+        [](Span<const uint8_t> templateSig, uint32_t templateFlags,
            ScriptError *templateSerror) {
             return CheckRawSignatureEncoding(templateSig, templateFlags,
                                              templateSerror);
         });
 }
 
-bool CheckTransactionECDSASignatureEncoding(const valtype &vchSig,
+bool CheckTransactionECDSASignatureEncoding(Span<const uint8_t> vchSig,
                                             uint32_t flags,
                                             ScriptError *serror) {
     return CheckTransactionSignatureEncodingImpl(
         vchSig, flags, serror,
-        [](const slicedvaltype &templateSig, uint32_t templateFlags,
+        [](Span<const uint8_t> templateSig, uint32_t templateFlags,
            ScriptError *templateSerror) {
             return CheckRawECDSASignatureEncoding(templateSig, templateFlags,
                                                   templateSerror);
         });
 }
 
-bool CheckTransactionSchnorrSignatureEncoding(const valtype &vchSig,
+bool CheckTransactionSchnorrSignatureEncoding(Span<const uint8_t> vchSig,
                                               uint32_t flags,
                                               ScriptError *serror) {
     return CheckTransactionSignatureEncodingImpl(
         vchSig, flags, serror,
-        [](const slicedvaltype &templateSig, uint32_t templateFlags,
+        [](Span<const uint8_t> templateSig, uint32_t templateFlags,
            ScriptError *templateSerror) {
             return CheckRawSchnorrSignatureEncoding(templateSig, templateFlags,
                                                     templateSerror);
         });
 }
 
-static bool IsCompressedOrUncompressedPubKey(const valtype &vchPubKey) {
+static bool IsCompressedOrUncompressedPubKey(Span<const uint8_t> vchPubKey) {
     switch (vchPubKey.size()) {
         case CPubKey::COMPRESSED_SIZE:
             // Compressed public key: must start with 0x02 or 0x03.
@@ -302,7 +296,7 @@ static bool IsCompressedOrUncompressedPubKey(const valtype &vchPubKey) {
     }
 }
 
-bool CheckPubKeyEncoding(const valtype &vchPubKey, uint32_t flags,
+bool CheckPubKeyEncoding(Span<const uint8_t> vchPubKey, uint32_t flags,
                          ScriptError *serror) {
     if ((flags & SCRIPT_VERIFY_STRICTENC) &&
         !IsCompressedOrUncompressedPubKey(vchPubKey)) {
@@ -9,15 +9,13 @@
 
 #include <script/script_error.h>
 #include <script/sighashtype.h>
+#include <span.h>
 
 #include <cstdint>
-#include <vector>
-
-typedef std::vector<uint8_t> valtype;
 
 namespace {
 
-inline SigHashType GetHashType(const valtype &vchSig) {
+inline SigHashType GetHashType(Span<const uint8_t> vchSig) {
     if (vchSig.size() == 0) {
         return SigHashType(0);
     }
@@ -32,7 +30,7 @@ inline SigHashType GetHashType(const valtype &vchSig) {
  * Signatures passed to OP_CHECKDATASIG and its verify variant must be checked
  * using this function.
  */
-bool CheckDataSignatureEncoding(const valtype &vchSig, uint32_t flags,
+bool CheckDataSignatureEncoding(Span<const uint8_t> vchSig, uint32_t flags,
                                 ScriptError *serror);
 
 /**
@@ -40,15 +38,15 @@ bool CheckDataSignatureEncoding(const valtype &vchSig, uint32_t flags,
  * encoded. Signatures passed to OP_CHECKSIG and its verify variant must be
  * checked using this function.
  */
-bool CheckTransactionSignatureEncoding(const valtype &vchSig, uint32_t flags,
-                                       ScriptError *serror);
+bool CheckTransactionSignatureEncoding(Span<const uint8_t> vchSig,
+                                       uint32_t flags, ScriptError *serror);
 
 /**
  * Check that the signature provided to authentify a transaction is properly
  * encoded ECDSA signature. Signatures passed to OP_CHECKMULTISIG and its verify
  * variant must be checked using this function.
  */
-bool CheckTransactionECDSASignatureEncoding(const valtype &vchSig,
+bool CheckTransactionECDSASignatureEncoding(Span<const uint8_t> vchSig,
                                             uint32_t flags,
                                             ScriptError *serror);
 
@@ -57,14 +55,14 @@ bool CheckTransactionECDSASignatureEncoding(const valtype &vchSig,
  * encoded Schnorr signature (or null). Signatures passed to the new-mode
  * OP_CHECKMULTISIG and its verify variant must be checked using this function.
  */
-bool CheckTransactionSchnorrSignatureEncoding(const valtype &vchSig,
+bool CheckTransactionSchnorrSignatureEncoding(Span<const uint8_t> vchSig,
                                               uint32_t flags,
                                               ScriptError *serror);
 
 /**
  * Check that a public key is encoded properly.
  */
-bool CheckPubKeyEncoding(const valtype &vchPubKey, uint32_t flags,
+bool CheckPubKeyEncoding(Span<const uint8_t> vchPubKey, uint32_t flags,
                          ScriptError *serror);
 
 #endif // BITCOIN_SCRIPT_SIGENCODING_H
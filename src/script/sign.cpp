@@ -242,14 +242,14 @@ public:
     SignatureExtractorChecker(SignatureData &sigdata_,
                               BaseSignatureChecker &checker_)
         : sigdata(sigdata_), checker(checker_) {}
-    bool CheckSig(const std::vector<uint8_t> &scriptSig,
-                  const std::vector<uint8_t> &vchPubKey,
+    bool CheckSig(Span<const uint8_t> scriptSig, Span<const uint8_t> vchPubKey,
                   const CScript &scriptCode, uint32_t flags) const override {
         if (checker.CheckSig(scriptSig, vchPubKey, scriptCode, flags)) {
-            CPubKey pubkey(vchPubKey);
+            CPubKey pubkey(vchPubKey.begin(), vchPubKey.end());
 
-            sigdata.signatures.emplace(pubkey.GetID(),
-                                       SigPair(pubkey, scriptSig));
+            sigdata.signatures.emplace(
+                pubkey.GetID(),
+                SigPair(pubkey, valtype(scriptSig.begin(), scriptSig.end())));
             return true;
         }
         return false;
@@ -257,7 +257,7 @@ public:
 };
 
 struct Stacks {
-    std::vector<valtype> script;
+    std::vector<StackElement> script;
 
     Stacks() = delete;
     Stacks(const Stacks &) = delete;
@@ -296,8 +296,10 @@ SignatureData DataFromTransaction(const CMutableTransaction &tx,
     if (script_type == TxoutType::SCRIPTHASH && !stack.script.empty() &&
         !stack.script.back().empty()) {
         // Get the redeemScript
-        CScript redeem_script(stack.script.back().begin(),
-                              stack.script.back().end());
+        const StackElement &redeem_script_data = stack.script.back();
+        CScript redeem_script(redeem_script_data.data(),
+                              redeem_script_data.data() +
+                                  redeem_script_data.size());
         data.redeem_script = redeem_script;
         next_script = std::move(redeem_script);
 
@@ -310,7 +312,7 @@ SignatureData DataFromTransaction(const CMutableTransaction &tx,
         assert(solutions.size() > 1);
         unsigned int num_pubkeys = solutions.size() - 2;
         unsigned int last_success_key = 0;
-        for (const valtype &sig : stack.script) {
+        for (const StackElement &sig : stack.script) {
             for (unsigned int i = last_success_key; i < num_pubkeys; ++i) {
                 const valtype &pubkey = solutions[i + 1];
                 // We either have a signature for this pubkey, or we have found
@@ -377,8 +379,7 @@ namespace {
 class DummySignatureChecker final : public BaseSignatureChecker {
 public:
     DummySignatureChecker() {}
-    bool CheckSig(const std::vector<uint8_t> &scriptSig,
-                  const std::vector<uint8_t> &vchPubKey,
+    bool CheckSig(Span<const uint8_t> scriptSig, Span<const uint8_t> vchPubKey,
                   const CScript &scriptCode, uint32_t flags) const override {
         return true;
     }
@@ -0,0 +1,104 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <shortidsketch.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+/**
+ * The short ids are uniformly distributed already, so a cheap mixing
+ * function is enough to derive independent cell indexes from them. This is
+ * the splitmix64 finalizer.
+ */
+uint64_t Mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t GetChecksum(uint64_t shortid) {
+    return Mix(shortid);
+}
+
+size_t GetCellIndex(uint64_t shortid, size_t hashIndex, size_t cellCount) {
+    const size_t partitionSize = cellCount / ShortIdSketch::NUM_HASHES;
+    return hashIndex * partitionSize +
+           Mix(shortid + (hashIndex + 1) * 0x9e3779b97f4a7c15) % partitionSize;
+}
+} // namespace
+
+void ShortIdSketch::toggle(uint64_t shortid, int32_t count) {
+    assert(isValid());
+
+    const uint64_t checksum = GetChecksum(shortid);
+    for (size_t i = 0; i < NUM_HASHES; i++) {
+        Cell &cell = cells[GetCellIndex(shortid, i, cells.size())];
+        cell.count += count;
+        cell.shortIdSum ^= shortid;
+        cell.checksumSum ^= checksum;
+    }
+}
+
+ShortIdSketch &ShortIdSketch::operator-=(const ShortIdSketch &other) {
+    assert(cells.size() == other.cells.size());
+
+    for (size_t i = 0; i < cells.size(); i++) {
+        cells[i].count -= other.cells[i].count;
+        cells[i].shortIdSum ^= other.cells[i].shortIdSum;
+        cells[i].checksumSum ^= other.cells[i].checksumSum;
+    }
+
+    return *this;
+}
+
+bool ShortIdSketch::decode(std::vector<uint64_t> &added,
+                           std::vector<uint64_t> &removed) const {
+    if (!isValid()) {
+        return false;
+    }
+
+    ShortIdSketch remaining(*this);
+
+    // A cell is pure when it contains a single short id, which the checksum
+    // confirms. Peeling it off the table might in turn leave the other cells
+    // it was added to pure.
+    std::vector<size_t> candidates(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) {
+        candidates[i] = i;
+    }
+
+    size_t decodedCount = 0;
+    while (!candidates.empty()) {
+        const Cell &cell = remaining.cells[candidates.back()];
+        candidates.pop_back();
+
+        if ((cell.count != 1 && cell.count != -1) ||
+            cell.checksumSum != GetChecksum(cell.shortIdSum)) {
+            continue;
+        }
+
+        // A sketch crafted to never become empty could otherwise be peeled
+        // forever.
+        if (++decodedCount > cells.size()) {
+            return false;
+        }
+
+        const uint64_t shortid = cell.shortIdSum;
+        const int32_t count = cell.count;
+        (count > 0 ? added : removed).push_back(shortid);
+
+        remaining.toggle(shortid, -count);
+        for (size_t i = 0; i < NUM_HASHES; i++) {
+            candidates.push_back(GetCellIndex(shortid, i, cells.size()));
+        }
+    }
+
+    return std::all_of(remaining.cells.begin(), remaining.cells.end(),
+                       [](const Cell &cell) { return cell.isEmpty(); });
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SHORTIDSKETCH_H
+#define BITCOIN_SHORTIDSKETCH_H
+
+#include <serialize.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Sketch of a set of short ids, used to reconcile two sets without sending
+ * them over. This is an invertible Bloom lookup table: each short id is added
+ * to one cell in each of the NUM_HASHES partitions of the table.
+ *
+ * Subtracting the sketch of another set leaves only the short ids that are in
+ * one of the sets but not in the other. They can be recovered as long as their
+ * count is not much larger than the capacity the sketch was built for, which
+ * makes the size of the sketch independent of the size of the sets.
+ */
+class ShortIdSketch {
+public:
+    static constexpr size_t NUM_HASHES = 3;
+
+private:
+    struct Cell {
+        int32_t count{0};
+        uint64_t shortIdSum{0};
+        uint64_t checksumSum{0};
+
+        bool isEmpty() const {
+            return count == 0 && shortIdSum == 0 && checksumSum == 0;
+        }
+
+        SERIALIZE_METHODS(Cell, obj) {
+            READWRITE(obj.count, obj.shortIdSum, obj.checksumSum);
+        }
+    };
+
+    std::vector<Cell> cells;
+
+    void toggle(uint64_t shortid, int32_t count);
+
+public:
+    ShortIdSketch() {}
+    /**
+     * Build an empty sketch which can usually recover up to capacity short
+     * ids once another sketch has been subtracted from it.
+     */
+    explicit ShortIdSketch(size_t capacity) : cells(GetCellCount(capacity)) {}
+
+    /**
+     * About 2 cells per short id are enough to decode most of the differences
+     * of this size. The extra cells make up for the variance of the small
+     * sketches.
+     */
+    static constexpr size_t GetCellCount(size_t capacity) {
+        return NUM_HASHES * ((2 * capacity + NUM_HASHES - 1) / NUM_HASHES + 8);
+    }
+
+    size_t getCellCount() const { return cells.size(); }
+    /** Whether the cells can be split evenly into the hash partitions */
+    bool isValid() const {
+        return !cells.empty() && cells.size() % NUM_HASHES == 0;
+    }
+
+    /** Remove all the short ids, keeping the layout */
+    void clear() { cells.assign(cells.size(), Cell()); }
+
+    void insert(uint64_t shortid) { toggle(shortid, 1); }
+    void erase(uint64_t shortid) { toggle(shortid, -1); }
+
+    /** The sketches must have the same cell count */
+    ShortIdSketch &operator-=(const ShortIdSketch &other);
+
+    /**
+     * Recover the short ids from a sketch difference.
+     *
+     * @param[out] added   The short ids that are only in this sketch
+     * @param[out] removed The short ids that are only in the subtracted one
+     * @return true if the difference could be decoded entirely. Otherwise the
+     *  output vectors only contain part of it.
+     */
+    bool decode(std::vector<uint64_t> &added,
+                std::vector<uint64_t> &removed) const;
+
+    SERIALIZE_METHODS(ShortIdSketch, obj) { READWRITE(obj.cells); }
+};
+
+#endif // BITCOIN_SHORTIDSKETCH_H
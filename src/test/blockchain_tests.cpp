@@ -5,7 +5,10 @@
 #include <rpc/blockchain.h>
 
 #include <chain.h>
+#include <rpc/request.h>
+#include <txmempool.h>
 #include <util/string.h>
+#include <validation.h>
 
 #include <test/util/setup_common.h>
 
@@ -49,6 +52,19 @@ static void TestDifficulty(uint32_t nbits, double expected_difficulty) {
     RejectDifficultyMismatch(difficulty, expected_difficulty);
 }
 
+namespace {
+/** Result stream collecting the JSON in a string */
+class StringResultStream : public RPCResultStream {
+public:
+    std::string json;
+    size_t flushes{0};
+
+    void Write(const std::string &str) override { json += str; }
+    void Flush() override { flushes++; }
+    bool IsStarted() const override { return !json.empty(); }
+};
+} // namespace
+
 BOOST_FIXTURE_TEST_SUITE(blockchain_tests, BasicTestingSetup)
 
 BOOST_AUTO_TEST_CASE(get_difficulty_for_very_low_target) {
@@ -71,4 +87,46 @@ BOOST_AUTO_TEST_CASE(get_difficulty_for_very_high_target) {
     TestDifficulty(0x12345678, 5913134931067755359633408.0);
 }
 
+BOOST_FIXTURE_TEST_CASE(json_stream, TestChain100Setup) {
+    const CScript scriptPubKey =
+        CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    const CMutableTransaction tx1 = CreateValidMempoolTransaction(
+        m_coinbase_txns[0], 0, 1, coinbaseKey, scriptPubKey, 49 * COIN);
+    const CMutableTransaction tx2 =
+        CreateValidMempoolTransaction(MakeTransactionRef(tx1), 0, 101,
+                                      coinbaseKey, scriptPubKey, 48 * COIN);
+
+    const CTxMemPool &mempool = *m_node.mempool;
+    BOOST_CHECK_EQUAL(WITH_LOCK(mempool.cs, return mempool.size()), 2U);
+    {
+        StringResultStream stream;
+        MempoolToJSONStream(stream, mempool);
+        BOOST_CHECK_EQUAL(stream.json,
+                          MempoolToJSON(mempool, /*verbose=*/true).write());
+    }
+
+    // Check an empty mempool as well
+    {
+        CTxMemPool empty_mempool;
+        StringResultStream stream;
+        MempoolToJSONStream(stream, empty_mempool);
+        BOOST_CHECK_EQUAL(stream.json, "{}");
+    }
+
+    const CBlock block = CreateAndProcessBlock({tx1, tx2}, scriptPubKey);
+    const CBlockIndex *tip =
+        WITH_LOCK(cs_main, return m_node.chainman->ActiveTip());
+    BOOST_CHECK(tip->GetBlockHash() == block.GetHash());
+    BOOST_CHECK_EQUAL(block.vtx.size(), 3U);
+
+    StringResultStream stream;
+    blockToJSONStream(stream, m_node.chainman->m_blockman, block, tip, tip);
+    BOOST_CHECK_EQUAL(stream.json,
+                      blockToJSON(m_node.chainman->m_blockman, block, tip, tip,
+                                  /*txDetails=*/true)
+                          .write());
+    // The stream is flushed after each transaction
+    BOOST_CHECK_EQUAL(stream.flushes, block.vtx.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
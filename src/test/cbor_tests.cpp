@@ -0,0 +1,189 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/cbor.h>
+
+#include <util/strencodings.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+BOOST_FIXTURE_TEST_SUITE(cbor_tests, BasicTestingSetup)
+
+static UniValue ParseJSON(const std::string &json) {
+    UniValue value;
+    BOOST_REQUIRE(value.read(json));
+    return value;
+}
+
+static UniValue Decode(const std::string &hex) {
+    UniValue value;
+    BOOST_REQUIRE_MESSAGE(DecodeCBOR(ParseHex(hex), value), hex);
+    return value;
+}
+
+static bool IsDecodable(const std::string &hex) {
+    UniValue value;
+    return DecodeCBOR(ParseHex(hex), value);
+}
+
+/** Check the encoding of the JSON and that it decodes back to the same JSON */
+static void CheckEncoding(const std::string &json, const std::string &hex) {
+    const UniValue value = ParseJSON(json);
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(value)), hex);
+    BOOST_CHECK_EQUAL(Decode(hex).write(), value.write());
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode) {
+    // Test vectors from RFC 8949 appendix A
+    CheckEncoding("0", "00");
+    CheckEncoding("23", "17");
+    CheckEncoding("24", "1818");
+    CheckEncoding("100", "1864");
+    CheckEncoding("1000", "1903e8");
+    CheckEncoding("1000000", "1a000f4240");
+    CheckEncoding("1000000000000", "1b000000e8d4a51000");
+    CheckEncoding("18446744073709551615", "1bffffffffffffffff");
+    CheckEncoding("-1", "20");
+    CheckEncoding("-100", "3863");
+    CheckEncoding("-1000", "3903e7");
+    CheckEncoding("-9223372036854775808", "3b7fffffffffffffff");
+    CheckEncoding("false", "f4");
+    CheckEncoding("true", "f5");
+    CheckEncoding("null", "f6");
+    CheckEncoding("\"\"", "60");
+    CheckEncoding("\"a\"", "6161");
+    CheckEncoding("\"IETF\"", "6449455446");
+    CheckEncoding("[]", "80");
+    CheckEncoding("[1,2,3]", "83010203");
+    CheckEncoding("[1,[2,3],[4,5]]", "8301820203820405");
+    CheckEncoding("{}", "a0");
+    CheckEncoding("{\"a\":1,\"b\":[2,3]}", "a26161016162820203");
+    CheckEncoding("273.15", "c48221196ab3");
+
+    // Lowercase hex strings are encoded as byte strings
+    CheckEncoding("\"01020304\"", "4401020304");
+    CheckEncoding("\"00\"", "4100");
+    // Other strings are left untouched
+    CheckEncoding("\"0102030\"", "6730313032303330");
+    CheckEncoding("\"0A\"", "623041");
+    CheckEncoding("\"0x\"", "623078");
+
+    // Decimals keep their exact representation
+    CheckEncoding("0.00001000", "c482271903e8");
+    CheckEncoding("-1.50000000", "c482273a08f0d17f");
+    CheckEncoding("0.0", "c4822000");
+    CheckEncoding("[21000000.00000000]", "81c482271b000775f05a074000");
+
+    // Keys are kept in order, including the duplicated ones
+    CheckEncoding("{\"b\":1,\"a\":2,\"b\":3}", "a3616201616102616203");
+}
+
+BOOST_AUTO_TEST_CASE(encode_numbers) {
+    // Numbers that are neither integers nor decimals fall back to doubles
+    UniValue value;
+    BOOST_CHECK(value.setNumStr("1.5e-300"));
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(value)), "fb01b01297d23ab683");
+    BOOST_CHECK_EQUAL(Decode("fb01b01297d23ab683").get_real(), 1.5e-300);
+
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(UniValue(0.5))), "c4822005");
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(UniValue(int64_t(-5)))), "24");
+    BOOST_CHECK_EQUAL(
+        HexStr(EncodeCBOR(UniValue(std::numeric_limits<uint64_t>::max()))),
+        "1bffffffffffffffff");
+
+    // The mantissa must fit in 63 bits
+    BOOST_CHECK(value.setNumStr("92233720368547758.08"));
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(value)).substr(0, 2), "fb");
+    BOOST_CHECK(value.setNumStr("92233720368547758.07"));
+    BOOST_CHECK_EQUAL(HexStr(EncodeCBOR(value)), "c482211b7fffffffffffffff");
+}
+
+BOOST_AUTO_TEST_CASE(decode_floats) {
+    BOOST_CHECK_EQUAL(Decode("f93c00").write(), "1");
+    BOOST_CHECK_EQUAL(Decode("f9c400").write(), "-4");
+    BOOST_CHECK_EQUAL(Decode("f90001").write(),
+                      UniValue(std::ldexp(1., -24)).write());
+    BOOST_CHECK_EQUAL(Decode("fa47c35000").write(), "100000");
+    BOOST_CHECK_EQUAL(Decode("fb3ff199999999999a").write(), "1.1");
+
+    // JSON has no infinite nor NaN
+    BOOST_CHECK(!IsDecodable("f97c00"));
+    BOOST_CHECK(!IsDecodable("f97e00"));
+    BOOST_CHECK(!IsDecodable("fa7f800000"));
+    BOOST_CHECK(!IsDecodable("fb7ff8000000000000"));
+}
+
+BOOST_AUTO_TEST_CASE(decode_invalid) {
+    // Empty, truncated and trailing data
+    BOOST_CHECK(!IsDecodable(""));
+    BOOST_CHECK(!IsDecodable("18"));
+    BOOST_CHECK(!IsDecodable("1903"));
+    BOOST_CHECK(!IsDecodable("44010203"));
+    BOOST_CHECK(!IsDecodable("830102"));
+    BOOST_CHECK(!IsDecodable("a16161"));
+    BOOST_CHECK(!IsDecodable("0000"));
+
+    // Indefinite lengths and reserved values
+    BOOST_CHECK(!IsDecodable("9f01ff"));
+    BOOST_CHECK(!IsDecodable("5f4101ff"));
+    BOOST_CHECK(!IsDecodable("1c"));
+
+    // Negative integers below the int64 range
+    BOOST_CHECK(!IsDecodable("3b8000000000000000"));
+
+    // Huge lengths don't cause huge allocations
+    BOOST_CHECK(!IsDecodable("9bffffffffffffffff"));
+    BOOST_CHECK(!IsDecodable("bbffffffffffffffff"));
+    BOOST_CHECK(!IsDecodable("5bffffffffffffffff"));
+
+    // Map keys must be strings
+    BOOST_CHECK(!IsDecodable("a10102"));
+    BOOST_CHECK(!IsDecodable("a1410102"));
+
+    // Only the decimal fraction tag is supported
+    BOOST_CHECK(!IsDecodable("c11a514b67b0"));
+    BOOST_CHECK(!IsDecodable("c48201196ab3"));
+    BOOST_CHECK(!IsDecodable("c4811903e8"));
+    BOOST_CHECK(IsDecodable("c482383f01"));
+    BOOST_CHECK(!IsDecodable("c482384001"));
+
+    // Other simple values
+    BOOST_CHECK(!IsDecodable("e0"));
+    BOOST_CHECK(!IsDecodable("f820"));
+
+    // Nesting depth
+    std::string nested;
+    for (unsigned int i = 0; i < MAX_CBOR_DEPTH; i++) {
+        nested += "81";
+    }
+    BOOST_CHECK(IsDecodable(nested + "00"));
+    BOOST_CHECK(!IsDecodable("81" + nested + "00"));
+}
+
+BOOST_AUTO_TEST_CASE(rpc_reply) {
+    const UniValue reply = ParseJSON(
+        "{\"result\":{\"hash\":"
+        "\"0000000000000000001f85a9b1c1e7e5c5e1b1f6c0a6b3ea0c0d5f5e5a5b5c5d\","
+        "\"confirmations\":12,\"height\":800000,\"difficulty\":"
+        "131392197147.6035,\"tx\":[{\"txid\":"
+        "\"aa2a8b8f6b3b2e5f5d4c3b2a1908f7e6d5c4b3a29180f7e6d5c4b3a29180f7e6\","
+        "\"hex\":\"0100000001aa\",\"vout\":[{\"value\":0.00000546,\"n\":0,"
+        "\"scriptPubKey\":{\"asm\":\"OP_RETURN 6a\",\"type\":\"nulldata\"}}]"
+        ",\"fee\":-0.01}]},\"error\":null,\"id\":\"curltest\"}");
+
+    const std::string cbor = EncodeCBOR(reply);
+    BOOST_CHECK_LT(cbor.size(), reply.write().size());
+
+    UniValue decoded;
+    BOOST_CHECK(DecodeCBOR(MakeUCharSpan(cbor), decoded));
+    BOOST_CHECK_EQUAL(decoded.write(), reply.write());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
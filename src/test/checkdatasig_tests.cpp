@@ -6,6 +6,7 @@
 #include <script/interpreter.h>
 
 #include <test/lcg.h>
+#include <test/util/script.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -41,7 +42,7 @@ static void CheckError(uint32_t flags, const stacktype &original_stack,
                        const CScript &script, ScriptError expected) {
     BaseSignatureChecker sigchecker;
     ScriptError err = ScriptError::OK;
-    stacktype stack{original_stack};
+    std::vector<StackElement> stack = ToScriptStack(original_stack);
     bool r = EvalScript(stack, script, flags, sigchecker, &err);
     BOOST_CHECK(!r);
     BOOST_CHECK(err == expected);
@@ -51,11 +52,11 @@ static void CheckPass(uint32_t flags, const stacktype &original_stack,
                       const CScript &script, const stacktype &expected) {
     BaseSignatureChecker sigchecker;
     ScriptError err = ScriptError::OK;
-    stacktype stack{original_stack};
+    std::vector<StackElement> stack = ToScriptStack(original_stack);
     bool r = EvalScript(stack, script, flags, sigchecker, &err);
     BOOST_CHECK(r);
     BOOST_CHECK(err == ScriptError::OK);
-    BOOST_CHECK(stack == expected);
+    BOOST_CHECK(FromScriptStack(stack) == expected);
 }
 
 /**
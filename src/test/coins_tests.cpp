@@ -290,6 +290,150 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test) {
     SimulationTest(&db_base, true);
 }
 
+BOOST_AUTO_TEST_CASE(coins_range_cursors) {
+    CCoinsViewDB db{"test", /*nCacheSize*/ 1 << 23, /*fMemory*/ true,
+                    /*fWipe*/ false};
+    {
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(BlockHash(InsecureRand256()));
+        for (int i = 0; i < 1000; i++) {
+            uint256 txid = InsecureRand256();
+            // Make sure the first and last ranges are not empty
+            if (i < 2) {
+                *txid.begin() = i == 0 ? 0x00 : 0xff;
+            }
+            const uint32_t n_outputs = 1 + InsecureRandRange(3);
+            for (uint32_t n = 0; n < n_outputs; n++) {
+                Coin coin{CTxOut(int64_t(InsecureRandRange(1000)) * SATOSHI,
+                                 CScript() << OP_TRUE),
+                          1, false};
+                cache.AddCoin(COutPoint(TxId(txid), n), std::move(coin),
+                              false);
+            }
+        }
+        BOOST_REQUIRE(cache.Flush());
+    }
+
+    std::vector<COutPoint> all_coins;
+    std::unique_ptr<CCoinsViewCursor> cursor{db.Cursor()};
+    for (; cursor->Valid(); cursor->Next()) {
+        COutPoint outpoint;
+        BOOST_REQUIRE(cursor->GetKey(outpoint));
+        all_coins.push_back(outpoint);
+    }
+    BOOST_CHECK_GE(all_coins.size(), 1000);
+
+    // The ranges cover all the coins exactly once, in order
+    for (const size_t n_ranges : {1, 2, 3, 7, 16, 256, 1000}) {
+        const auto cursors = db.RangeCursors(n_ranges);
+        BOOST_CHECK_EQUAL(cursors.size(), std::min<size_t>(n_ranges, 256));
+
+        std::vector<COutPoint> range_coins;
+        for (const auto &range_cursor : cursors) {
+            BOOST_CHECK(range_cursor->GetBestBlock() == db.GetBestBlock());
+            for (; range_cursor->Valid(); range_cursor->Next()) {
+                COutPoint outpoint;
+                Coin coin;
+                BOOST_REQUIRE(range_cursor->GetKey(outpoint));
+                BOOST_REQUIRE(range_cursor->GetValue(coin));
+                range_coins.push_back(outpoint);
+            }
+        }
+        BOOST_CHECK(range_coins == all_coins);
+    }
+
+    // The cursors iterate over a snapshot of the database
+    const auto cursors = db.RangeCursors(2);
+    {
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(BlockHash(InsecureRand256()));
+        for (const COutPoint &outpoint : all_coins) {
+            cache.SpendCoin(outpoint);
+        }
+        BOOST_REQUIRE(cache.Flush());
+    }
+    BOOST_CHECK(!std::unique_ptr<CCoinsViewCursor>(db.Cursor())->Valid());
+    size_t snapshot_coins = 0;
+    for (const auto &range_cursor : cursors) {
+        for (; range_cursor->Valid(); range_cursor->Next()) {
+            snapshot_coins++;
+        }
+    }
+    BOOST_CHECK_EQUAL(snapshot_coins, all_coins.size());
+}
+
+BOOST_AUTO_TEST_CASE(coins_db_parallel_flush) {
+    CCoinsViewDB db{"test", /*nCacheSize*/ 1 << 23, /*fMemory*/ true,
+                    /*fWipe*/ false};
+    gArgs.ForceSetArg("-dbwritethreads", "4");
+    gArgs.ForceSetArg("-dbbatchsize", "100000");
+
+    // Enough coins for the flush to be written by several threads, in many
+    // partial batches
+    std::map<COutPoint, Amount> expected;
+    {
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(BlockHash(InsecureRand256()));
+        for (int i = 0; i < 40000; i++) {
+            const TxId txid{InsecureRand256()};
+            for (uint32_t n = 0; n < 2; n++) {
+                const Amount amount =
+                    int64_t(InsecureRandRange(1000)) * SATOSHI;
+                cache.AddCoin(COutPoint(txid, n),
+                              Coin(CTxOut(amount, CScript() << OP_TRUE), 1,
+                                   false),
+                              false);
+                expected.emplace(COutPoint(txid, n), amount);
+            }
+        }
+        BOOST_REQUIRE(cache.Flush());
+        BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0);
+    }
+
+    // Spend some of the coins and add new ones
+    {
+        CCoinsViewCache cache{&db};
+        const BlockHash best_block{InsecureRand256()};
+        cache.SetBestBlock(best_block);
+        for (auto it = expected.begin(); it != expected.end();) {
+            if (InsecureRandBool()) {
+                BOOST_CHECK(cache.SpendCoin(it->first));
+                it = expected.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (int i = 0; i < 40000; i++) {
+            const COutPoint outpoint(TxId(InsecureRand256()), 0);
+            cache.AddCoin(outpoint,
+                          Coin(CTxOut(SATOSHI, CScript() << OP_TRUE), 2, false),
+                          false);
+            expected.emplace(outpoint, SATOSHI);
+        }
+        BOOST_REQUIRE(cache.Flush());
+        BOOST_CHECK(db.GetBestBlock() == best_block);
+        BOOST_CHECK(db.GetHeadBlocks().empty());
+    }
+
+    gArgs.ClearForcedArg("-dbwritethreads");
+    gArgs.ClearForcedArg("-dbbatchsize");
+
+    // The database contains exactly the unspent coins
+    std::unique_ptr<CCoinsViewCursor> cursor{db.Cursor()};
+    size_t num_coins = 0;
+    for (; cursor->Valid(); cursor->Next()) {
+        COutPoint outpoint;
+        Coin coin;
+        BOOST_REQUIRE(cursor->GetKey(outpoint));
+        BOOST_REQUIRE(cursor->GetValue(coin));
+        const auto it = expected.find(outpoint);
+        BOOST_REQUIRE(it != expected.end());
+        BOOST_CHECK_EQUAL(coin.GetTxOut().nValue, it->second);
+        num_coins++;
+    }
+    BOOST_CHECK_EQUAL(num_coins, expected.size());
+}
+
 // Store of all necessary tx and undo data for next test
 typedef std::map<COutPoint, std::tuple<CTransactionRef, CTxUndo, Coin>>
     UtxoData;
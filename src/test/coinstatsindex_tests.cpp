@@ -5,6 +5,7 @@
 #include <chainparams.h>
 #include <config.h>
 #include <index/coinstatsindex.h>
+#include <node/coinstats.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
 #include <util/time.h>
@@ -16,6 +17,7 @@
 
 using node::CCoinsStats;
 using node::CoinStatsHashType;
+using node::GetUTXOStats;
 
 BOOST_AUTO_TEST_SUITE(coinstatsindex_tests)
 
@@ -85,6 +87,51 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_initial_sync, TestChain100Setup) {
     // Rest of shutdown sequence and destructors happen in ~TestingSetup()
 }
 
+BOOST_FIXTURE_TEST_CASE(coinstatsindex_parallel_muhash, TestChain100Setup) {
+    Chainstate &chainstate = Assert(m_node.chainman)->ActiveChainstate();
+    CoinStatsIndex index{1 << 20, true};
+    BOOST_REQUIRE(index.Start(chainstate));
+    IndexWaitSynced(index);
+
+    const CBlockIndex *tip;
+    {
+        LOCK(cs_main);
+        tip = m_node.chainman->ActiveTip();
+        chainstate.ForceFlushStateToDisk();
+    }
+
+    // The UTXO set hashed in parallel ranges matches the hash maintained
+    // incrementally by the index.
+    CCoinsStats index_stats{CoinStatsHashType::MUHASH};
+    BOOST_REQUIRE(index.LookUpStats(tip, index_stats));
+
+    CCoinsStats muhash_stats{CoinStatsHashType::MUHASH};
+    BOOST_REQUIRE(GetUTXOStats(&chainstate.CoinsDB(),
+                               m_node.chainman->m_blockman, muhash_stats,
+                               [] {}, tip));
+    BOOST_CHECK(!muhash_stats.index_used);
+    BOOST_CHECK_EQUAL(muhash_stats.hashSerialized, index_stats.hashSerialized);
+    BOOST_CHECK_EQUAL(muhash_stats.nTransactionOutputs,
+                      index_stats.nTransactionOutputs);
+    BOOST_CHECK_EQUAL(muhash_stats.nTotalAmount, index_stats.nTotalAmount);
+    BOOST_CHECK_EQUAL(muhash_stats.nBogoSize, index_stats.nBogoSize);
+
+    // The statistics match the ones computed sequentially
+    CCoinsStats serialized_stats{CoinStatsHashType::HASH_SERIALIZED};
+    BOOST_REQUIRE(GetUTXOStats(&chainstate.CoinsDB(),
+                               m_node.chainman->m_blockman, serialized_stats,
+                               [] {}, tip));
+    BOOST_CHECK_EQUAL(muhash_stats.nTransactions,
+                      serialized_stats.nTransactions);
+    BOOST_CHECK_EQUAL(muhash_stats.nTransactionOutputs,
+                      serialized_stats.nTransactionOutputs);
+    BOOST_CHECK_EQUAL(muhash_stats.nTotalAmount,
+                      serialized_stats.nTotalAmount);
+    BOOST_CHECK_EQUAL(muhash_stats.coins_count, serialized_stats.coins_count);
+
+    index.Stop();
+}
+
 // Test shutdown between BlockConnected and ChainStateFlushed notifications,
 // make sure index is not corrupted and is able to reload.
 BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup) {
@@ -1073,6 +1073,36 @@ BOOST_AUTO_TEST_CASE(sha256d64) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256_multi) {
+    // Cover the lengths around the padding boundaries, and enough messages to
+    // fill the lanes of the multi-way implementations several times.
+    for (size_t count = 0; count <= 40; ++count) {
+        std::vector<std::vector<uint8_t>> messages;
+        std::vector<const uint8_t *> inputs;
+        std::vector<size_t> lengths;
+        for (size_t i = 0; i < count; ++i) {
+            messages.push_back(g_insecure_rand_ctx.randbytes(
+                i % 4 == 0 ? InsecureRandRange(300)
+                           : 55 + InsecureRandRange(10)));
+        }
+        for (const auto &message : messages) {
+            inputs.push_back(message.data());
+            lengths.push_back(message.size());
+        }
+
+        std::vector<uint8_t> out(32 * count), outd(32 * count);
+        SHA256Multi(out.data(), inputs.data(), lengths.data(), count);
+        SHA256DMulti(outd.data(), inputs.data(), lengths.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t hash[CSHA256::OUTPUT_SIZE];
+            CSHA256().Write(inputs[i], lengths[i]).Finalize(hash);
+            BOOST_CHECK(memcmp(hash, &out[32 * i], 32) == 0);
+            CHash256().Write(messages[i]).Finalize(hash);
+            BOOST_CHECK(memcmp(hash, &outd[32 * i], 32) == 0);
+        }
+    }
+}
+
 static void TestSHA3_256(const std::string &input, const std::string &output) {
     const auto in_bytes = ParseHex(input);
     const auto out_bytes = ParseHex(output);
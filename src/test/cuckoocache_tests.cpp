@@ -5,6 +5,7 @@
 #include <cuckoocache.h>
 
 #include <random.h>
+#include <script/shardedcache.h>
 #include <script/sigcache.h>
 
 #include <deque>
@@ -532,4 +533,61 @@ BOOST_AUTO_TEST_CASE(cuckoocache_map) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(cuckoocache_sharded) {
+    SeedInsecureRand(SeedRand::ZEROS);
+
+    ShardedCuckooCache<TestMapElement, TestMapElement::CacheHasher> cache;
+    const size_t capacity = cache.setup_bytes(4 << 20);
+    BOOST_CHECK_GE(capacity, (4 << 20) / sizeof(TestMapElement) / 2);
+
+    const size_t n_threads = 8;
+    const size_t n_per_thread = 1000;
+    std::vector<uint256> hashes(n_threads * n_per_thread);
+    for (uint256 &hash : hashes) {
+        hash = InsecureRand256();
+    }
+
+    // Each thread inserts its own elements while looking up the others. Boost
+    // checks are not thread safe, so the failures are counted per thread.
+    std::vector<size_t> failures(n_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&, t] {
+            FastRandomContext rng(/* fDeterministic */ true);
+            for (size_t i = 0; i < n_per_thread; ++i) {
+                const TestMapElement e(hashes[t * n_per_thread + i]);
+                cache.insert(e);
+                TestMapElement found(e.getKey(), 0);
+                if (!cache.get(found, false) ||
+                    found.getValue() != e.getValue()) {
+                    failures[t]++;
+                }
+                const TestMapKey other(hashes[rng.randrange(hashes.size())]);
+                cache.contains(other, false);
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    for (const size_t f : failures) {
+        BOOST_CHECK_EQUAL(f, 0);
+    }
+
+    for (const uint256 &hash : hashes) {
+        BOOST_CHECK(cache.contains(TestMapKey(hash), false));
+    }
+    for (size_t i = 0; i < 1000; ++i) {
+        BOOST_CHECK(!cache.contains(TestMapKey(InsecureRand256()), false));
+    }
+
+    const ScriptCacheStats stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.shards, SCRIPT_CACHE_SHARDS);
+    BOOST_CHECK_EQUAL(stats.capacity, capacity);
+    BOOST_CHECK_EQUAL(stats.insertions, hashes.size());
+    BOOST_CHECK_EQUAL(stats.hits + stats.misses, 3 * hashes.size() + 1000);
+    BOOST_CHECK_GE(stats.hits, 2 * hashes.size());
+    BOOST_CHECK_GE(stats.misses, 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,109 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/fenwicktree.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(fenwicktree_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(basic) {
+    FenwickTree<uint64_t> tree;
+    BOOST_CHECK(tree.empty());
+    BOOST_CHECK_EQUAL(tree.total(), 0);
+
+    for (uint64_t weight : {3, 0, 5, 1, 0, 0, 2}) {
+        tree.push_back(weight);
+    }
+    BOOST_CHECK_EQUAL(tree.size(), 7);
+    BOOST_CHECK_EQUAL(tree.total(), 11);
+    BOOST_CHECK_EQUAL(tree.prefixSum(0), 0);
+    BOOST_CHECK_EQUAL(tree.prefixSum(1), 3);
+    BOOST_CHECK_EQUAL(tree.prefixSum(3), 8);
+    BOOST_CHECK_EQUAL(tree.prefixSum(6), 9);
+
+    // The elements with no weight are skipped
+    const std::vector<size_t> expected{0, 0, 0, 2, 2, 2, 2, 2, 3, 6, 6};
+    for (uint64_t point = 0; point < tree.total(); point++) {
+        BOOST_CHECK_EQUAL(tree.find(point), expected[point]);
+    }
+
+    tree.subtract(2, 5);
+    BOOST_CHECK_EQUAL(tree.total(), 6);
+    BOOST_CHECK_EQUAL(tree.find(3), 3);
+    tree.add(1, 4);
+    BOOST_CHECK_EQUAL(tree.find(3), 1);
+    BOOST_CHECK_EQUAL(tree.find(7), 3);
+
+    tree.pop_back();
+    BOOST_CHECK_EQUAL(tree.total(), 8);
+    BOOST_CHECK_EQUAL(tree.find(7), 3);
+
+    tree.clear();
+    BOOST_CHECK(tree.empty());
+}
+
+BOOST_AUTO_TEST_CASE(random_operations) {
+    FenwickTree<uint32_t> tree;
+    std::vector<uint32_t> weights;
+
+    for (int i = 0; i < 10000; i++) {
+        switch (InsecureRandRange(4)) {
+            case 0:
+            case 1: {
+                const uint32_t weight = InsecureRandRange(100);
+                tree.push_back(weight);
+                weights.push_back(weight);
+                break;
+            }
+            case 2:
+                if (!weights.empty()) {
+                    tree.pop_back();
+                    weights.pop_back();
+                }
+                break;
+            case 3:
+                if (!weights.empty()) {
+                    const size_t index = InsecureRandRange(weights.size());
+                    if (InsecureRandBool()) {
+                        const uint32_t weight = InsecureRandRange(100);
+                        tree.add(index, weight);
+                        weights[index] += weight;
+                    } else {
+                        const uint32_t weight =
+                            InsecureRandRange(weights[index] + 1);
+                        tree.subtract(index, weight);
+                        weights[index] -= weight;
+                    }
+                }
+                break;
+        }
+
+        BOOST_REQUIRE_EQUAL(tree.size(), weights.size());
+        const size_t n = InsecureRandRange(weights.size() + 1);
+        BOOST_CHECK_EQUAL(
+            tree.prefixSum(n),
+            std::accumulate(weights.begin(), weights.begin() + n, uint32_t(0)));
+
+        const uint32_t total = tree.total();
+        if (total == 0) {
+            continue;
+        }
+
+        const uint32_t point = InsecureRandRange(total);
+        const size_t index = tree.find(point);
+        BOOST_REQUIRE_LT(index, weights.size());
+        BOOST_CHECK_GT(weights[index], 0);
+        BOOST_CHECK_LE(tree.prefixSum(index), point);
+        BOOST_CHECK_GT(tree.prefixSum(index + 1), point);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
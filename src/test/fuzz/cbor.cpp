@@ -0,0 +1,36 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/cbor.h>
+#include <span.h>
+
+#include <univalue.h>
+
+#include <test/fuzz/fuzz.h>
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+void test_one_input(const std::vector<uint8_t> &buffer) {
+    UniValue decoded;
+    if (DecodeCBOR(buffer, decoded)) {
+        // Any decoded document can be encoded and decoded back to the same
+        // JSON.
+        UniValue roundtrip;
+        assert(DecodeCBOR(MakeUCharSpan(EncodeCBOR(decoded)), roundtrip));
+        assert(roundtrip.write() == decoded.write());
+    }
+
+    UniValue json;
+    if (json.read(std::string(buffer.begin(), buffer.end()))) {
+        // Any JSON document can be encoded. The numbers that are neither
+        // integers nor decimals may be represented differently once decoded.
+        UniValue roundtrip;
+        assert(DecodeCBOR(MakeUCharSpan(EncodeCBOR(json)), roundtrip));
+        assert(roundtrip.getType() == json.getType());
+        assert(roundtrip.size() == json.size());
+    }
+}
@@ -31,7 +31,7 @@ void test_one_input(const std::vector<uint8_t> &buffer) {
         }
     }();
     const CScript script(script_bytes.begin(), script_bytes.end());
-    std::vector<std::vector<uint8_t>> stack;
+    std::vector<StackElement> stack;
     ScriptExecutionMetrics metrics;
     (void)EvalScript(stack, script, flags, BaseSignatureChecker(), metrics);
 }
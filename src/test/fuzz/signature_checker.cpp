@@ -25,8 +25,7 @@ public:
     explicit FuzzedSignatureChecker(FuzzedDataProvider &fuzzed_data_provider)
         : m_fuzzed_data_provider(fuzzed_data_provider) {}
 
-    bool CheckSig(const std::vector<uint8_t> &scriptSig,
-                  const std::vector<uint8_t> &vchPubKey,
+    bool CheckSig(Span<const uint8_t> scriptSig, Span<const uint8_t> vchPubKey,
                   const CScript &scriptCode, uint32_t flags) const override {
         return m_fuzzed_data_provider.ConsumeBool();
     }
@@ -55,7 +54,7 @@ void test_one_input(const std::vector<uint8_t> &buffer) {
         fuzzed_data_provider.ConsumeRandomLengthString(65536);
     const std::vector<uint8_t> script_bytes_2{script_string_2.begin(),
                                               script_string_2.end()};
-    std::vector<std::vector<uint8_t>> stack;
+    std::vector<StackElement> stack;
     ScriptExecutionMetrics metrics;
     ScriptError serror;
     (void)EvalScript(stack, {script_bytes_1.begin(), script_bytes_1.end()},
@@ -0,0 +1,140 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <hash.h>
+#include <pubkey.h>
+#include <script/interpreter.h>
+#include <script/script.h>
+
+#include <test/fuzz/FuzzedDataProvider.h>
+#include <test/fuzz/fuzz.h>
+#include <test/fuzz/util.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace {
+/**
+ * The signature check result only depends on the data, so the fast path and
+ * the interpreter get the same result for the same calls.
+ */
+class DeterministicSignatureChecker : public BaseSignatureChecker {
+public:
+    bool CheckSig(Span<const uint8_t> vchSig, Span<const uint8_t> vchPubKey,
+                  const CScript &scriptCode, uint32_t flags) const override {
+        return !vchSig.empty() && !vchPubKey.empty() &&
+               ((vchSig[0] ^ vchPubKey.back() ^ scriptCode.size()) & 1) == 0;
+    }
+};
+} // namespace
+
+static std::vector<uint8_t> ConsumePubKey(FuzzedDataProvider &provider) {
+    if (provider.ConsumeBool()) {
+        return ConsumeRandomLengthByteVector(provider, 70);
+    }
+    return provider.ConsumeBytes<uint8_t>(provider.ConsumeBool()
+                                              ? CPubKey::COMPRESSED_SIZE
+                                              : CPubKey::SIZE);
+}
+
+static std::vector<uint8_t> ConsumeSig(FuzzedDataProvider &provider) {
+    return ConsumeRandomLengthByteVector(provider, 80);
+}
+
+static std::vector<uint8_t> Hash160OrRandom(FuzzedDataProvider &provider,
+                                            const std::vector<uint8_t> &data) {
+    if (provider.ConsumeBool()) {
+        return provider.ConsumeBytes<uint8_t>(20);
+    }
+    const uint160 hash = Hash160(data);
+    return {hash.begin(), hash.end()};
+}
+
+void test_one_input(const std::vector<uint8_t> &buffer) {
+    FuzzedDataProvider provider(buffer.data(), buffer.size());
+    const uint32_t flags = provider.ConsumeIntegral<uint32_t>();
+    if ((flags & SCRIPT_VERIFY_CLEANSTACK) && !(flags & SCRIPT_VERIFY_P2SH)) {
+        return;
+    }
+
+    // Build scripts that are close to the standard templates, so the fast
+    // path is exercised and compared to the interpreter.
+    CScript scriptSig;
+    CScript scriptPubKey;
+    switch (provider.ConsumeIntegralInRange(0, 3)) {
+        case 0: {
+            const std::vector<uint8_t> pubkey = ConsumePubKey(provider);
+            scriptSig << ConsumeSig(provider) << pubkey;
+            scriptPubKey << OP_DUP << OP_HASH160
+                         << Hash160OrRandom(provider, pubkey) << OP_EQUALVERIFY
+                         << OP_CHECKSIG;
+            break;
+        }
+        case 1: {
+            scriptSig << ConsumeSig(provider);
+            scriptPubKey << ConsumePubKey(provider) << OP_CHECKSIG;
+            break;
+        }
+        case 2: {
+            const int nKeys = provider.ConsumeIntegralInRange(1, 16);
+            const int nSigs = provider.ConsumeIntegralInRange(0, nKeys + 1);
+            CScript redeemScript;
+            redeemScript << CScript::EncodeOP_N(
+                std::max(1, std::min(nSigs, 16)));
+            for (int i = 0; i < nKeys; i++) {
+                redeemScript << ConsumePubKey(provider);
+            }
+            redeemScript << CScript::EncodeOP_N(nKeys) << OP_CHECKMULTISIG;
+
+            scriptSig << ConsumeRandomLengthByteVector(provider, 4);
+            for (int i = 0; i < nSigs; i++) {
+                scriptSig << ConsumeSig(provider);
+            }
+            const std::vector<uint8_t> redeemBytes(redeemScript.begin(),
+                                                   redeemScript.end());
+            scriptSig << redeemBytes;
+            scriptPubKey << OP_HASH160 << Hash160OrRandom(provider, redeemBytes)
+                         << OP_EQUAL;
+            break;
+        }
+        default:
+            scriptSig = ConsumeScript(provider);
+            scriptPubKey = ConsumeScript(provider);
+            break;
+    }
+
+    // Some random trailing opcodes
+    if (provider.ConsumeBool()) {
+        const std::vector<uint8_t> extra =
+            ConsumeRandomLengthByteVector(provider, 4);
+        scriptSig.insert(scriptSig.end(), extra.begin(), extra.end());
+    }
+
+    const DeterministicSignatureChecker checker;
+    ScriptExecutionMetrics metrics, fastMetrics;
+    ScriptError err, fastErr;
+    const bool ret = VerifyScriptWithInterpreter(scriptSig, scriptPubKey, flags,
+                                                 checker, metrics, &err);
+    const std::optional<bool> fastRet = VerifyStandardScript(
+        scriptSig, scriptPubKey, flags, checker, fastMetrics, &fastErr);
+    if (fastRet) {
+        assert(*fastRet == ret);
+        assert(fastErr == err);
+        if (ret) {
+            assert(fastMetrics.nSigChecks == metrics.nSigChecks);
+        }
+    }
+
+    ScriptExecutionMetrics verifyMetrics;
+    ScriptError verifyErr;
+    assert(VerifyScript(scriptSig, scriptPubKey, flags, checker, verifyMetrics,
+                        &verifyErr) == ret);
+    assert(verifyErr == err);
+    if (ret) {
+        assert(verifyMetrics.nSigChecks == metrics.nSigChecks);
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/histogram.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(histogram_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(bucket_index) {
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(0), 0);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(1), 1);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(2), 2);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(3), 2);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(4), 3);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(1023), 10);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(1024), 11);
+    BOOST_CHECK_EQUAL(Log2Histogram::GetBucketIndex(UINT64_MAX),
+                      Log2Histogram::NUM_BUCKETS - 1);
+
+    // Each value falls below the upper bound of its bucket and above the upper
+    // bound of the previous bucket.
+    for (int i = 0; i < 1000; i++) {
+        const uint64_t value = InsecureRandBits(InsecureRandRange(64));
+        const size_t index = Log2Histogram::GetBucketIndex(value);
+        BOOST_CHECK_LE(value, Log2Histogram::GetBucketUpperBound(index));
+        if (index > 0) {
+            BOOST_CHECK_GT(value,
+                           Log2Histogram::GetBucketUpperBound(index - 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(add_values) {
+    Log2Histogram histogram;
+    BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+    BOOST_CHECK_EQUAL(histogram.GetMean(), 0);
+    BOOST_CHECK_EQUAL(histogram.GetMax(), 0);
+    BOOST_CHECK_EQUAL(histogram.GetPercentileUpperBound(50), 0);
+
+    for (uint64_t i = 1; i <= 100; i++) {
+        histogram.Add(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.GetCount(), 100);
+    BOOST_CHECK_EQUAL(histogram.GetSum(), 5050);
+    BOOST_CHECK_EQUAL(histogram.GetMean(), 50);
+    BOOST_CHECK_EQUAL(histogram.GetMax(), 100);
+
+    const auto &buckets = histogram.GetBuckets();
+    BOOST_CHECK_EQUAL(buckets[0], 0);
+    BOOST_CHECK_EQUAL(buckets[1], 1);
+    BOOST_CHECK_EQUAL(buckets[2], 2);
+    BOOST_CHECK_EQUAL(buckets[3], 4);
+    BOOST_CHECK_EQUAL(buckets[7], 37);
+    BOOST_CHECK_EQUAL(buckets[8], 0);
+
+    // The 50th value (50) is in the [32, 63] bucket, the 99th and 100th values
+    // are in the [64, 127] bucket which is capped by the max.
+    BOOST_CHECK_EQUAL(histogram.GetPercentileUpperBound(0), 1);
+    BOOST_CHECK_EQUAL(histogram.GetPercentileUpperBound(50), 63);
+    BOOST_CHECK_EQUAL(histogram.GetPercentileUpperBound(99), 100);
+    BOOST_CHECK_EQUAL(histogram.GetPercentileUpperBound(100), 100);
+
+    histogram.Clear();
+    BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+    BOOST_CHECK_EQUAL(histogram.GetSum(), 0);
+    BOOST_CHECK_EQUAL(histogram.GetBuckets()[7], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #include <policy/policy.h>
 #include <script/interpreter.h>
 
+#include <test/util/script.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -28,10 +29,10 @@ static void CheckTestResultForAllFlags(const stacktype &original_stack,
 
     for (uint32_t flags : flagset) {
         ScriptError err = ScriptError::OK;
-        stacktype stack{original_stack};
+        std::vector<StackElement> stack = ToScriptStack(original_stack);
         bool r = EvalScript(stack, script, flags, sigchecker, &err);
         BOOST_CHECK(r);
-        BOOST_CHECK(stack == expected);
+        BOOST_CHECK(FromScriptStack(stack) == expected);
     }
 }
 
@@ -39,7 +40,7 @@ static void CheckError(uint32_t flags, const stacktype &original_stack,
                        const CScript &script, ScriptError expected_error) {
     BaseSignatureChecker sigchecker;
     ScriptError err = ScriptError::OK;
-    stacktype stack{original_stack};
+    std::vector<StackElement> stack = ToScriptStack(original_stack);
     bool r = EvalScript(stack, script, flags, sigchecker, &err);
     BOOST_CHECK(!r);
     BOOST_CHECK(err == expected_error);
@@ -7,6 +7,7 @@
 #include <script/script.h>
 
 #include <test/lcg.h>
+#include <test/util/script.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -22,7 +23,7 @@ static void CheckErrorWithFlags(const uint32_t flags,
                                 const ScriptError expected) {
     BaseSignatureChecker sigchecker;
     ScriptError err = ScriptError::OK;
-    stacktype stack{original_stack};
+    std::vector<StackElement> stack = ToScriptStack(original_stack);
     bool r = EvalScript(stack, script, flags, sigchecker, &err);
     BOOST_CHECK(!r);
     BOOST_CHECK(err == expected);
@@ -34,11 +35,11 @@ static void CheckPassWithFlags(const uint32_t flags,
                                const stacktype &expected) {
     BaseSignatureChecker sigchecker;
     ScriptError err = ScriptError::OK;
-    stacktype stack{original_stack};
+    std::vector<StackElement> stack = ToScriptStack(original_stack);
     bool r = EvalScript(stack, script, flags, sigchecker, &err);
     BOOST_CHECK(r);
     BOOST_CHECK(err == ScriptError::OK);
-    BOOST_CHECK(stack == expected);
+    BOOST_CHECK(FromScriptStack(stack) == expected);
 }
 
 /**
@@ -16,6 +16,8 @@
 
 #include <any>
 #include <string>
+#include <thread>
+#include <vector>
 
 BOOST_FIXTURE_TEST_SUITE(rpc_server_tests, TestingSetup)
 
@@ -97,4 +99,84 @@ BOOST_AUTO_TEST_CASE(rpc_server_execute_command_from_request_context) {
     BOOST_CHECK_EQUAL(output.get_str(), "testing2");
 }
 
+class EchoRPCCommand : public RPCCommand {
+public:
+    explicit EchoRPCCommand(const std::string &nameIn) : RPCCommand(nameIn) {}
+
+    UniValue Execute(const JSONRPCRequest &request) const override {
+        return request.params;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(rpc_server_exec_batch) {
+    DummyConfig config;
+    RPCServer rpcServer;
+    rpcServer.RegisterCommand(std::make_unique<EchoRPCCommand>("echo"));
+
+    JSONRPCRequest jreq;
+    jreq.context = &m_node;
+
+    UniValue batch(UniValue::VARR);
+    for (int i = 0; i < 100; i++) {
+        UniValue req(UniValue::VOBJ);
+        req.pushKV("id", i);
+        // Every tenth request is for an unknown method and errors
+        req.pushKV("method", i % 10 == 0 ? "unknown" : "echo");
+        UniValue params(UniValue::VARR);
+        params.push_back(i);
+        req.pushKV("params", params);
+        batch.push_back(req);
+    }
+
+    auto checkReplies = [&](const UniValue &replies) {
+        BOOST_CHECK(replies.isArray());
+        BOOST_CHECK_EQUAL(replies.size(), batch.size());
+        for (size_t i = 0; i < replies.size(); i++) {
+            BOOST_CHECK_EQUAL(replies[i]["id"].get_int(), int(i));
+            if (i % 10 == 0) {
+                BOOST_CHECK(isRpcMethodNotFound(replies[i]["error"]));
+            } else {
+                BOOST_CHECK(replies[i]["error"].isNull());
+                BOOST_CHECK_EQUAL(replies[i]["result"][0].get_int(), int(i));
+            }
+        }
+    };
+
+    const UniValue sequential =
+        JSONRPCExecBatch(config, rpcServer, jreq, batch);
+    checkReplies(sequential);
+
+    // The replies are in the requests order, no matter in which order and on
+    // which thread the requests are executed.
+    size_t runnerCalls = 0;
+    const UniValue reversed = JSONRPCExecBatch(
+        config, rpcServer, jreq, batch,
+        [&](const std::vector<std::function<void()>> &tasks) {
+            runnerCalls++;
+            BOOST_CHECK_EQUAL(tasks.size(), batch.size());
+            for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+                (*it)();
+            }
+        });
+    BOOST_CHECK_EQUAL(runnerCalls, 1);
+    BOOST_CHECK_EQUAL(reversed.write(), sequential.write());
+
+    const UniValue threaded = JSONRPCExecBatch(
+        config, rpcServer, jreq, batch,
+        [&](const std::vector<std::function<void()>> &tasks) {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < 4; t++) {
+                threads.emplace_back([&tasks, t]() {
+                    for (size_t i = t; i < tasks.size(); i += 4) {
+                        tasks[i]();
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        });
+    BOOST_CHECK_EQUAL(threaded.write(), sequential.write());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
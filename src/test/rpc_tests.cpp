@@ -8,6 +8,7 @@
 #include <rpc/util.h>
 
 #include <config.h>
+#include <httprpc.h>
 #include <interfaces/chain.h>
 #include <node/context.h>
 #include <util/time.h>
@@ -558,4 +559,23 @@ BOOST_AUTO_TEST_CASE(help_example) {
                    HelpExampleRpcNamed("foo", {{"arg", "true"}}));
 }
 
+BOOST_AUTO_TEST_CASE(peek_jsonrpc_method) {
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(""), "");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod("{}"), "");
+    BOOST_CHECK_EQUAL(
+        PeekJSONRPCMethod(R"({"method":"getblock","params":[],"id":1})"),
+        "getblock");
+    BOOST_CHECK_EQUAL(
+        PeekJSONRPCMethod(R"({"id": 1, "method" :  "getblockcount"})"),
+        "getblockcount");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod("{\"method\"\n:\t\"help\"}"), "help");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(R"({"method":"")"), "");
+
+    // Malformed or truncated requests
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(R"({"method":"getbl)"), "");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(R"({"method":)"), "");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(R"({"method" "getblock"})"), "");
+    BOOST_CHECK_EQUAL(PeekJSONRPCMethod(R"({"method": 42})"), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
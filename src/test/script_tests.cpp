@@ -3,6 +3,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <script/interpreter.h>
 #include <script/script.h>
 #include <script/script_error.h>
 #include <script/sighashtype.h>
@@ -11,6 +12,7 @@
 
 #include <core_io.h>
 #include <key.h>
+#include <policy/policy.h>
 #include <rpc/util.h>
 #include <streams.h>
 #include <util/strencodings.h>
@@ -32,6 +34,7 @@
 #include <univalue.h>
 
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -142,6 +145,33 @@ static void DoTest(const CScript &scriptPubKey, const CScript &scriptSig,
                                                 FormatScriptError(scriptError) +
                                                 " expected: " + message);
 
+    // The standard templates fast path must behave exactly like the
+    // interpreter.
+    {
+        const MutableTransactionSignatureChecker checker(
+            &tx, 0, txCredit.vout[0].nValue);
+        ScriptExecutionMetrics metrics, fastMetrics;
+        ScriptError fastErr;
+        BOOST_CHECK_MESSAGE(VerifyScriptWithInterpreter(scriptSig,
+                                                        scriptPubKey, flags,
+                                                        checker, metrics,
+                                                        &err) == expect,
+                            message);
+        BOOST_CHECK_MESSAGE(err == scriptError, message);
+        const std::optional<bool> fastRet = VerifyStandardScript(
+            scriptSig, scriptPubKey, flags, checker, fastMetrics, &fastErr);
+        if (fastRet) {
+            BOOST_CHECK_MESSAGE(*fastRet == expect, message);
+            BOOST_CHECK_MESSAGE(fastErr == scriptError,
+                                FormatScriptError(fastErr) + " where " +
+                                    FormatScriptError(scriptError) +
+                                    " expected: " + message);
+            if (expect) {
+                BOOST_CHECK_EQUAL(fastMetrics.nSigChecks, metrics.nSigChecks);
+            }
+        }
+    }
+
     // Verify that removing flags from a passing test or adding flags to a
     // failing test does not change the result, except for some special flags.
     for (int i = 0; i < 16; ++i) {
@@ -2453,27 +2483,27 @@ BOOST_AUTO_TEST_CASE(script_PushData) {
     static const uint8_t pushdata4[] = {OP_PUSHDATA4, 1, 0, 0, 0, 0x5a};
 
     ScriptError err;
-    std::vector<std::vector<uint8_t>> directStack;
+    std::vector<StackElement> directStack;
     BOOST_CHECK(EvalScript(directStack,
                            CScript(direct, direct + sizeof(direct)),
                            SCRIPT_VERIFY_P2SH, BaseSignatureChecker(), &err));
     BOOST_CHECK_MESSAGE(err == ScriptError::OK, ScriptErrorString(err));
 
-    std::vector<std::vector<uint8_t>> pushdata1Stack;
+    std::vector<StackElement> pushdata1Stack;
     BOOST_CHECK(EvalScript(pushdata1Stack,
                            CScript(pushdata1, pushdata1 + sizeof(pushdata1)),
                            SCRIPT_VERIFY_P2SH, BaseSignatureChecker(), &err));
     BOOST_CHECK(pushdata1Stack == directStack);
     BOOST_CHECK_MESSAGE(err == ScriptError::OK, ScriptErrorString(err));
 
-    std::vector<std::vector<uint8_t>> pushdata2Stack;
+    std::vector<StackElement> pushdata2Stack;
     BOOST_CHECK(EvalScript(pushdata2Stack,
                            CScript(pushdata2, pushdata2 + sizeof(pushdata2)),
                            SCRIPT_VERIFY_P2SH, BaseSignatureChecker(), &err));
     BOOST_CHECK(pushdata2Stack == directStack);
     BOOST_CHECK_MESSAGE(err == ScriptError::OK, ScriptErrorString(err));
 
-    std::vector<std::vector<uint8_t>> pushdata4Stack;
+    std::vector<StackElement> pushdata4Stack;
     BOOST_CHECK(EvalScript(pushdata4Stack,
                            CScript(pushdata4, pushdata4 + sizeof(pushdata4)),
                            SCRIPT_VERIFY_P2SH, BaseSignatureChecker(), &err));
@@ -2484,7 +2514,7 @@ BOOST_AUTO_TEST_CASE(script_PushData) {
     const std::vector<uint8_t> pushdata2_trunc{OP_PUSHDATA2, 1, 0};
     const std::vector<uint8_t> pushdata4_trunc{OP_PUSHDATA4, 1, 0, 0, 0};
 
-    std::vector<std::vector<uint8_t>> stack_ignore;
+    std::vector<StackElement> stack_ignore;
     BOOST_CHECK(!EvalScript(
         stack_ignore, CScript(pushdata1_trunc.begin(), pushdata1_trunc.end()),
         SCRIPT_VERIFY_P2SH, BaseSignatureChecker(), &err));
@@ -2502,7 +2532,7 @@ BOOST_AUTO_TEST_CASE(script_PushData) {
 BOOST_AUTO_TEST_CASE(script_cltv_truncated) {
     const auto script_cltv_trunc = CScript() << OP_CHECKLOCKTIMEVERIFY;
 
-    std::vector<std::vector<uint8_t>> stack_ignore;
+    std::vector<StackElement> stack_ignore;
     ScriptError err;
     BOOST_CHECK(!EvalScript(stack_ignore, script_cltv_trunc,
                             SCRIPT_VERIFY_CHECKLOCKTIMEVERIFY,
@@ -2715,6 +2745,150 @@ SignatureData CombineSignatures(const CTxOut &txout,
     return data;
 }
 
+/**
+ * Check that the standard templates fast path verifies a spend with the same
+ * result, error and metrics as the interpreter.
+ */
+static void CheckStandardScript(const CScript &scriptSig,
+                                const CScript &scriptPubKey,
+                                const CTransaction &txTo, uint32_t flags,
+                                bool expected, ScriptError expectedError,
+                                int expectedSigChecks) {
+    const TransactionSignatureChecker checker(&txTo, 0, SATOSHI);
+    ScriptExecutionMetrics metrics, fastMetrics;
+    ScriptError err, fastErr;
+    BOOST_CHECK_EQUAL(VerifyScriptWithInterpreter(scriptSig, scriptPubKey,
+                                                  flags, checker, metrics,
+                                                  &err),
+                      expected);
+    BOOST_CHECK_EQUAL(ScriptErrorString(err),
+                      ScriptErrorString(expectedError));
+
+    const std::optional<bool> fastRet = VerifyStandardScript(
+        scriptSig, scriptPubKey, flags, checker, fastMetrics, &fastErr);
+    BOOST_REQUIRE(fastRet.has_value());
+    BOOST_CHECK_EQUAL(*fastRet, expected);
+    BOOST_CHECK_EQUAL(ScriptErrorString(fastErr),
+                      ScriptErrorString(expectedError));
+    if (expected) {
+        BOOST_CHECK_EQUAL(metrics.nSigChecks, expectedSigChecks);
+        BOOST_CHECK_EQUAL(fastMetrics.nSigChecks, expectedSigChecks);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script_standard_templates) {
+    const uint32_t flags = STANDARD_SCRIPT_VERIFY_FLAGS;
+    const SigHashType sigHashType = SigHashType().withForkId();
+
+    std::vector<CKey> keys(3);
+    for (CKey &key : keys) {
+        key.MakeNewKey(true);
+    }
+    const CPubKey pubkey = keys[0].GetPubKey();
+
+    auto makeSpend = [](const CScript &scriptPubKey) {
+        const CTransaction txFrom{
+            BuildCreditingTransaction(scriptPubKey, SATOSHI)};
+        return CTransaction(BuildSpendingTransaction(CScript(), txFrom));
+    };
+    auto signECDSA = [&](const CKey &key, const CScript &scriptCode,
+                         const CTransaction &txTo) {
+        std::vector<uint8_t> sig;
+        BOOST_CHECK(key.SignECDSA(
+            SignatureHash(scriptCode, txTo, 0, sigHashType, SATOSHI), sig));
+        sig.push_back(sigHashType.getRawSigHashType());
+        return sig;
+    };
+    auto signSchnorr = [&](const CKey &key, const CScript &scriptCode,
+                           const CTransaction &txTo) {
+        std::vector<uint8_t> sig;
+        BOOST_CHECK(key.SignSchnorr(
+            SignatureHash(scriptCode, txTo, 0, sigHashType, SATOSHI), sig));
+        sig.push_back(sigHashType.getRawSigHashType());
+        return sig;
+    };
+
+    // P2PKH
+    const CScript p2pkh = GetScriptForDestination(PKHash(pubkey));
+    const CTransaction txP2PKH = makeSpend(p2pkh);
+    std::vector<uint8_t> sig = signECDSA(keys[0], p2pkh, txP2PKH);
+    CheckStandardScript(CScript() << sig << ToByteVector(pubkey), p2pkh,
+                        txP2PKH, flags, true, ScriptError::OK, 1);
+    CheckStandardScript(CScript() << signSchnorr(keys[0], p2pkh, txP2PKH)
+                                  << ToByteVector(pubkey),
+                        p2pkh, txP2PKH, flags, true, ScriptError::OK, 1);
+    sig[10] ^= 1;
+    CheckStandardScript(CScript() << sig << ToByteVector(pubkey), p2pkh,
+                        txP2PKH, flags, false, ScriptError::SIG_NULLFAIL, 0);
+    CheckStandardScript(CScript() << sig << ToByteVector(pubkey), p2pkh,
+                        txP2PKH, flags & ~SCRIPT_VERIFY_NULLFAIL, false,
+                        ScriptError::EVAL_FALSE, 0);
+
+    // P2PK
+    const CScript p2pk = GetScriptForRawPubKey(pubkey);
+    const CTransaction txP2PK = makeSpend(p2pk);
+    CheckStandardScript(CScript() << signECDSA(keys[0], p2pk, txP2PK), p2pk,
+                        txP2PK, flags, true, ScriptError::OK, 1);
+    CheckStandardScript(CScript() << std::vector<uint8_t>(), p2pk, txP2PK,
+                        flags, false, ScriptError::EVAL_FALSE, 0);
+
+    // P2SH 2-of-3 multisig
+    const CScript redeemScript = GetScriptForMultisig(
+        2, {keys[0].GetPubKey(), keys[1].GetPubKey(), keys[2].GetPubKey()});
+    const CScript p2sh = GetScriptForDestination(ScriptHash(redeemScript));
+    const CTransaction txP2SH = makeSpend(p2sh);
+    const std::vector<uint8_t> redeemBytes(redeemScript.begin(),
+                                           redeemScript.end());
+
+    // Legacy mode, which counts a sigcheck for each key
+    CheckStandardScript(CScript()
+                            << OP_0 << signECDSA(keys[0], redeemScript, txP2SH)
+                            << signECDSA(keys[2], redeemScript, txP2SH)
+                            << redeemBytes,
+                        p2sh, txP2SH, flags, true, ScriptError::OK, 3);
+    // The signatures must be in the order of the keys
+    CheckStandardScript(CScript()
+                            << OP_0 << signECDSA(keys[2], redeemScript, txP2SH)
+                            << signECDSA(keys[0], redeemScript, txP2SH)
+                            << redeemBytes,
+                        p2sh, txP2SH, flags, false, ScriptError::SIG_NULLFAIL,
+                        0);
+
+    // Schnorr mode, with a bitfield selecting the keys
+    CheckStandardScript(
+        CScript() << OP_5
+                  << signSchnorr(keys[0], redeemScript, txP2SH)
+                  << signSchnorr(keys[2], redeemScript, txP2SH) << redeemBytes,
+        p2sh, txP2SH, flags, true, ScriptError::OK, 2);
+    CheckStandardScript(
+        CScript() << OP_3
+                  << signSchnorr(keys[0], redeemScript, txP2SH)
+                  << signSchnorr(keys[2], redeemScript, txP2SH) << redeemBytes,
+        p2sh, txP2SH, flags, false, ScriptError::SIG_NULLFAIL, 0);
+    CheckStandardScript(
+        CScript() << OP_7
+                  << signSchnorr(keys[0], redeemScript, txP2SH)
+                  << signSchnorr(keys[2], redeemScript, txP2SH) << redeemBytes,
+        p2sh, txP2SH, flags, false, ScriptError::INVALID_BIT_COUNT, 0);
+
+    // The scripts which don't match the templates, or fail before checking any
+    // signature, are left to the interpreter.
+    ScriptExecutionMetrics metrics;
+    const TransactionSignatureChecker checker(&txP2PKH, 0, SATOSHI);
+    BOOST_CHECK(!VerifyStandardScript(CScript() << sig << OP_1, p2pkh, flags,
+                                      checker, metrics));
+    BOOST_CHECK(!VerifyStandardScript(CScript() << sig << ToByteVector(pubkey),
+                                      p2sh, flags, checker, metrics));
+    BOOST_CHECK(!VerifyStandardScript(
+        CScript() << sig << ToByteVector(keys[1].GetPubKey()), p2pkh, flags,
+        checker, metrics));
+    BOOST_CHECK(!VerifyStandardScript(CScript() << OP_0 << sig << redeemBytes,
+                                      p2sh, flags, checker, metrics));
+    BOOST_CHECK(!VerifyStandardScript(
+        CScript() << OP_0 << sig << sig << redeemBytes, p2sh,
+        flags & ~SCRIPT_VERIFY_P2SH, checker, metrics));
+}
+
 BOOST_AUTO_TEST_CASE(script_combineSigs) {
     // Test the ProduceSignature's ability to combine signatures function
     FillableSigningProvider keystore;
@@ -0,0 +1,164 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <shortidsketch.h>
+
+#include <random.h>
+#include <streams.h>
+#include <version.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(shortidsketch_tests, BasicTestingSetup)
+
+// The decoding fails with a small probability, so the short ids are picked
+// deterministically.
+static std::vector<uint64_t> RandomShortIds(FastRandomContext &rng,
+                                            size_t count) {
+    std::vector<uint64_t> shortids(count);
+    for (uint64_t &shortid : shortids) {
+        shortid = rng.rand64();
+    }
+    std::sort(shortids.begin(), shortids.end());
+    return shortids;
+}
+
+static void CheckDecode(const ShortIdSketch &sketch,
+                        std::vector<uint64_t> expectedAdded,
+                        std::vector<uint64_t> expectedRemoved) {
+    std::vector<uint64_t> added, removed;
+    BOOST_CHECK(sketch.decode(added, removed));
+
+    std::sort(added.begin(), added.end());
+    std::sort(removed.begin(), removed.end());
+    std::sort(expectedAdded.begin(), expectedAdded.end());
+    std::sort(expectedRemoved.begin(), expectedRemoved.end());
+    BOOST_CHECK(added == expectedAdded);
+    BOOST_CHECK(removed == expectedRemoved);
+}
+
+BOOST_AUTO_TEST_CASE(sketch_layout) {
+    // A default constructed sketch can't be decoded
+    ShortIdSketch invalid;
+    BOOST_CHECK(!invalid.isValid());
+    std::vector<uint64_t> added, removed;
+    BOOST_CHECK(!invalid.decode(added, removed));
+
+    for (size_t capacity : {0, 1, 2, 3, 10, 11, 1000}) {
+        ShortIdSketch sketch(capacity);
+        BOOST_CHECK(sketch.isValid());
+        BOOST_CHECK_EQUAL(sketch.getCellCount() % ShortIdSketch::NUM_HASHES,
+                          0);
+        BOOST_CHECK_GE(sketch.getCellCount(), 2 * capacity);
+
+        // An empty sketch decodes to nothing
+        CheckDecode(sketch, {}, {});
+    }
+}
+
+BOOST_AUTO_TEST_CASE(insert_and_erase) {
+    FastRandomContext rng(true);
+    ShortIdSketch sketch(10);
+    const std::vector<uint64_t> shortids = RandomShortIds(rng, 5);
+
+    for (uint64_t shortid : shortids) {
+        sketch.insert(shortid);
+    }
+    CheckDecode(sketch, shortids, {});
+
+    for (uint64_t shortid : shortids) {
+        sketch.erase(shortid);
+    }
+    CheckDecode(sketch, {}, {});
+
+    sketch.erase(shortids[0]);
+    CheckDecode(sketch, {}, {shortids[0]});
+
+    sketch.insert(shortids[0]);
+    sketch.insert(shortids[1]);
+    sketch.clear();
+    CheckDecode(sketch, {}, {});
+}
+
+BOOST_AUTO_TEST_CASE(reconcile_sets) {
+    FastRandomContext rng(true);
+    const std::vector<uint64_t> common = RandomShortIds(rng, 10000);
+
+    for (size_t capacity : {10, 100, 1000}) {
+        const std::vector<uint64_t> onlyOurs =
+            RandomShortIds(rng, capacity / 2);
+        const std::vector<uint64_t> onlyTheirs =
+            RandomShortIds(rng, capacity - onlyOurs.size());
+
+        ShortIdSketch ours(capacity);
+        ShortIdSketch theirs(capacity);
+        for (uint64_t shortid : common) {
+            ours.insert(shortid);
+            theirs.insert(shortid);
+        }
+        for (uint64_t shortid : onlyOurs) {
+            ours.insert(shortid);
+        }
+        for (uint64_t shortid : onlyTheirs) {
+            theirs.insert(shortid);
+        }
+
+        // Decoding the sketches directly fails because they are full
+        std::vector<uint64_t> added, removed;
+        BOOST_CHECK(!ours.decode(added, removed));
+
+        ShortIdSketch difference(ours);
+        difference -= theirs;
+        CheckDecode(difference, onlyOurs, onlyTheirs);
+
+        // The sketch is antisymmetric
+        difference = theirs;
+        difference -= ours;
+        CheckDecode(difference, onlyTheirs, onlyOurs);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(capacity_exceeded) {
+    FastRandomContext rng(true);
+    ShortIdSketch ours(10);
+    ShortIdSketch theirs(10);
+    for (uint64_t shortid : RandomShortIds(rng, 100)) {
+        ours.insert(shortid);
+    }
+    for (uint64_t shortid : RandomShortIds(rng, 100)) {
+        theirs.insert(shortid);
+    }
+
+    ours -= theirs;
+    std::vector<uint64_t> added, removed;
+    BOOST_CHECK(!ours.decode(added, removed));
+    // No more short ids than the cell count are ever returned
+    BOOST_CHECK_LE(added.size() + removed.size(), ours.getCellCount());
+}
+
+BOOST_AUTO_TEST_CASE(serialization) {
+    FastRandomContext rng(true);
+    ShortIdSketch sketch(20);
+    const std::vector<uint64_t> shortids = RandomShortIds(rng, 10);
+    for (uint64_t shortid : shortids) {
+        sketch.insert(shortid);
+    }
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << sketch;
+    // Cell count, then 20 bytes per cell
+    BOOST_CHECK_EQUAL(ss.size(), 1 + 20 * sketch.getCellCount());
+
+    ShortIdSketch deserialized;
+    ss >> deserialized;
+    BOOST_CHECK_EQUAL(deserialized.getCellCount(), sketch.getCellCount());
+    CheckDecode(deserialized, shortids, {});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,8 +6,12 @@
 
 #include <script/sigcache.h>
 
+#include <clientversion.h>
+#include <crypto/sha256.h>
+#include <fs.h>
 #include <key.h>
 #include <key_io.h>
+#include <script/shardedcache.h>
 #include <streams.h>
 #include <tinyformat.h>
 #include <util/strencodings.h>
@@ -16,6 +20,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -115,4 +120,81 @@ BOOST_AUTO_TEST_CASE(sig_pubkey_hash_variations) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(sigcache_persist) {
+    CDataStream stream(
+        ParseHex(
+            "010000000122739e70fbee987a8be1788395a2f2e6ad18ccb7ff611cd798071539"
+            "dde3c38e000000000151ffffffff010000000000000000016a00000000"),
+        SER_NETWORK, PROTOCOL_VERSION);
+    CTransaction dummyTx(deserialize, stream);
+    PrecomputedTransactionData txdata(dummyTx);
+    CachingTransactionSignatureChecker checker(&dummyTx, 0, 0 * SATOSHI, true,
+                                               txdata);
+    TestCachingTransactionSignatureChecker testChecker(checker);
+
+    CKey key;
+    key.MakeNewKey(true);
+    const CPubKey pubkey = key.GetPubKey();
+    const uint256 hash = InsecureRand256();
+    std::vector<uint8_t> sig;
+    BOOST_CHECK(key.SignECDSA(hash, sig));
+    BOOST_CHECK(!testChecker.IsCached(sig, pubkey, hash));
+
+    // Craft a dump salted with another nonce and containing the signature.
+    const uint256 nonce = InsecureRand256();
+    uint256 entry;
+    CSHA256()
+        .Write(nonce.begin(), 32)
+        .Write(nonce.begin(), 32)
+        .Write(hash.begin(), 32)
+        .Write(pubkey.data(), pubkey.size())
+        .Write(sig.data(), sig.size())
+        .Finalize(entry.begin());
+
+    const fs::path path = gArgs.GetDataDirNet() / "sigcache.dat";
+    auto WriteDump = [&](int client_version) {
+        CAutoFile file(fsbridge::fopen(path, "wb"), SER_DISK, CLIENT_VERSION);
+        file << SCRIPT_CACHE_DUMP_VERSION << client_version << nonce
+             << std::vector<uint256>{entry};
+    };
+
+    // Dumps from another client version are ignored.
+    WriteDump(CLIENT_VERSION + 1);
+    BOOST_CHECK(!LoadSignatureCache(path));
+    BOOST_CHECK(!testChecker.IsCached(sig, pubkey, hash));
+
+    // Loading the dump makes the signature hit the cache, as the entries are
+    // now salted with the dumped nonce.
+    WriteDump(CLIENT_VERSION);
+    BOOST_CHECK(LoadSignatureCache(path));
+    BOOST_CHECK(testChecker.IsCached(sig, pubkey, hash));
+
+    // The nonce and the entries are dumped back.
+    BOOST_CHECK(DumpSignatureCache(path));
+    {
+        CAutoFile file(fsbridge::fopen(path, "rb"), SER_DISK, CLIENT_VERSION);
+        uint64_t version;
+        int client_version;
+        uint256 dumped_nonce;
+        std::vector<uint256> entries;
+        file >> version >> client_version >> dumped_nonce >> entries;
+        BOOST_CHECK_EQUAL(version, SCRIPT_CACHE_DUMP_VERSION);
+        BOOST_CHECK_EQUAL(client_version, CLIENT_VERSION);
+        BOOST_CHECK(dumped_nonce == nonce);
+        BOOST_CHECK(std::find(entries.begin(), entries.end(), entry) !=
+                    entries.end());
+    }
+
+    // A missing or truncated file is rejected without altering the cache.
+    fs::remove(path);
+    BOOST_CHECK(!LoadSignatureCache(path));
+    {
+        CAutoFile file(fsbridge::fopen(path, "wb"), SER_DISK, CLIENT_VERSION);
+        file << SCRIPT_CACHE_DUMP_VERSION << CLIENT_VERSION << nonce
+             << uint64_t(10);
+    }
+    BOOST_CHECK(!LoadSignatureCache(path));
+    BOOST_CHECK(testChecker.IsCached(sig, pubkey, hash));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -7,10 +7,13 @@
 #include <script/interpreter.h>
 #include <script/script_error.h>
 
+#include <test/util/script.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+
 typedef std::vector<uint8_t> valtype;
 typedef std::vector<valtype> stacktype;
 
@@ -56,8 +59,7 @@ static class : public BaseSignatureChecker {
      * All null sigs verify false, and all checks using the magic 'bad pubkey'
      * value verify false as well. Otherwise, checks verify as true.
      */
-    bool VerifySignature(const std::vector<uint8_t> &vchSig,
-                         const CPubKey &vchPubKey,
+    bool VerifySignature(Span<const uint8_t> vchSig, const CPubKey &vchPubKey,
                          const uint256 &sighash) const final {
         if (vchPubKey == CPubKey(badpub)) {
             return false;
@@ -65,10 +67,10 @@ static class : public BaseSignatureChecker {
         return !vchSig.empty();
     }
 
-    bool CheckSig(const std::vector<uint8_t> &vchSigIn,
-                  const std::vector<uint8_t> &vchPubKey,
+    bool CheckSig(Span<const uint8_t> vchSigIn, Span<const uint8_t> vchPubKey,
                   const CScript &scriptCode, uint32_t flags) const final {
-        if (vchPubKey == badpub) {
+        if (std::equal(vchPubKey.begin(), vchPubKey.end(), badpub.begin(),
+                       badpub.end())) {
             return false;
         }
         return !vchSigIn.empty();
@@ -108,14 +110,14 @@ static void CheckEvalScript(const stacktype &original_stack,
                             std::vector<uint32_t> flagset = allflags) {
     for (uint32_t flags : flagset) {
         ScriptError err = ScriptError::UNKNOWN;
-        stacktype stack{original_stack};
+        std::vector<StackElement> stack = ToScriptStack(original_stack);
         ScriptExecutionMetrics metrics;
 
         bool r =
             EvalScript(stack, script, flags, dummysigchecker, metrics, &err);
         BOOST_CHECK(r);
         BOOST_CHECK_EQUAL(err, ScriptError::OK);
-        BOOST_CHECK(stack == expected_stack);
+        BOOST_CHECK(FromScriptStack(stack) == expected_stack);
         BOOST_CHECK_EQUAL(metrics.nSigChecks, expected_sigchecks);
     }
 }
@@ -213,13 +215,13 @@ BOOST_AUTO_TEST_CASE(test_evalscript) {
     // CHECKMULTISIG with schnorr cannot return false, it just fails instead
     // (hence, the sigchecks count is unimportant)
     {
-        stacktype stack{{1}, txsigschnorr};
+        std::vector<StackElement> stack = ToScriptStack({{1}, txsigschnorr});
         BOOST_CHECK(!EvalScript(
             stack, CScript() << 1 << badpub << 1 << OP_CHECKMULTISIG,
             SCRIPT_VERIFY_NONE, dummysigchecker));
     }
     {
-        stacktype stack{{1}, txsigschnorr};
+        std::vector<StackElement> stack = ToScriptStack({{1}, txsigschnorr});
         BOOST_CHECK(!EvalScript(
             stack, CScript() << 1 << badpub << 1 << OP_CHECKMULTISIG,
             SCRIPT_ENABLE_SCHNORR_MULTISIG, dummysigchecker));
@@ -227,7 +229,7 @@ BOOST_AUTO_TEST_CASE(test_evalscript) {
 
     // EvalScript cumulatively increases the sigchecks count.
     {
-        stacktype stack{txsigschnorr};
+        std::vector<StackElement> stack = ToScriptStack({txsigschnorr});
         ScriptExecutionMetrics metrics;
         metrics.nSigChecks = 12345;
         bool r = EvalScript(stack, CScript() << pub << OP_CHECKSIG,
@@ -11,6 +11,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+typedef std::vector<uint8_t> valtype;
+
 BOOST_FIXTURE_TEST_SUITE(sigencoding_tests, BasicTestingSetup)
 
 static valtype SignatureWithHashType(valtype vchSig, SigHashType sigHash) {
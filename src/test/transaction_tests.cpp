@@ -30,6 +30,7 @@
 #include <test/data/tx_valid.json.h>
 #include <test/jsonutil.h>
 #include <test/scriptflags.h>
+#include <test/util/script.h>
 #include <test/util/setup_common.h>
 #include <test/util/transaction_utils.h>
 
@@ -371,9 +372,11 @@ static CScript PushAll(const std::vector<valtype> &values) {
 }
 
 static void ReplaceRedeemScript(CScript &script, const CScript &redeemScript) {
-    std::vector<valtype> stack;
-    EvalScript(stack, script, SCRIPT_VERIFY_STRICTENC, BaseSignatureChecker());
-    BOOST_CHECK(stack.size() > 0);
+    std::vector<StackElement> scriptStack;
+    EvalScript(scriptStack, script, SCRIPT_VERIFY_STRICTENC,
+               BaseSignatureChecker());
+    BOOST_CHECK(scriptStack.size() > 0);
+    std::vector<valtype> stack = FromScriptStack(scriptStack);
     stack.back() =
         std::vector<uint8_t>(redeemScript.begin(), redeemScript.end());
     script = PushAll(stack);
@@ -931,4 +934,51 @@ BOOST_AUTO_TEST_CASE(tx_getvalueout) {
     BOOST_CHECK_THROW(overflow_sum_tx.GetValueOut(), std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(batch_hashing) {
+    std::vector<CMutableTransaction> mtxs(100);
+    for (size_t i = 0; i < mtxs.size(); i++) {
+        CMutableTransaction &mtx = mtxs[i];
+        mtx.nLockTime = i;
+        mtx.vin.resize(1 + InsecureRandRange(10));
+        for (auto &txin : mtx.vin) {
+            txin.prevout = COutPoint(TxId(InsecureRand256()), InsecureRand32());
+            txin.scriptSig = CScript() << g_insecure_rand_ctx.randbytes(
+                                 InsecureRandRange(200));
+            txin.nSequence = InsecureRand32();
+        }
+        mtx.vout.resize(InsecureRandRange(10));
+        for (auto &txout : mtx.vout) {
+            txout.nValue = int64_t(InsecureRand32()) * SATOSHI;
+            txout.scriptPubKey = CScript() << g_insecure_rand_ctx.randbytes(
+                                     InsecureRandRange(100));
+        }
+    }
+
+    std::vector<TxId> txids;
+    for (const auto &mtx : mtxs) {
+        txids.push_back(mtx.GetId());
+    }
+
+    const std::vector<CTransactionRef> txs =
+        MakeTransactionRefs(std::vector<CMutableTransaction>(mtxs));
+    BOOST_REQUIRE_EQUAL(txs.size(), mtxs.size());
+    for (size_t i = 0; i < txs.size(); i++) {
+        BOOST_CHECK(txs[i]->GetId() == txids[i]);
+        BOOST_CHECK(*txs[i] == CTransaction(mtxs[i]));
+    }
+
+    const std::vector<PrecomputedTransactionData> txsdata =
+        PrecomputeTransactionsData(txs);
+    BOOST_REQUIRE_EQUAL(txsdata.size(), txs.size());
+    for (size_t i = 0; i < txs.size(); i++) {
+        const PrecomputedTransactionData txdata(*txs[i]);
+        BOOST_CHECK(txsdata[i].hashPrevouts == txdata.hashPrevouts);
+        BOOST_CHECK(txsdata[i].hashSequence == txdata.hashSequence);
+        BOOST_CHECK(txsdata[i].hashOutputs == txdata.hashOutputs);
+    }
+
+    BOOST_CHECK(MakeTransactionRefs({}).empty());
+    BOOST_CHECK(PrecomputeTransactionsData({}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
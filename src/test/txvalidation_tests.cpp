@@ -6,6 +6,7 @@
 #include <consensus/validation.h>
 #include <primitives/transaction.h>
 #include <script/script.h>
+#include <txmempool.h>
 #include <validation.h>
 
 #include <test/util/setup_common.h>
@@ -48,4 +49,40 @@ BOOST_FIXTURE_TEST_CASE(tx_mempool_reject_coinbase, TestChain100Setup) {
     BOOST_CHECK_EQUAL(result.m_state.GetRejectReason(), "bad-tx-coinbase");
     BOOST_CHECK(result.m_state.GetResult() == TxValidationResult::TX_CONSENSUS);
 }
+
+/**
+ * Ensure that the sighash midstates computed on acceptance are kept in the
+ * mempool entry, so they can be reused when connecting the block.
+ */
+BOOST_FIXTURE_TEST_CASE(tx_mempool_precomputed_txdata, TestChain100Setup) {
+    const CScript scriptPubKey = CScript()
+                                 << ToByteVector(coinbaseKey.GetPubKey())
+                                 << OP_CHECKSIG;
+    const CMutableTransaction mtx = CreateValidMempoolTransaction(
+        m_coinbase_txns[0], /*input_vout=*/0, /*input_height=*/1, coinbaseKey,
+        scriptPubKey);
+
+    {
+        LOCK(m_node.mempool->cs);
+        const std::optional<CTxMemPool::txiter> it =
+            m_node.mempool->GetIter(mtx.GetId());
+        BOOST_REQUIRE(it);
+        const PrecomputedTransactionData *txdata =
+            (*it)->GetPrecomputedTxData();
+        BOOST_REQUIRE(txdata);
+
+        const PrecomputedTransactionData expected(mtx);
+        BOOST_CHECK(txdata->hashPrevouts == expected.hashPrevouts);
+        BOOST_CHECK(txdata->hashSequence == expected.hashSequence);
+        BOOST_CHECK(txdata->hashOutputs == expected.hashOutputs);
+    }
+
+    // The block is valid when its transaction data comes from the mempool.
+    const CBlock block = CreateAndProcessBlock({mtx}, scriptPubKey);
+    LOCK(cs_main);
+    BOOST_CHECK_EQUAL(m_node.chainman->ActiveTip()->GetBlockHash(),
+                      block.GetHash());
+    BOOST_CHECK_EQUAL(m_node.mempool->size(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
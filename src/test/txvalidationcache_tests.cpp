@@ -3,14 +3,18 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chain.h>
+#include <clientversion.h>
 #include <config.h>
 #include <consensus/validation.h>
+#include <crypto/sha256.h>
+#include <fs.h>
 #include <key.h>
 #include <policy/policy.h>
 #include <script/scriptcache.h>
 #include <script/sighashtype.h>
 #include <script/sign.h>
 #include <script/signingprovider.h>
+#include <streams.h>
 #include <txmempool.h>
 #include <validation.h>
 
@@ -690,4 +694,42 @@ BOOST_AUTO_TEST_CASE(scriptcache_values) {
     CHECK_CACHE_HAS(key1A, 42);
 }
 
+BOOST_FIXTURE_TEST_CASE(scriptcache_persist, BasicTestingSetup) {
+    InitScriptExecutionCache();
+
+    CMutableTransaction mtx;
+    mtx.nVersion = 1;
+    const CTransaction tx(mtx);
+    const uint32_t flags = 0x7fffffff;
+    CHECK_CACHE_MISSING(ScriptCacheKey(tx, flags));
+
+    // Craft a dump salted with another nonce and containing the transaction.
+    const uint256 nonce = InsecureRand256();
+    uint256 hash;
+    CSHA256()
+        .Write(nonce.begin(), 32)
+        .Write(nonce.begin(), 32)
+        .Write(tx.GetHash().begin(), 32)
+        .Write((const uint8_t *)&flags, sizeof(flags))
+        .Finalize(hash.begin());
+    std::array<uint8_t, 28> key;
+    std::copy(hash.begin(), hash.begin() + key.size(), key.begin());
+
+    const fs::path path = gArgs.GetDataDirNet() / "scriptcache.dat";
+    {
+        CAutoFile file(fsbridge::fopen(path, "wb"), SER_DISK, CLIENT_VERSION);
+        file << SCRIPT_CACHE_DUMP_VERSION << CLIENT_VERSION << nonce
+             << COMPACTSIZE(uint64_t(1)) << key << int(42);
+    }
+    BOOST_CHECK(LoadScriptExecutionCache(path));
+    CHECK_CACHE_HAS(ScriptCacheKey(tx, flags), 42);
+
+    // Dumping and loading again preserves the entries.
+    BOOST_CHECK(DumpScriptExecutionCache(path));
+    InitScriptExecutionCache();
+    CHECK_CACHE_MISSING(ScriptCacheKey(tx, flags));
+    BOOST_CHECK(LoadScriptExecutionCache(path));
+    CHECK_CACHE_HAS(ScriptCacheKey(tx, flags), 42);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,25 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/script.h>
+
+std::vector<StackElement>
+ToScriptStack(const std::vector<std::vector<uint8_t>> &stack) {
+    std::vector<StackElement> result;
+    result.reserve(stack.size());
+    for (const std::vector<uint8_t> &element : stack) {
+        result.emplace_back(element.begin(), element.end());
+    }
+    return result;
+}
+
+std::vector<std::vector<uint8_t>>
+FromScriptStack(const std::vector<StackElement> &stack) {
+    std::vector<std::vector<uint8_t>> result;
+    result.reserve(stack.size());
+    for (const StackElement &element : stack) {
+        result.emplace_back(element.begin(), element.end());
+    }
+    return result;
+}
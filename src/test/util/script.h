@@ -0,0 +1,21 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_TEST_UTIL_SCRIPT_H
+#define BITCOIN_TEST_UTIL_SCRIPT_H
+
+#include <script/interpreter.h>
+
+#include <cstdint>
+#include <vector>
+
+/** Convert a stack of byte vectors to a script interpreter stack */
+std::vector<StackElement>
+ToScriptStack(const std::vector<std::vector<uint8_t>> &stack);
+
+/** Convert a script interpreter stack to a stack of byte vectors */
+std::vector<std::vector<uint8_t>>
+FromScriptStack(const std::vector<StackElement> &stack);
+
+#endif // BITCOIN_TEST_UTIL_SCRIPT_H
@@ -5,6 +5,7 @@
 #include <chainparams.h>
 #include <config.h>
 #include <consensus/validation.h>
+#include <hash.h>
 #include <node/utxo_snapshot.h>
 #include <random.h>
 #include <rpc/blockchain.h>
@@ -16,10 +17,16 @@
 
 #include <tinyformat.h>
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+using node::DecodeSnapshotChunk;
+using node::SNAPSHOT_CHUNK_MAX_COINS;
+using node::SNAPSHOT_VERSION;
+using node::SnapshotChunk;
+using node::SnapshotChunkWriter;
 using node::SnapshotMetadata;
 
 BOOST_FIXTURE_TEST_SUITE(validation_chainstatemanager_tests, ChainTestingSetup)
@@ -205,14 +212,17 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_snapshot,
     BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
         m_node, m_path_root,
         [](CAutoFile &auto_infile, SnapshotMetadata &metadata) {
-            // A UTXO is missing but count is correct
-            metadata.m_coins_count -= 1;
-
-            COutPoint outpoint;
-            Coin coin;
+            // A chunk of UTXOs is missing but count is correct
+            SnapshotChunk chunk;
+            auto_infile >> chunk;
 
-            auto_infile >> outpoint;
-            auto_infile >> coin;
+            metadata.m_coins_count -= chunk.m_coins_count;
+        }));
+    BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
+        m_node, m_path_root,
+        [](CAutoFile &auto_infile, SnapshotMetadata &metadata) {
+            // Unknown snapshot format
+            metadata.m_version = SNAPSHOT_VERSION + 1;
         }));
     BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
         m_node, m_path_root,
@@ -410,4 +420,73 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_loadblockindex, TestChain100Setup) {
     BOOST_CHECK_EQUAL(cs2.setBlockIndexCandidates.size(), num_indexes);
 }
 
+BOOST_AUTO_TEST_CASE(snapshot_chunk) {
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    size_t legacy_size = 0;
+    for (int i = 0; i < 10; i++) {
+        const TxId txid{InsecureRand256()};
+        for (uint32_t n = 0; n < 5; n++) {
+            Coin coin{CTxOut(int64_t(InsecureRandRange(1000)) * SATOSHI,
+                             CScript() << OP_TRUE),
+                      uint32_t(InsecureRandRange(1000)), n == 0};
+            legacy_size += GetSerializeSize(COutPoint(txid, n)) +
+                           GetSerializeSize(coin, PROTOCOL_VERSION);
+            coins.emplace_back(COutPoint(txid, n), std::move(coin));
+        }
+    }
+    std::sort(coins.begin(), coins.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    });
+
+    SnapshotChunkWriter writer;
+    BOOST_CHECK(writer.IsEmpty());
+    for (const auto &[outpoint, coin] : coins) {
+        writer.Add(outpoint, coin);
+    }
+    BOOST_CHECK(!writer.IsEmpty());
+    BOOST_CHECK(!writer.IsFull());
+
+    const SnapshotChunk chunk = writer.Finalize();
+    BOOST_CHECK(writer.IsEmpty());
+    BOOST_CHECK_EQUAL(chunk.m_coins_count, coins.size());
+    // The txids are only stored once
+    BOOST_CHECK_LT(chunk.m_data.size(), legacy_size);
+
+    std::vector<std::pair<COutPoint, Coin>> decoded;
+    BOOST_REQUIRE(DecodeSnapshotChunk(chunk, decoded));
+    BOOST_REQUIRE_EQUAL(decoded.size(), coins.size());
+    for (size_t i = 0; i < coins.size(); i++) {
+        BOOST_CHECK(decoded[i].first == coins[i].first);
+        BOOST_CHECK(decoded[i].second.GetTxOut() == coins[i].second.GetTxOut());
+        BOOST_CHECK_EQUAL(decoded[i].second.GetHeight(),
+                          coins[i].second.GetHeight());
+        BOOST_CHECK_EQUAL(decoded[i].second.IsCoinBase(),
+                          coins[i].second.IsCoinBase());
+    }
+
+    // Corrupted chunks are rejected
+    SnapshotChunk corrupted = chunk;
+    corrupted.m_data[InsecureRandRange(chunk.m_data.size())] ^= 0x01;
+    BOOST_CHECK(!DecodeSnapshotChunk(corrupted, decoded));
+
+    corrupted = chunk;
+    corrupted.m_coins_count++;
+    BOOST_CHECK(!DecodeSnapshotChunk(corrupted, decoded));
+
+    corrupted = chunk;
+    corrupted.m_data.push_back(0);
+    corrupted.m_hash = Hash(corrupted.m_data);
+    BOOST_CHECK(!DecodeSnapshotChunk(corrupted, decoded));
+
+    // The chunks are closed after the maximum number of coins
+    const Coin coin{CTxOut(SATOSHI, CScript() << OP_TRUE), 1, false};
+    for (uint32_t n = 0; n < SNAPSHOT_CHUNK_MAX_COINS; n++) {
+        BOOST_CHECK(!writer.IsFull());
+        writer.Add(COutPoint(TxId(uint256::ONE), n), coin);
+    }
+    BOOST_CHECK(writer.IsFull());
+    BOOST_CHECK(DecodeSnapshotChunk(writer.Finalize(), decoded));
+    BOOST_CHECK_EQUAL(decoded.size(), SNAPSHOT_CHUNK_MAX_COINS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
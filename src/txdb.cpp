@@ -11,11 +11,17 @@
 #include <random.h>
 #include <shutdown.h>
 #include <util/system.h>
+#include <util/time.h>
 #include <util/translation.h>
 #include <util/vector.h>
 #include <version.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <future>
 #include <memory>
 
 static const char DB_COIN = 'C';
@@ -115,8 +121,65 @@ std::vector<BlockHash> CCoinsViewDB::GetHeadBlocks() const {
     return vhashHeadBlocks;
 }
 
+namespace {
+//! Dirty coins cache entries of a flush, partitioned on the first byte of the
+//! txid, i.e. the first byte of the database key after DB_COIN.
+using CoinPartitions =
+    std::array<std::vector<const CCoinsMap::value_type *>, 256>;
+
+//! Below this number of changed coins a flush is written by a single thread
+static constexpr size_t MIN_PARALLEL_WRITE_COINS = 1 << 16;
+
+/**
+ * Compare the database keys of two outpoints: the raw txid bytes, then the
+ * output index whose VARINT encoding preserves the ordering. This is not the
+ * COutPoint order, which compares the txids as numbers.
+ */
+bool CoinKeyLess(const COutPoint &a, const COutPoint &b) {
+    const int cmp = std::memcmp(a.GetTxId().begin(), b.GetTxId().begin(),
+                                a.GetTxId().size());
+    return cmp < 0 || (cmp == 0 && a.GetN() < b.GetN());
+}
+
+/**
+ * Add the coins of a partition to the batch in key order, writing the batch
+ * whenever it grows larger than batch_size.
+ */
+void WriteCoinPartition(CDBWrapper &db, CDBBatch &batch,
+                        std::vector<const CCoinsMap::value_type *> &partition,
+                        size_t batch_size, int crash_simulate) {
+    std::sort(partition.begin(), partition.end(),
+              [](const auto *a, const auto *b) {
+                  return CoinKeyLess(a->first, b->first);
+              });
+
+    for (const CCoinsMap::value_type *it : partition) {
+        CoinEntry entry(&it->first);
+        if (it->second.coin.IsSpent()) {
+            batch.Erase(entry);
+        } else {
+            batch.Write(entry, it->second.coin);
+        }
+        if (batch.SizeEstimate() > batch_size) {
+            LogPrint(BCLog::COINDB, "Writing partial batch of %.2f MiB\n",
+                     batch.SizeEstimate() * (1.0 / 1048576.0));
+            db.WriteBatch(batch);
+            batch.Clear();
+            if (crash_simulate) {
+                FastRandomContext rng;
+                if (rng.randrange(crash_simulate) == 0) {
+                    LogPrintf("Simulating a crash. Goodbye.\n");
+                    _Exit(0);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
 bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) {
     CDBBatch batch(*m_db);
+    const int64_t start = GetTimeMillis();
     size_t count = 0;
     size_t changed = 0;
     size_t batch_size =
@@ -141,33 +204,56 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) {
     batch.Erase(DB_BEST_BLOCK);
     batch.Write(DB_HEAD_BLOCKS, Vector(hashBlock, old_tip));
 
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end();) {
-        if (it->second.flags & CCoinsCacheEntry::DIRTY) {
-            CoinEntry entry(&it->first);
-            if (it->second.coin.IsSpent()) {
-                batch.Erase(entry);
-            } else {
-                batch.Write(entry, it->second.coin);
-            }
+    // Writing the keys in order is much cheaper for leveldb than writing them
+    // in the random order of the cache: the memtable is filled in order and
+    // the resulting level files don't overlap.
+    CoinPartitions partitions;
+    for (const auto &it : mapCoins) {
+        if (it.second.flags & CCoinsCacheEntry::DIRTY) {
+            partitions[*it.first.GetTxId().begin()].push_back(&it);
             changed++;
         }
         count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
-        if (batch.SizeEstimate() > batch_size) {
-            LogPrint(BCLog::COINDB, "Writing partial batch of %.2f MiB\n",
-                     batch.SizeEstimate() * (1.0 / 1048576.0));
-            m_db->WriteBatch(batch);
-            batch.Clear();
-            if (crash_simulate) {
-                static FastRandomContext rng;
-                if (rng.randrange(crash_simulate) == 0) {
-                    LogPrintf("Simulating a crash. Goodbye.\n");
-                    _Exit(0);
+    }
+
+    int n_threads =
+        gArgs.GetIntArg("-dbwritethreads", DEFAULT_DB_WRITE_THREADS);
+    if (n_threads <= 0) {
+        n_threads = GetNumCores();
+    }
+    n_threads = std::clamp(n_threads, 1, MAX_DB_WRITE_THREADS);
+
+    if (changed < MIN_PARALLEL_WRITE_COINS || n_threads == 1) {
+        for (auto &partition : partitions) {
+            WriteCoinPartition(*m_db, batch, partition, batch_size,
+                               crash_simulate);
+        }
+    } else {
+        // The head blocks marker must be written before any coin.
+        m_db->WriteBatch(batch);
+        batch.Clear();
+
+        // The partitions cover disjoint key ranges, so they are sorted and
+        // written concurrently. Leveldb serializes the writes, but building
+        // and serializing the batches is done in parallel.
+        std::atomic<size_t> next_partition{0};
+        std::vector<std::future<void>> tasks;
+        for (int i = 0; i < n_threads; ++i) {
+            tasks.push_back(std::async(std::launch::async, [&] {
+                CDBBatch thread_batch(*m_db);
+                for (size_t p = next_partition++; p < partitions.size();
+                     p = next_partition++) {
+                    WriteCoinPartition(*m_db, thread_batch, partitions[p],
+                                       batch_size, crash_simulate);
                 }
-            }
+                m_db->WriteBatch(thread_batch);
+            }));
+        }
+        for (auto &task : tasks) {
+            task.get();
         }
     }
+    mapCoins.clear();
 
     // In the last batch, mark the database as consistent with hashBlock again.
     batch.Erase(DB_HEAD_BLOCKS);
@@ -178,8 +264,9 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) {
     bool ret = m_db->WriteBatch(batch);
     LogPrint(BCLog::COINDB,
              "Committed %u changed transaction outputs (out of "
-             "%u) to coin database...\n",
-             (unsigned int)changed, (unsigned int)count);
+             "%u) to coin database in %dms...\n",
+             (unsigned int)changed, (unsigned int)count,
+             GetTimeMillis() - start);
     return ret;
 }
 
@@ -211,6 +298,17 @@ bool CBlockTreeDB::ReadLastBlockFile(int &nFile) {
     return Read(DB_LAST_BLOCK, nFile);
 }
 
+bool CCoinsViewDB::WriteCoins(
+    const std::vector<std::pair<COutPoint, Coin>> &coins) {
+    CDBBatch batch(*m_db);
+    for (const auto &[outpoint, coin] : coins) {
+        batch.Write(CoinEntry(&outpoint), coin);
+    }
+    LogPrint(BCLog::COINDB, "Writing %d coins (%.2f MiB)\n", coins.size(),
+             batch.SizeEstimate() * (1.0 / 1048576.0));
+    return m_db->WriteBatch(batch);
+}
+
 CCoinsViewCursor *CCoinsViewDB::Cursor() const {
     CCoinsViewDBCursor *i = new CCoinsViewDBCursor(
         const_cast<CDBWrapper &>(*m_db).NewIterator(), GetBestBlock());
@@ -221,15 +319,49 @@ CCoinsViewCursor *CCoinsViewDB::Cursor() const {
      */
     i->pcursor->Seek(DB_COIN);
     // Cache key of first record
-    if (i->pcursor->Valid()) {
-        CoinEntry entry(&i->keyTmp.second);
-        i->pcursor->GetKey(entry);
-        i->keyTmp.first = entry.key;
+    i->CacheKey();
+    return i;
+}
+
+std::vector<std::unique_ptr<CCoinsViewCursor>>
+CCoinsViewDB::RangeCursors(size_t n_ranges) const {
+    // Split on the first byte of the txid so all the outputs of a transaction
+    // end up in the same range.
+    n_ranges = std::clamp<size_t>(n_ranges, 1, 256);
+
+    CDBWrapper &db = const_cast<CDBWrapper &>(*m_db);
+    const std::shared_ptr<const CDBWrapper::Snapshot> snapshot =
+        db.GetSnapshot();
+    const BlockHash hashBestChain = GetBestBlock();
+
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    cursors.reserve(n_ranges);
+    for (size_t i = 0; i < n_ranges; ++i) {
+        std::unique_ptr<CCoinsViewDBCursor> cursor(new CCoinsViewDBCursor(
+            snapshot, db.NewIterator(*snapshot), hashBestChain,
+            (i + 1) * 256 / n_ranges));
+
+        uint256 start;
+        *start.begin() = i * 256 / n_ranges;
+        const COutPoint start_outpoint(TxId(start), 0);
+        cursor->pcursor->Seek(CoinEntry(&start_outpoint));
+        cursor->CacheKey();
+
+        cursors.push_back(std::move(cursor));
+    }
+    return cursors;
+}
+
+void CCoinsViewDBCursor::CacheKey() {
+    CoinEntry entry(&keyTmp.second);
+    if (!pcursor->Valid() || !pcursor->GetKey(entry) ||
+        *keyTmp.second.GetTxId().begin() >= m_end_txid_byte) {
+        // Invalidate cached key after last record so that Valid() and GetKey()
+        // return false
+        keyTmp.first = 0;
     } else {
-        // Make sure Valid() and GetKey() return false
-        i->keyTmp.first = 0;
+        keyTmp.first = entry.key;
     }
-    return i;
 }
 
 bool CCoinsViewDBCursor::GetKey(COutPoint &key) const {
@@ -255,14 +387,7 @@ bool CCoinsViewDBCursor::Valid() const {
 
 void CCoinsViewDBCursor::Next() {
     pcursor->Next();
-    CoinEntry entry(&keyTmp.second);
-    if (!pcursor->Valid() || !pcursor->GetKey(entry)) {
-        // Invalidate cached key after last record so that Valid() and GetKey()
-        // return false
-        keyTmp.first = 0;
-    } else {
-        keyTmp.first = entry.key;
-    }
+    CacheKey();
 }
 
 bool CBlockTreeDB::WriteBatchSync(
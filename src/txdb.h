@@ -34,6 +34,10 @@ static constexpr int64_t MAX_DB_CACHE_MB = sizeof(void *) > 4 ? 16384 : 1024;
 static constexpr int64_t DEFAULT_DB_CACHE_MB = 1024;
 //! -dbbatchsize default (bytes)
 static constexpr int64_t DEFAULT_DB_BATCH_SIZE = 16 << 20;
+//! -dbwritethreads default, 0 means one thread per core
+static constexpr int DEFAULT_DB_WRITE_THREADS = 0;
+//! Maximum number of threads writing a coins database flush
+static constexpr int MAX_DB_WRITE_THREADS = 8;
 //! Max memory allocated to block tree DB specific cache, if no -txindex (MiB)
 static constexpr int64_t MAX_BLOCK_DB_CACHE_MB = 2;
 //! Max memory allocated to block tree DB specific cache, if -txindex (MiB)
@@ -71,6 +75,15 @@ public:
     std::vector<BlockHash> GetHeadBlocks() const override;
     bool BatchWrite(CCoinsMap &mapCoins, const BlockHash &hashBlock) override;
     CCoinsViewCursor *Cursor() const override;
+    //! The ranges are split on the first byte of the txids: with n cursors,
+    //! the i-th one covers the first bytes in [i * 256 / n, (i + 1) * 256 / n).
+    //! All the cursors iterate over the same snapshot of the database.
+    std::vector<std::unique_ptr<CCoinsViewCursor>>
+    RangeCursors(size_t n_ranges) const override;
+
+    //! Write coins directly to the database, bypassing any cache. Used to
+    //! bulk load a UTXO snapshot, can be called concurrently.
+    bool WriteCoins(const std::vector<std::pair<COutPoint, Coin>> &coins);
 
     //! Attempt to update from an older database format.
     //! Returns whether an error occurred.
@@ -96,8 +109,23 @@ public:
 private:
     CCoinsViewDBCursor(CDBIterator *pcursorIn, const BlockHash &hashBlockIn)
         : CCoinsViewCursor(hashBlockIn), pcursor(pcursorIn) {}
+    CCoinsViewDBCursor(
+        std::shared_ptr<const CDBWrapper::Snapshot> snapshotIn,
+        CDBIterator *pcursorIn, const BlockHash &hashBlockIn,
+        unsigned int end_txid_byte)
+        : CCoinsViewCursor(hashBlockIn), snapshot(std::move(snapshotIn)),
+          pcursor(pcursorIn), m_end_txid_byte(end_txid_byte) {}
+
+    //! Cache the key of the current record, or invalidate the cursor if it
+    //! is past the last coin of its range
+    void CacheKey();
+
+    //! Must be destroyed after pcursor
+    std::shared_ptr<const CDBWrapper::Snapshot> snapshot;
     std::unique_ptr<CDBIterator> pcursor;
     std::pair<char, COutPoint> keyTmp;
+    //! The cursor stops before the first txid starting with this byte
+    unsigned int m_end_txid_byte{256};
 
     friend class CCoinsViewDB;
 };
@@ -123,6 +151,10 @@ public:
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     ;
 
+    //! Write coins directly to the database, bypassing any cache. Used to
+    //! bulk load a UTXO snapshot, can be called concurrently.
+    bool WriteCoins(const std::vector<std::pair<COutPoint, Coin>> &coins);
+
     //! Attempt to update from an older database format.
     //! Returns whether an error occurred.
     bool Upgrade(const Consensus::Params &params);
@@ -114,6 +114,9 @@ private:
     Amount feeDelta{Amount::zero()};
     //! Track the height and time at which tx was final
     LockPoints lockPoints;
+    //! Sighash midstates computed when the transaction was accepted, reused
+    //! when connecting the block that includes it
+    std::optional<PrecomputedTransactionData> m_precomputed_txdata;
 
 public:
     CTxMemPoolEntry(const CTransactionRef &_tx, const Amount fee, int64_t time,
@@ -146,6 +149,16 @@ public:
     // Update the LockPoints after a reorg
     void UpdateLockPoints(const LockPoints &lp);
 
+    //! This should only be set by MemPoolAccept before entry insertion into
+    //! mempool
+    void SetPrecomputedTxData(const PrecomputedTransactionData &txdata) {
+        m_precomputed_txdata = txdata;
+    }
+    //! The sighash midstates of the transaction, if they have been set
+    const PrecomputedTransactionData *GetPrecomputedTxData() const {
+        return m_precomputed_txdata ? &*m_precomputed_txdata : nullptr;
+    }
+
     bool GetSpendsCoinbase() const { return spendsCoinbase; }
 
     const Parents &GetMemPoolParentsConst() const { return m_parents; }
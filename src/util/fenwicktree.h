@@ -0,0 +1,105 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_FENWICKTREE_H
+#define BITCOIN_UTIL_FENWICKTREE_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fenwick tree (binary indexed tree) over a sequence of unsigned weights.
+ *
+ * Appending, removing the last element, updating an element and computing a
+ * prefix sum all take O(log n). It can also find in O(log n) the element a
+ * point of the cumulated weights falls into, which makes it possible to pick
+ * an element at random with a probability proportional to its weight. The
+ * elements with a zero weight are never picked.
+ *
+ * Element i of the tree stores the sum of the weights in the range
+ * [i + 1 - lsb(i + 1), i], where lsb is the least significant bit.
+ */
+template <typename T> class FenwickTree {
+    static_assert(std::is_unsigned_v<T>, "The weights must be unsigned");
+
+    std::vector<T> tree;
+
+    static size_t LowBit(size_t i) { return i & (~i + 1); }
+
+public:
+    size_t size() const { return tree.size(); }
+    bool empty() const { return tree.empty(); }
+    void clear() { tree.clear(); }
+    void reserve(size_t n) { tree.reserve(n); }
+
+    /** Sum of the weights of the first n elements */
+    T prefixSum(size_t n) const {
+        assert(n <= tree.size());
+        T sum = 0;
+        for (; n > 0; n -= LowBit(n)) {
+            sum += tree[n - 1];
+        }
+        return sum;
+    }
+
+    T total() const { return prefixSum(tree.size()); }
+
+    void push_back(T weight) {
+        // The new element covers the range ending with it, so it is the sum
+        // of the weight and of the previous elements in the range.
+        const size_t n = tree.size() + 1;
+        tree.push_back(weight + prefixSum(n - 1) - prefixSum(n - LowBit(n)));
+    }
+
+    /**
+     * No element before the last one covers it, so it can be dropped as is.
+     */
+    void pop_back() {
+        assert(!tree.empty());
+        tree.pop_back();
+    }
+
+    void add(size_t i, T weight) {
+        assert(i < tree.size());
+        for (size_t n = i + 1; n <= tree.size(); n += LowBit(n)) {
+            tree[n - 1] += weight;
+        }
+    }
+
+    /** The weight of the element must be greater or equal to the argument */
+    void subtract(size_t i, T weight) {
+        assert(i < tree.size());
+        for (size_t n = i + 1; n <= tree.size(); n += LowBit(n)) {
+            tree[n - 1] -= weight;
+        }
+    }
+
+    /**
+     * Find the index of the element i such that
+     * prefixSum(i) <= point < prefixSum(i + 1). The point must be lower than
+     * the total weight.
+     */
+    size_t find(T point) const {
+        assert(point < total());
+
+        size_t step = 1;
+        while (step * 2 <= tree.size()) {
+            step *= 2;
+        }
+
+        size_t pos = 0;
+        for (; step > 0; step /= 2) {
+            if (pos + step <= tree.size() && tree[pos + step - 1] <= point) {
+                pos += step;
+                point -= tree[pos - 1];
+            }
+        }
+
+        return pos;
+    }
+};
+
+#endif // BITCOIN_UTIL_FENWICKTREE_H
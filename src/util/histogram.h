@@ -0,0 +1,91 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_HISTOGRAM_H
+#define BITCOIN_UTIL_HISTOGRAM_H
+
+#include <crypto/common.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Histogram using power of two bucket boundaries, suitable to record values
+ * spanning several orders of magnitude such as latencies or sizes with a
+ * constant and very small overhead.
+ *
+ * Bucket 0 counts the zero values and bucket i > 0 counts the values in the
+ * [2^(i-1), 2^i) range. The last bucket is open ended.
+ *
+ * This class is not thread safe, the caller is responsible for the
+ * synchronization.
+ */
+class Log2Histogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 32;
+
+private:
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+
+public:
+    static size_t GetBucketIndex(uint64_t value) {
+        return std::min<size_t>(CountBits(value), NUM_BUCKETS - 1);
+    }
+
+    /** Inclusive upper bound of the values counted in the given bucket. */
+    static uint64_t GetBucketUpperBound(size_t index) {
+        if (index >= NUM_BUCKETS - 1) {
+            return UINT64_MAX;
+        }
+        return (uint64_t(1) << index) - 1;
+    }
+
+    void Add(uint64_t value) {
+        buckets[GetBucketIndex(value)]++;
+        count++;
+        sum += value;
+        max = std::max(max, value);
+    }
+
+    void Clear() { *this = Log2Histogram(); }
+
+    uint64_t GetCount() const { return count; }
+    uint64_t GetSum() const { return sum; }
+    uint64_t GetMax() const { return max; }
+    uint64_t GetMean() const { return count > 0 ? sum / count : 0; }
+    const std::array<uint64_t, NUM_BUCKETS> &GetBuckets() const {
+        return buckets;
+    }
+
+    /**
+     * Return an upper bound of the requested percentile (in the [0, 100]
+     * range), i.e. the upper bound of the bucket in which it falls, capped to
+     * the max recorded value. Returns 0 if the histogram is empty.
+     */
+    uint64_t GetPercentileUpperBound(double percentile) const {
+        if (count == 0) {
+            return 0;
+        }
+
+        const uint64_t rank = std::clamp<uint64_t>(
+            std::ceil(percentile * count / 100.), 1, count);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::min(GetBucketUpperBound(i), max);
+            }
+        }
+
+        return max;
+    }
+};
+
+#endif // BITCOIN_UTIL_HISTOGRAM_H
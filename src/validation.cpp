@@ -38,6 +38,7 @@
 #include <primitives/transaction.h>
 #include <random.h>
 #include <reverse_iterator.h>
+#include <script/interpreter.h>
 #include <script/script.h>
 #include <script/scriptcache.h>
 #include <script/sigcache.h>
@@ -59,6 +60,7 @@
 #include <algorithm>
 #include <atomic>
 #include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <string>
@@ -69,13 +71,17 @@ using node::BlockManager;
 using node::BlockMap;
 using node::CCoinsStats;
 using node::CoinStatsHashType;
+using node::DecodeSnapshotChunk;
 using node::fImporting;
 using node::fPruneMode;
 using node::fReindex;
 using node::GetUTXOStats;
+using node::MAX_SNAPSHOT_THREADS;
 using node::nPruneTarget;
 using node::OpenBlockFile;
 using node::ReadBlockFromDisk;
+using node::SNAPSHOT_VERSION;
+using node::SnapshotChunk;
 using node::SnapshotMetadata;
 using node::UNDOFILE_CHUNK_SIZE;
 using node::UndoReadFromDisk;
@@ -732,6 +738,10 @@ bool MemPoolAccept::Finalize(const ATMPArgs &args, Workspace &ws) {
 
     std::unique_ptr<CTxMemPoolEntry> &entry = ws.m_entry;
 
+    // Keep the sighash midstates so they don't need to be computed again when
+    // the transaction is mined.
+    entry->SetPrecomputedTxData(ws.m_precomputed_txdata);
+
     // Store transaction in memory.
     m_pool.addUnchecked(*entry);
 
@@ -1709,9 +1719,55 @@ static uint32_t GetNextBlockScriptFlags(const Consensus::Params &params,
     return flags;
 }
 
+/**
+ * Get the PrecomputedTransactionData of the transactions, reusing the ones
+ * computed when they were accepted to the mempool and computing the others
+ * all at once.
+ */
+static std::vector<PrecomputedTransactionData>
+GetPrecomputedTransactionsData(Span<const CTransactionRef> txs,
+                               const CTxMemPool *mempool,
+                               size_t &nFromMempool) {
+    std::vector<PrecomputedTransactionData> txsdata(txs.size());
+    std::vector<CTransactionRef> missingTxs;
+    std::vector<size_t> missingIndexes;
+    nFromMempool = 0;
+
+    if (mempool) {
+        LOCK(mempool->cs);
+        for (size_t i = 0; i < txs.size(); i++) {
+            const std::optional<CTxMemPool::txiter> it =
+                mempool->GetIter(txs[i]->GetId());
+            const PrecomputedTransactionData *txdata =
+                it ? (*it)->GetPrecomputedTxData() : nullptr;
+            if (txdata) {
+                txsdata[i] = *txdata;
+                nFromMempool++;
+                continue;
+            }
+            missingTxs.push_back(txs[i]);
+            missingIndexes.push_back(i);
+        }
+    } else {
+        missingTxs.assign(txs.begin(), txs.end());
+        for (size_t i = 0; i < txs.size(); i++) {
+            missingIndexes.push_back(i);
+        }
+    }
+
+    const std::vector<PrecomputedTransactionData> missingTxsData =
+        PrecomputeTransactionsData(missingTxs);
+    for (size_t i = 0; i < missingIndexes.size(); i++) {
+        txsdata[missingIndexes[i]] = missingTxsData[i];
+    }
+
+    return txsdata;
+}
+
 static int64_t nTimeCheck = 0;
 static int64_t nTimeForks = 0;
 static int64_t nTimeVerify = 0;
+static int64_t nTimePrecompute = 0;
 static int64_t nTimeConnect = 0;
 static int64_t nTimeIndex = 0;
 static int64_t nTimeTotal = 0;
@@ -1990,6 +2046,25 @@ bool Chainstate::ConnectBlock(const CBlock &block, BlockValidationState &state,
                              "tx-duplicate");
     }
 
+    // Get the sighash data of all the transactions but the coinbase, reusing
+    // the data computed when they were accepted to the mempool.
+    std::vector<PrecomputedTransactionData> txsdata;
+    if (fScriptChecks) {
+        const int64_t nTimePrecomputeStart = GetTimeMicros();
+        size_t nFromMempool = 0;
+        txsdata = GetPrecomputedTransactionsData(
+            Span<const CTransactionRef>(block.vtx).subspan(1), m_mempool,
+            nFromMempool);
+        const int64_t nTimePrecomputeEnd = GetTimeMicros();
+        nTimePrecompute += nTimePrecomputeEnd - nTimePrecomputeStart;
+        LogPrint(BCLog::BENCH,
+                 "      - Precompute sighash data: %.2fms (%u/%u txs from the "
+                 "mempool) [%.2fs (%.2fms/blk)]\n",
+                 MILLI * (nTimePrecomputeEnd - nTimePrecomputeStart),
+                 nFromMempool, txsdata.size(), nTimePrecompute * MICRO,
+                 nTimePrecompute * MILLI / nBlocksTotal);
+    }
+
     size_t txIndex = 0;
     // nSigChecksRet may be accurate (found in cache) or 0 (checks were
     // deferred into vChecks).
@@ -2060,7 +2135,7 @@ bool Chainstate::ConnectBlock(const CBlock &block, BlockValidationState &state,
         TxValidationState tx_state;
         if (fScriptChecks &&
             !CheckInputScripts(tx, tx_state, view, flags, fCacheResults,
-                               fCacheResults, PrecomputedTransactionData(tx),
+                               fCacheResults, txsdata[txIndex],
                                nSigChecksRet, nSigChecksTxLimiters[txIndex],
                                &nSigChecksBlockLimiter, &vChecks)) {
             // Any transaction validation failure in ConnectBlock is a block
@@ -5874,12 +5949,9 @@ bool ChainstateManager::ActivateSnapshot(CAutoFile &coins_file,
     return true;
 }
 
-static void FlushSnapshotToDisk(CCoinsViewCache &coins_cache,
-                                bool snapshot_loaded) {
+static void FlushSnapshotToDisk(CCoinsViewCache &coins_cache) {
     LOG_TIME_MILLIS_WITH_CATEGORY_MSG_ONCE(
-        strprintf("%s (%.2f MB)",
-                  snapshot_loaded ? "saving snapshot chainstate"
-                                  : "flushing coins cache",
+        strprintf("saving snapshot chainstate (%.2f MB)",
                   coins_cache.DynamicMemoryUsage() / (1000 * 1000)),
         BCLog::LogFlags::ALL);
 
@@ -5920,8 +5992,35 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
 
     const AssumeutxoData &au_data = *maybe_au_data;
 
-    COutPoint outpoint;
-    Coin coin;
+    if (metadata.m_version != SNAPSHOT_VERSION) {
+        LogPrintf("[snapshot] unsupported snapshot version %d\n",
+                  metadata.m_version);
+        return false;
+    }
+
+    // As above, okay to immediately release cs_main here since no other
+    // context knows about the snapshot_chainstate.
+    CCoinsViewDB &snapshot_coinsdb =
+        *WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsDB());
+
+    //! Check a chunk of coins and write them to the coins database, bypassing
+    //! the coins cache.
+    const auto load_chunk = [&](const SnapshotChunk &chunk) {
+        std::vector<std::pair<COutPoint, Coin>> coins;
+        if (!DecodeSnapshotChunk(chunk, coins)) {
+            return false;
+        }
+        for (const auto &[outpoint, coin] : coins) {
+            if (coin.GetHeight() > uint32_t(base_height) ||
+                // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+                outpoint.GetN() >=
+                    std::numeric_limits<decltype(outpoint.GetN())>::max()) {
+                return false;
+            }
+        }
+        return snapshot_coinsdb.WriteCoins(coins);
+    };
+
     const uint64_t coins_count = metadata.m_coins_count;
     uint64_t coins_left = metadata.m_coins_count;
 
@@ -5929,75 +6028,69 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
               base_blockhash.ToString());
     int64_t coins_processed{0};
 
-    while (coins_left > 0) {
+    // The chunks are read sequentially and loaded in parallel, with one chunk
+    // in flight per thread.
+    std::vector<std::future<bool>> loading(
+        std::clamp(GetNumCores(), 1, MAX_SNAPSHOT_THREADS));
+    bool chunks_ok{true};
+    for (size_t i = 0; coins_left > 0; ++i) {
+        SnapshotChunk chunk;
         try {
-            coins_file >> outpoint;
-            coins_file >> coin;
+            coins_file >> chunk;
         } catch (const std::ios_base::failure &) {
             LogPrintf("[snapshot] bad snapshot format or truncated snapshot "
                       "after deserializing %d coins\n",
                       coins_count - coins_left);
             return false;
         }
-        if (coin.GetHeight() > uint32_t(base_height) ||
-            // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-            outpoint.GetN() >=
-                std::numeric_limits<decltype(outpoint.GetN())>::max()) {
-            LogPrintf(
-                "[snapshot] bad snapshot data after deserializing %d coins\n",
-                coins_count - coins_left);
+        if (chunk.m_coins_count == 0 || chunk.m_coins_count > coins_left) {
+            LogPrintf("[snapshot] bad snapshot chunk size after deserializing "
+                      "%d coins\n",
+                      coins_count - coins_left);
             return false;
         }
-        coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint),
-                                              std::move(coin));
 
-        --coins_left;
-        ++coins_processed;
+        const int64_t coins_before = coins_processed;
+        coins_left -= chunk.m_coins_count;
+        coins_processed += chunk.m_coins_count;
 
-        if (coins_processed % 1000000 == 0) {
-            LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
-                      coins_processed,
-                      static_cast<float>(coins_processed) * 100 /
-                          static_cast<float>(coins_count),
-                      coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+        std::future<bool> &slot = loading[i % loading.size()];
+        if (slot.valid() && !slot.get()) {
+            chunks_ok = false;
+            break;
         }
+        slot = std::async(std::launch::async, load_chunk, std::move(chunk));
 
-        // Batch write and flush (if we need to) every so often.
-        //
-        // If our average Coin size is roughly 41 bytes, checking every 120,000
-        // coins means <5MB of memory imprecision.
-        if (coins_processed % 120000 == 0) {
-            if (ShutdownRequested()) {
-                return false;
-            }
-
-            const auto snapshot_cache_state = WITH_LOCK(
-                ::cs_main, return snapshot_chainstate.GetCoinsCacheSizeState());
-
-            if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                // This is a hack - we don't know what the actual best block is,
-                // but that doesn't matter for the purposes of flushing the
-                // cache here. We'll set this to its correct value
-                // (`base_blockhash`) below after the coins are loaded.
-                coins_cache.SetBestBlock(BlockHash{GetRandHash()});
+        if (coins_processed / 1000000 != coins_before / 1000000) {
+            LogPrintf("[snapshot] %d coins loaded (%.2f%%)\n", coins_processed,
+                      static_cast<float>(coins_processed) * 100 /
+                          static_cast<float>(coins_count));
+        }
 
-                // No need to acquire cs_main since this chainstate isn't being
-                // used yet.
-                FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
-            }
+        if (ShutdownRequested()) {
+            return false;
         }
     }
+    for (std::future<bool> &slot : loading) {
+        if (slot.valid() && !slot.get()) {
+            chunks_ok = false;
+        }
+    }
+    if (!chunks_ok) {
+        LogPrintf("[snapshot] bad snapshot chunk content\n");
+        return false;
+    }
 
-    // Important that we set this. This and the coins_cache accesses above are
-    // sort of a layer violation, but either we reach into the innards of
-    // CCoinsViewCache here or we have to invert some of the Chainstate to
-    // embed them in a snapshot-activation-specific CCoinsViewCache bulk load
-    // method.
+    // Important that we set this. This and the coins database writes above
+    // are sort of a layer violation, but either we reach into the innards of
+    // the coins views here or we have to invert some of the Chainstate to
+    // embed them in a snapshot-activation-specific bulk load method.
     coins_cache.SetBestBlock(base_blockhash);
 
     bool out_of_coins{false};
     try {
-        coins_file >> outpoint;
+        SnapshotChunk chunk;
+        coins_file >> chunk;
     } catch (const std::ios_base::failure &) {
         // We expect an exception since we should be out of coins.
         out_of_coins = true;
@@ -6014,19 +6107,14 @@ bool ChainstateManager::PopulateAndValidateSnapshot(
               base_blockhash.ToString());
 
     // No need to acquire cs_main since this chainstate isn't being used yet.
-    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/true);
+    FlushSnapshotToDisk(coins_cache);
 
     assert(coins_cache.GetBestBlock() == base_blockhash);
 
     CCoinsStats stats{CoinStatsHashType::HASH_SERIALIZED};
     auto breakpoint_fnc = [] { /* TODO insert breakpoint here? */ };
 
-    // As above, okay to immediately release cs_main here since no other context
-    // knows about the snapshot_chainstate.
-    CCoinsViewDB *snapshot_coinsdb =
-        WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsDB());
-
-    if (!GetUTXOStats(snapshot_coinsdb, m_blockman, stats, breakpoint_fnc)) {
+    if (!GetUTXOStats(&snapshot_coinsdb, m_blockman, stats, breakpoint_fnc)) {
         LogPrintf("[snapshot] failed to generate coins stats\n");
         return false;
     }
@@ -12,12 +12,13 @@ CZMQAbstractNotifier::~CZMQAbstractNotifier() {
     assert(!psocket);
 }
 
-bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/) {
+bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/,
+                                       CZMQRawPayload & /*rawBlock*/) {
     return true;
 }
 
 bool CZMQAbstractNotifier::NotifyTransaction(
-    const CTransaction & /*transaction*/) {
+    const CTransaction & /*transaction*/, CZMQRawPayload & /*rawTransaction*/) {
     return true;
 }
 
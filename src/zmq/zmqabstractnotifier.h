@@ -5,12 +5,80 @@
 #ifndef BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
 #define BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 class CBlockIndex;
 class CTransaction;
 class CZMQAbstractNotifier;
+class CZMQPublisher;
+
+/**
+ * Payload of a ZMQ message. It is a slice of a serialized buffer which is
+ * shared with the other messages and the ZMQ library, e.g. a raw transaction
+ * is a slice of its serialized block, so the data is never copied while the
+ * messages are queued and sent.
+ */
+struct ZMQPayload {
+    std::shared_ptr<const std::vector<uint8_t>> buffer;
+    size_t offset{0};
+    size_t size{0};
+
+    ZMQPayload() = default;
+    explicit ZMQPayload(std::shared_ptr<const std::vector<uint8_t>> bufferIn)
+        : buffer(std::move(bufferIn)), size(buffer->size()) {}
+    ZMQPayload(std::shared_ptr<const std::vector<uint8_t>> bufferIn,
+               size_t offsetIn, size_t sizeIn)
+        : buffer(std::move(bufferIn)), offset(offsetIn), size(sizeIn) {}
+
+    const uint8_t *data() const { return buffer->data() + offset; }
+};
+
+/**
+ * Raw payload of a block or transaction notification. It is serialized the
+ * first time a notifier needs it, then reused by the other notifiers. The
+ * serialization returns std::nullopt if the data is not available.
+ */
+class CZMQRawPayload {
+public:
+    using Serializer = std::function<std::optional<ZMQPayload>()>;
+
+    explicit CZMQRawPayload(Serializer serializerIn)
+        : serializer(std::move(serializerIn)) {}
+
+    const std::optional<ZMQPayload> &Get() {
+        if (!serialized) {
+            payload = serializer();
+            serialized = true;
+        }
+        return payload;
+    }
+
+private:
+    Serializer serializer;
+    bool serialized{false};
+    std::optional<ZMQPayload> payload;
+};
+
+/**
+ * Counters of the messages of a notifier. They are shared with the messages
+ * waiting in the publisher queue, so they can outlive the notifier.
+ */
+struct ZMQNotifierStats {
+    //! Messages added to the publisher queue
+    std::atomic<uint64_t> queued{0};
+    //! Messages sent to the ZMQ socket
+    std::atomic<uint64_t> published{0};
+    //! Messages dropped because the queue was full or the send failed
+    std::atomic<uint64_t> dropped{0};
+};
 
 using CZMQNotifierFactory = std::unique_ptr<CZMQAbstractNotifier> (*)();
 
@@ -20,7 +88,8 @@ public:
 
     CZMQAbstractNotifier()
         : psocket(nullptr),
-          outbound_message_high_water_mark(DEFAULT_ZMQ_SNDHWM) {}
+          outbound_message_high_water_mark(DEFAULT_ZMQ_SNDHWM),
+          stats(std::make_shared<ZMQNotifierStats>()) {}
     virtual ~CZMQAbstractNotifier();
 
     template <typename T>
@@ -41,11 +110,14 @@ public:
         }
     }
 
-    virtual bool Initialize(void *pcontext) = 0;
+    const ZMQNotifierStats &GetStats() const { return *stats; }
+
+    virtual bool Initialize(void *pcontext, CZMQPublisher &publisher) = 0;
     virtual void Shutdown() = 0;
 
     // Notifies of ConnectTip result, i.e., new active tip only
-    virtual bool NotifyBlock(const CBlockIndex *pindex);
+    virtual bool NotifyBlock(const CBlockIndex *pindex,
+                             CZMQRawPayload &rawBlock);
     // Notifies of every block connection
     virtual bool NotifyBlockConnect(const CBlockIndex *pindex);
     // Notifies of every block disconnection
@@ -57,13 +129,15 @@ public:
     virtual bool NotifyTransactionRemoval(const CTransaction &transaction,
                                           uint64_t mempool_sequence);
     // Notifies of transactions added to mempool or appearing in blocks
-    virtual bool NotifyTransaction(const CTransaction &transaction);
+    virtual bool NotifyTransaction(const CTransaction &transaction,
+                                   CZMQRawPayload &rawTransaction);
 
 protected:
     void *psocket;
     std::string type;
     std::string address;
     int outbound_message_high_water_mark; // aka SNDHWM
+    std::shared_ptr<ZMQNotifierStats> stats;
 };
 
 #endif // BITCOIN_ZMQ_ZMQABSTRACTNOTIFIER_H
@@ -8,10 +8,27 @@
 
 #include <zmq.h>
 
+#include <chain.h>
+#include <chainparams.h>
+#include <config.h>
+#include <node/blockstorage.h>
 #include <primitives/block.h>
+#include <rpc/server.h>
+#include <serialize.h>
+#include <streams.h>
 #include <util/system.h>
+#include <version.h>
 
-CZMQNotificationInterface::CZMQNotificationInterface() : pcontext(nullptr) {}
+#include <algorithm>
+
+using node::ReadBlockFromDisk;
+
+CZMQNotificationInterface::CZMQNotificationInterface()
+    : pcontext(nullptr),
+      publisher(std::max<int64_t>(
+          gArgs.GetIntArg("-zmqqueuesize",
+                          CZMQPublisher::DEFAULT_ZMQ_QUEUE_SIZE),
+          1)) {}
 
 CZMQNotificationInterface::~CZMQNotificationInterface() {
     Shutdown();
@@ -84,7 +101,7 @@ bool CZMQNotificationInterface::Initialize() {
     }
 
     for (auto &notifier : notifiers) {
-        if (notifier->Initialize(pcontext)) {
+        if (notifier->Initialize(pcontext, publisher)) {
             LogPrint(BCLog::ZMQ, "zmq: Notifier %s ready (address = %s)\n",
                      notifier->GetType(), notifier->GetAddress());
         } else {
@@ -94,6 +111,8 @@ bool CZMQNotificationInterface::Initialize() {
         }
     }
 
+    publisher.Start();
+
     return true;
 }
 
@@ -101,6 +120,7 @@ bool CZMQNotificationInterface::Initialize() {
 void CZMQNotificationInterface::Shutdown() {
     LogPrint(BCLog::ZMQ, "zmq: Shutdown notification interface\n");
     if (pcontext) {
+        publisher.Stop();
         for (auto &notifier : notifiers) {
             LogPrint(BCLog::ZMQ, "zmq: Shutdown notifier %s at %s\n",
                      notifier->GetType(), notifier->GetAddress());
@@ -131,27 +151,91 @@ void TryForEachAndRemoveFailed(
 
 } // anonymous namespace
 
+void CZMQNotificationInterface::SerializedBlock::Serialize() {
+    if (buffer) {
+        return;
+    }
+
+    const int version = PROTOCOL_VERSION | RPCSerializationFlags();
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    data->reserve(::GetSerializeSize(*block, version));
+
+    // Same as serializing the block, but keeping track of the transactions
+    CVectorWriter writer(SER_NETWORK, version, *data, 0);
+    writer << static_cast<const CBlockHeader &>(*block);
+    WriteCompactSize(writer, block->vtx.size());
+    txOffsets.reserve(block->vtx.size() + 1);
+    for (const CTransactionRef &tx : block->vtx) {
+        txOffsets.push_back(data->size());
+        writer << *tx;
+    }
+    txOffsets.push_back(data->size());
+
+    buffer = std::move(data);
+}
+
+ZMQPayload CZMQNotificationInterface::SerializedBlock::GetRawBlock() {
+    Serialize();
+    return ZMQPayload(buffer);
+}
+
+ZMQPayload
+CZMQNotificationInterface::SerializedBlock::GetRawTransaction(size_t index) {
+    Serialize();
+    return ZMQPayload(buffer, txOffsets[index],
+                      txOffsets[index + 1] - txOffsets[index]);
+}
+
 void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew,
                                                 const CBlockIndex *pindexFork,
                                                 bool fInitialDownload) {
+    // The tip is always the last connected block, unless blocks were only
+    // disconnected
+    std::optional<SerializedBlock> tipBlock = std::move(lastConnectedBlock);
+    lastConnectedBlock.reset();
+
     // In IBD or blocks were disconnected without any new ones
     if (fInitialDownload || pindexNew == pindexFork) {
         return;
     }
 
-    TryForEachAndRemoveFailed(notifiers,
-                              [pindexNew](CZMQAbstractNotifier *notifier) {
-                                  return notifier->NotifyBlock(pindexNew);
-                              });
+    CZMQRawPayload rawBlock([&]() -> std::optional<ZMQPayload> {
+        if (tipBlock &&
+            tipBlock->GetBlock().GetHash() == pindexNew->GetBlockHash()) {
+            return tipBlock->GetRawBlock();
+        }
+
+        auto block = std::make_shared<CBlock>();
+        if (!ReadBlockFromDisk(*block, pindexNew,
+                               GetConfig().GetChainParams().GetConsensus())) {
+            return std::nullopt;
+        }
+        return SerializedBlock(std::move(block)).GetRawBlock();
+    });
+
+    TryForEachAndRemoveFailed(
+        notifiers, [pindexNew, &rawBlock](CZMQAbstractNotifier *notifier) {
+            return notifier->NotifyBlock(pindexNew, rawBlock);
+        });
 }
 
 void CZMQNotificationInterface::TransactionAddedToMempool(
     const CTransactionRef &ptx, uint64_t mempool_sequence) {
     const CTransaction &tx = *ptx;
 
+    CZMQRawPayload rawTx([&tx]() -> std::optional<ZMQPayload> {
+        auto data = std::make_shared<std::vector<uint8_t>>();
+        CVectorWriter writer(SER_NETWORK,
+                             PROTOCOL_VERSION | RPCSerializationFlags(), *data,
+                             0);
+        writer << tx;
+        return ZMQPayload(std::move(data));
+    });
+
     TryForEachAndRemoveFailed(
-        notifiers, [&tx, mempool_sequence](CZMQAbstractNotifier *notifier) {
-            return notifier->NotifyTransaction(tx) &&
+        notifiers,
+        [&tx, &rawTx, mempool_sequence](CZMQAbstractNotifier *notifier) {
+            return notifier->NotifyTransaction(tx, rawTx) &&
                    notifier->NotifyTransactionAcceptance(tx, mempool_sequence);
         });
 }
@@ -168,16 +252,27 @@ void CZMQNotificationInterface::TransactionRemovedFromMempool(
         });
 }
 
+void CZMQNotificationInterface::NotifyBlockTransactions(
+    SerializedBlock &serializedBlock) {
+    const CBlock &block = serializedBlock.GetBlock();
+    for (size_t i = 0; i < block.vtx.size(); i++) {
+        const CTransaction &tx = *block.vtx[i];
+        CZMQRawPayload rawTx(
+            [&serializedBlock, i]() -> std::optional<ZMQPayload> {
+                return serializedBlock.GetRawTransaction(i);
+            });
+        TryForEachAndRemoveFailed(
+            notifiers, [&tx, &rawTx](CZMQAbstractNotifier *notifier) {
+                return notifier->NotifyTransaction(tx, rawTx);
+            });
+    }
+}
+
 void CZMQNotificationInterface::BlockConnected(
     const std::shared_ptr<const CBlock> &pblock,
     const CBlockIndex *pindexConnected) {
-    for (const CTransactionRef &ptx : pblock->vtx) {
-        const CTransaction &tx = *ptx;
-        TryForEachAndRemoveFailed(notifiers,
-                                  [&tx](CZMQAbstractNotifier *notifier) {
-                                      return notifier->NotifyTransaction(tx);
-                                  });
-    }
+    lastConnectedBlock.emplace(pblock);
+    NotifyBlockTransactions(*lastConnectedBlock);
 
     // Next we notify BlockConnect listeners for *all* blocks
     TryForEachAndRemoveFailed(
@@ -189,13 +284,8 @@ void CZMQNotificationInterface::BlockConnected(
 void CZMQNotificationInterface::BlockDisconnected(
     const std::shared_ptr<const CBlock> &pblock,
     const CBlockIndex *pindexDisconnected) {
-    for (const CTransactionRef &ptx : pblock->vtx) {
-        const CTransaction &tx = *ptx;
-        TryForEachAndRemoveFailed(notifiers,
-                                  [&tx](CZMQAbstractNotifier *notifier) {
-                                      return notifier->NotifyTransaction(tx);
-                                  });
-    }
+    SerializedBlock serializedBlock(pblock);
+    NotifyBlockTransactions(serializedBlock);
 
     // Next we notify BlockDisconnect listeners for *all* blocks
     TryForEachAndRemoveFailed(
@@ -5,19 +5,29 @@
 #ifndef BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 #define BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 
+#include <primitives/block.h>
 #include <validationinterface.h>
+#include <zmq/zmqabstractnotifier.h>
+#include <zmq/zmqpublisher.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 class CBlockIndex;
-class CZMQAbstractNotifier;
 
 class CZMQNotificationInterface final : public CValidationInterface {
 public:
     virtual ~CZMQNotificationInterface();
 
     std::list<const CZMQAbstractNotifier *> GetActiveNotifiers() const;
+    size_t GetPublisherQueueSize() const {
+        return publisher.GetQueueSize();
+    }
 
     static CZMQNotificationInterface *Create();
 
@@ -40,10 +50,41 @@ protected:
                          bool fInitialDownload) override;
 
 private:
+    /**
+     * A block which is serialized the first time a notifier needs it. The raw
+     * transactions are published as slices of the serialized block, so the
+     * block and its transactions are serialized at most once.
+     */
+    class SerializedBlock {
+    public:
+        explicit SerializedBlock(std::shared_ptr<const CBlock> blockIn)
+            : block(std::move(blockIn)) {}
+
+        const CBlock &GetBlock() const { return *block; }
+        ZMQPayload GetRawBlock();
+        ZMQPayload GetRawTransaction(size_t index);
+
+    private:
+        void Serialize();
+
+        std::shared_ptr<const CBlock> block;
+        std::shared_ptr<const std::vector<uint8_t>> buffer;
+        //! Offsets of the transactions, followed by the end of the block
+        std::vector<size_t> txOffsets;
+    };
+
     CZMQNotificationInterface();
 
+    void NotifyBlockTransactions(SerializedBlock &serializedBlock);
+
     void *pcontext;
+    CZMQPublisher publisher;
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
+    /**
+     * The last connected block, so the raw block notifiers don't read it
+     * back from disk when it becomes the new tip.
+     */
+    std::optional<SerializedBlock> lastConnectedBlock;
 };
 
 extern CZMQNotificationInterface *g_zmq_notification_interface;
@@ -0,0 +1,171 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <zmq/zmqpublisher.h>
+
+#include <crypto/common.h>
+#include <logging.h>
+#include <util/thread.h>
+#include <zmq/zmqutil.h>
+
+#include <zmq.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+/**
+ * Payloads smaller than this are copied into the ZMQ message, which is cheaper
+ * than sharing the buffer for small data like the hashes.
+ */
+static constexpr size_t MIN_ZERO_COPY_PAYLOAD_SIZE{256};
+
+static bool SendFrame(void *socket, const void *data, size_t size,
+                      int flags) {
+    zmq_msg_t msg;
+    if (zmq_msg_init_size(&msg, size) != 0) {
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    memcpy(zmq_msg_data(&msg), data, size);
+
+    const int rc = zmq_msg_send(&msg, socket, flags);
+    // This is a no-op if the message was sent
+    zmq_msg_close(&msg);
+    if (rc == -1) {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+    return true;
+}
+
+/** Release the reference to the payload buffer held by a ZMQ message. */
+static void FreePayload(void * /*data*/, void *hint) {
+    delete static_cast<std::shared_ptr<const std::vector<uint8_t>> *>(hint);
+}
+
+static bool SendPayloadFrame(void *socket, const ZMQPayload &payload,
+                             int flags) {
+    if (payload.size < MIN_ZERO_COPY_PAYLOAD_SIZE) {
+        return SendFrame(socket, payload.data(), payload.size, flags);
+    }
+
+    // The message keeps a reference to the buffer until ZMQ is done with it,
+    // which can be after the send returns.
+    auto *ref = new std::shared_ptr<const std::vector<uint8_t>>(payload.buffer);
+    zmq_msg_t msg;
+    if (zmq_msg_init_data(&msg, const_cast<uint8_t *>(payload.data()),
+                          payload.size, FreePayload, ref) != 0) {
+        zmqError("Unable to initialize ZMQ msg");
+        delete ref;
+        return false;
+    }
+
+    const int rc = zmq_msg_send(&msg, socket, flags);
+    // If the send failed this releases the buffer reference
+    zmq_msg_close(&msg);
+    if (rc == -1) {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+    return true;
+}
+
+/* Send three parts: command, data and a LE 4 bytes sequence number */
+static bool SendMessage(const CZMQPublisher::Message &message) {
+    uint8_t msgseq[sizeof(uint32_t)];
+    WriteLE32(&msgseq[0], message.sequence);
+    return SendFrame(message.socket, message.command, strlen(message.command),
+                     ZMQ_SNDMORE) &&
+           SendPayloadFrame(message.socket, message.payload, ZMQ_SNDMORE) &&
+           SendFrame(message.socket, msgseq, sizeof(msgseq), 0);
+}
+
+void CZMQPublisher::Start() {
+    LOCK(cs);
+    assert(!running);
+    running = true;
+    thread = std::thread(&util::TraceThread, "zmqpub",
+                         [this] { ThreadPublish(); });
+}
+
+void CZMQPublisher::Stop() {
+    {
+        LOCK(cs);
+        running = false;
+    }
+    cond.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool CZMQPublisher::Enqueue(Message &&message) {
+    {
+        LOCK(cs);
+        if (queue.size() >= maxQueueSize) {
+            message.stats->dropped++;
+            return false;
+        }
+        message.stats->queued++;
+        queue.push_back(std::move(message));
+    }
+    cond.notify_all();
+    return true;
+}
+
+void CZMQPublisher::RemoveSocket(void *socket) {
+    WAIT_LOCK(cs, lock);
+    while (busy) {
+        cond.wait(lock);
+    }
+
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+                               [socket](const Message &message) {
+                                   if (message.socket != socket) {
+                                       return false;
+                                   }
+                                   message.stats->dropped++;
+                                   return true;
+                               }),
+                queue.end());
+}
+
+size_t CZMQPublisher::GetQueueSize() const {
+    LOCK(cs);
+    return queue.size();
+}
+
+void CZMQPublisher::ThreadPublish() {
+    WAIT_LOCK(cs, lock);
+    while (true) {
+        while (running && queue.empty()) {
+            cond.wait(lock);
+        }
+        // Only stop once all the messages are sent
+        if (queue.empty()) {
+            break;
+        }
+
+        // Send all the queued messages in a batch, without holding the lock
+        std::deque<Message> batch;
+        batch.swap(queue);
+        busy = true;
+        {
+            REVERSE_LOCK(lock);
+            for (const Message &message : batch) {
+                if (SendMessage(message)) {
+                    message.stats->published++;
+                } else {
+                    message.stats->dropped++;
+                }
+            }
+            batch.clear();
+        }
+        busy = false;
+        cond.notify_all();
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2023 The Bitcoin developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_ZMQ_ZMQPUBLISHER_H
+#define BITCOIN_ZMQ_ZMQPUBLISHER_H
+
+#include <sync.h>
+#include <zmq/zmqabstractnotifier.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>
+
+/**
+ * Send the ZMQ messages from a dedicated thread, so the validation interface
+ * queue is not slowed down by the ZMQ sockets.
+ *
+ * The notifiers add their messages to a bounded FIFO queue. When it is full
+ * the new messages are dropped and counted in the notifier stats. They still
+ * consume a sequence number, so the subscribers can detect the gap. The
+ * publisher thread takes all the queued messages at once and sends them, with
+ * the large payloads handed over to ZMQ without being copied.
+ *
+ * The ZMQ sockets are only used by the publisher thread once it is started.
+ */
+class CZMQPublisher {
+public:
+    static constexpr size_t DEFAULT_ZMQ_QUEUE_SIZE{10000};
+
+    struct Message {
+        void *socket;
+        //! Static topic string of the message
+        const char *command;
+        ZMQPayload payload;
+        uint32_t sequence;
+        std::shared_ptr<ZMQNotifierStats> stats;
+    };
+
+    explicit CZMQPublisher(size_t maxQueueSizeIn)
+        : maxQueueSize(maxQueueSizeIn) {}
+    ~CZMQPublisher() { Stop(); }
+
+    void Start();
+    /** Send the remaining messages and stop the publisher thread. */
+    void Stop();
+
+    /**
+     * Add a message to the queue. Returns false and counts the message as
+     * dropped if the queue is full.
+     */
+    bool Enqueue(Message &&message);
+
+    /**
+     * Drop the queued messages for this socket and wait for any message being
+     * sent to it, so the socket can be closed.
+     */
+    void RemoveSocket(void *socket);
+
+    size_t GetQueueSize() const;
+
+private:
+    void ThreadPublish();
+
+    const size_t maxQueueSize;
+    mutable Mutex cs;
+    std::condition_variable cond;
+    std::deque<Message> queue GUARDED_BY(cs);
+    bool running GUARDED_BY(cs){false};
+    //! Whether the publisher thread is sending messages taken from the queue
+    bool busy GUARDED_BY(cs){false};
+    std::thread thread;
+};
+
+#endif // BITCOIN_ZMQ_ZMQPUBLISHER_H
@@ -5,25 +5,23 @@
 #include <zmq/zmqpublishnotifier.h>
 
 #include <chain.h>
-#include <chainparams.h>
-#include <config.h>
-#include <node/blockstorage.h>
+#include <crypto/common.h>
+#include <logging.h>
 #include <primitives/blockhash.h>
+#include <primitives/transaction.h>
 #include <primitives/txid.h>
-#include <rpc/server.h>
-#include <streams.h>
-#include <util/system.h>
+#include <zmq/zmqpublisher.h>
 #include <zmq/zmqutil.h>
 
 #include <zmq.h>
 
-#include <cstdarg>
+#include <cassert>
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
-
-using node::ReadBlockFromDisk;
+#include <vector>
 
 static std::multimap<std::string, CZMQAbstractPublishNotifier *>
     mapPublishNotifiers;
@@ -34,48 +32,10 @@ static const char *MSG_RAWBLOCK = "rawblock";
 static const char *MSG_RAWTX = "rawtx";
 static const char *MSG_SEQUENCE = "sequence";
 
-// Internal function to send multipart message
-static int zmq_send_multipart(void *sock, const void *data, size_t size, ...) {
-    va_list args;
-    va_start(args, size);
-
-    while (1) {
-        zmq_msg_t msg;
-
-        int rc = zmq_msg_init_size(&msg, size);
-        if (rc != 0) {
-            zmqError("Unable to initialize ZMQ msg");
-            va_end(args);
-            return -1;
-        }
-
-        void *buf = zmq_msg_data(&msg);
-        memcpy(buf, data, size);
-
-        data = va_arg(args, const void *);
-
-        rc = zmq_msg_send(&msg, sock, data ? ZMQ_SNDMORE : 0);
-        if (rc == -1) {
-            zmqError("Unable to send ZMQ msg");
-            zmq_msg_close(&msg);
-            va_end(args);
-            return -1;
-        }
-
-        zmq_msg_close(&msg);
-
-        if (!data) {
-            break;
-        }
-
-        size = va_arg(args, size_t);
-    }
-    va_end(args);
-    return 0;
-}
-
-bool CZMQAbstractPublishNotifier::Initialize(void *pcontext) {
+bool CZMQAbstractPublishNotifier::Initialize(void *pcontext,
+                                             CZMQPublisher &publisherIn) {
     assert(!psocket);
+    publisher = &publisherIn;
 
     // check if address is being used by other publish notifier
     std::multimap<std::string, CZMQAbstractPublishNotifier *>::iterator i =
@@ -157,6 +117,7 @@ void CZMQAbstractPublishNotifier::Shutdown() {
 
     if (count == 1) {
         LogPrint(BCLog::ZMQ, "zmq: Close socket at address %s\n", address);
+        publisher->RemoveSocket(psocket);
         int linger = 0;
         zmq_setsockopt(psocket, ZMQ_LINGER, &linger, sizeof(linger));
         zmq_close(psocket);
@@ -166,26 +127,33 @@ void CZMQAbstractPublishNotifier::Shutdown() {
 }
 
 bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command,
-                                                 const void *data,
-                                                 size_t size) {
+                                                 ZMQPayload payload) {
     assert(psocket);
 
-    /* send three parts, command & data & a LE 4byte sequence number */
-    uint8_t msgseq[sizeof(uint32_t)];
-    WriteLE32(&msgseq[0], nSequence);
-    int rc = zmq_send_multipart(psocket, command, strlen(command), data, size,
-                                msgseq, (size_t)sizeof(uint32_t), nullptr);
-    if (rc == -1) {
-        return false;
+    // The sequence number is consumed even if the message is dropped, so the
+    // subscribers can detect the gap
+    if (!publisher->Enqueue({psocket, command, std::move(payload), nSequence++,
+                             stats})) {
+        LogPrint(BCLog::ZMQ,
+                 "zmq: Publisher queue is full, dropping %s message to %s\n",
+                 command, address);
     }
 
-    /* increment memory only sequence number after sending */
-    nSequence++;
-
+    // Dropping a message is not a failure of the notifier
     return true;
 }
 
-bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex) {
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command,
+                                                 const void *data,
+                                                 size_t size) {
+    const uint8_t *begin = static_cast<const uint8_t *>(data);
+    return SendZmqMessage(command,
+                          ZMQPayload(std::make_shared<std::vector<uint8_t>>(
+                              begin, begin + size)));
+}
+
+bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex,
+                                               CZMQRawPayload & /*rawBlock*/) {
     BlockHash hash = pindex->GetBlockHash();
     LogPrint(BCLog::ZMQ, "zmq: Publish hashblock %s to %s\n", hash.GetHex(),
              this->address);
@@ -197,7 +165,7 @@ bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex) {
 }
 
 bool CZMQPublishHashTransactionNotifier::NotifyTransaction(
-    const CTransaction &transaction) {
+    const CTransaction &transaction, CZMQRawPayload & /*rawTransaction*/) {
     TxId txid = transaction.GetId();
     LogPrint(BCLog::ZMQ, "zmq: Publish hashtx %s to %s\n", txid.GetHex(),
              this->address);
@@ -208,32 +176,28 @@ bool CZMQPublishHashTransactionNotifier::NotifyTransaction(
     return SendZmqMessage(MSG_HASHTX, data, 32);
 }
 
-bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex) {
+bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex,
+                                              CZMQRawPayload &rawBlock) {
     LogPrint(BCLog::ZMQ, "zmq: Publish rawblock %s to %s\n",
              pindex->GetBlockHash().GetHex(), this->address);
 
-    const Config &config = GetConfig();
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
-    CBlock block;
-    if (!ReadBlockFromDisk(block, pindex,
-                           config.GetChainParams().GetConsensus())) {
+    const std::optional<ZMQPayload> &payload = rawBlock.Get();
+    if (!payload) {
         zmqError("Can't read block from disk");
         return false;
     }
 
-    ss << block;
-
-    return SendZmqMessage(MSG_RAWBLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWBLOCK, *payload);
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(
-    const CTransaction &transaction) {
+    const CTransaction &transaction, CZMQRawPayload &rawTransaction) {
     TxId txid = transaction.GetId();
     LogPrint(BCLog::ZMQ, "zmq: Publish rawtx %s to %s\n", txid.GetHex(),
              this->address);
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
-    ss << transaction;
-    return SendZmqMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
+    const std::optional<ZMQPayload> &payload = rawTransaction.Get();
+    assert(payload);
+    return SendZmqMessage(MSG_RAWTX, *payload);
 }
 
 // TODO: Dedup this code to take label char, log string
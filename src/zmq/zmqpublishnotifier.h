@@ -13,38 +13,44 @@ class CZMQAbstractPublishNotifier : public CZMQAbstractNotifier {
 private:
     //! upcounting per message sequence number
     uint32_t nSequence{0U};
+    CZMQPublisher *publisher{nullptr};
 
 public:
-    /* send zmq multipart message
+    /* queue zmq multipart message for the publisher thread
        parts:
           * command
           * data
           * message sequence number
     */
+    bool SendZmqMessage(const char *command, ZMQPayload payload);
     bool SendZmqMessage(const char *command, const void *data, size_t size);
 
-    bool Initialize(void *pcontext) override;
+    bool Initialize(void *pcontext, CZMQPublisher &publisherIn) override;
     void Shutdown() override;
 };
 
 class CZMQPublishHashBlockNotifier : public CZMQAbstractPublishNotifier {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CBlockIndex *pindex,
+                     CZMQRawPayload &rawBlock) override;
 };
 
 class CZMQPublishHashTransactionNotifier : public CZMQAbstractPublishNotifier {
 public:
-    bool NotifyTransaction(const CTransaction &transaction) override;
+    bool NotifyTransaction(const CTransaction &transaction,
+                           CZMQRawPayload &rawTransaction) override;
 };
 
 class CZMQPublishRawBlockNotifier : public CZMQAbstractPublishNotifier {
 public:
-    bool NotifyBlock(const CBlockIndex *pindex) override;
+    bool NotifyBlock(const CBlockIndex *pindex,
+                     CZMQRawPayload &rawBlock) override;
 };
 
 class CZMQPublishRawTransactionNotifier : public CZMQAbstractPublishNotifier {
 public:
-    bool NotifyTransaction(const CTransaction &transaction) override;
+    bool NotifyTransaction(const CTransaction &transaction,
+                           CZMQRawPayload &rawTransaction) override;
 };
 
 class CZMQPublishSequenceNotifier : public CZMQAbstractPublishNotifier {
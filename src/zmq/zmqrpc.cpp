@@ -32,6 +32,13 @@ static RPCHelpMan getzmqnotifications() {
                       "Address of the publisher"},
                      {RPCResult::Type::NUM, "hwm",
                       "Outbound message high water mark"},
+                     {RPCResult::Type::NUM, "queued",
+                      "Number of messages added to the publisher queue"},
+                     {RPCResult::Type::NUM, "published",
+                      "Number of messages sent to the socket"},
+                     {RPCResult::Type::NUM, "dropped",
+                      "Number of messages dropped because the publisher "
+                      "queue was full or they could not be sent"},
                  }},
             }},
         RPCExamples{HelpExampleCli("getzmqnotifications", "") +
@@ -46,6 +53,10 @@ static RPCHelpMan getzmqnotifications() {
                     obj.pushKV("type", n->GetType());
                     obj.pushKV("address", n->GetAddress());
                     obj.pushKV("hwm", n->GetOutboundMessageHighWaterMark());
+                    const ZMQNotifierStats &stats = n->GetStats();
+                    obj.pushKV("queued", stats.queued.load());
+                    obj.pushKV("published", stats.published.load());
+                    obj.pushKV("dropped", stats.dropped.load());
                     result.push_back(obj);
                 }
             }
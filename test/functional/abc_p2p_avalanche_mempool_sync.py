@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 The Bitcoin developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the mempool reconciliation between avalanche peers."""
+
+import random
+import time
+
+from test_framework.avatools import AvaP2PInterface
+from test_framework.messages import (
+    MSG_TX,
+    NODE_AVALANCHE,
+    NODE_NETWORK,
+    ShortIdSketch,
+    msg_avadiff,
+    msg_avasketch,
+)
+from test_framework.p2p import p2p_lock
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+from test_framework.wallet import MiniWallet
+
+# Minimum time between 2 sketches from the same peer
+AVALANCHE_MEMPOOL_SKETCH_MIN_INTERVAL = 10
+# Capacity of the first sketch sent to a peer
+AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY = 64
+
+
+class SketchP2PInterface(AvaP2PInterface):
+    def __init__(self, test_framework=None, node=None):
+        self.tx_invs = set()
+        super().__init__(test_framework, node)
+
+    def on_inv(self, message):
+        super().on_inv(message)
+        for inv in message.inv:
+            if inv.type == MSG_TX:
+                self.tx_invs.add(inv.hash)
+
+    def has_tx_invs(self, txids):
+        with p2p_lock:
+            return txids.issubset(self.tx_invs)
+
+    def get_message(self, msgtype):
+        with p2p_lock:
+            return self.last_message.get(msgtype)
+
+    def get_message_count(self, msgtype):
+        with p2p_lock:
+            return self.message_count.get(msgtype, 0)
+
+
+class AvalancheMempoolSyncTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.extra_args = [
+            [
+                "-avamempoolsync=1",
+                "-avaproofstakeutxodustthreshold=1000000",
+                "-avaproofstakeutxoconfirmations=1",
+                "-avacooldown=0",
+            ]
+        ]
+
+    def run_test(self):
+        node = self.nodes[0]
+
+        self.wallet = MiniWallet(node)
+        self.generate(self.wallet, 20)
+        # Mature the coinbases
+        self.generate(node, 100)
+
+        # Building the peers proofs mines blocks, so they are built before the
+        # mempool is filled.
+        self.peers = [SketchP2PInterface(self, node) for _ in range(3)]
+
+        self.txids = [
+            int(self.wallet.send_self_transfer(from_node=node)["txid"], 16)
+            for _ in range(10)
+        ]
+        assert_equal(node.getmempoolinfo()["size"], len(self.txids))
+
+        self.mocktime = int(time.time())
+        node.setmocktime(self.mocktime)
+
+        self.test_respond_to_sketch()
+        self.test_send_sketch()
+        self.test_bad_sketch()
+
+    def test_respond_to_sketch(self):
+        self.log.info("Check the node reconciles its mempool with the sketches")
+        node = self.nodes[0]
+
+        peer = node.add_p2p_connection(self.peers[0])
+        peer.sync_with_ping()
+
+        # The peer has some of the node transactions and some the node doesn't
+        # know about.
+        peer_txids = self.txids[:6]
+        unknown_txids = [random.getrandbits(256) for _ in range(3)]
+
+        sketch = msg_avasketch(capacity=20)
+        for txid in peer_txids + unknown_txids:
+            sketch.add_tx(txid)
+        peer.send_message(sketch)
+
+        self.wait_until(lambda: peer.get_message("avadiff") is not None)
+        diff = peer.get_message("avadiff")
+        assert diff.decoded
+        assert_equal(diff.difference_size, 7)
+        assert_equal(
+            sorted(diff.shortids),
+            sorted(sketch.get_shortid(txid) for txid in unknown_txids),
+        )
+
+        # The node announces the transactions the peer is missing
+        self.wait_until(lambda: peer.has_tx_invs(set(self.txids[6:])))
+        with p2p_lock:
+            assert peer.tx_invs.isdisjoint(peer_txids)
+
+        self.log.info("Check the sketches can't be sent too often")
+        peer.send_and_ping(sketch)
+        assert_equal(peer.get_message_count("avadiff"), 1)
+
+        self.mocktime += AVALANCHE_MEMPOOL_SKETCH_MIN_INTERVAL
+        node.setmocktime(self.mocktime)
+
+        self.log.info("Check the node reports the sketches it can't decode")
+        sketch = msg_avasketch(capacity=1)
+        for _ in range(100):
+            sketch.add_tx(random.getrandbits(256))
+        peer.send_message(sketch)
+
+        self.wait_until(lambda: peer.get_message_count("avadiff") == 2)
+        diff = peer.get_message("avadiff")
+        assert not diff.decoded
+        assert_equal(diff.difference_size, 0)
+        assert_equal(diff.shortids, [])
+
+        peer.peer_disconnect()
+        peer.wait_for_disconnect()
+
+    def test_send_sketch(self):
+        self.log.info("Check the node sends sketches to its avalanche peers")
+        node = self.nodes[0]
+
+        peer = self.peers[1]
+        node.add_outbound_p2p_connection(
+            peer,
+            p2p_idx=0,
+            connection_type="avalanche",
+            services=NODE_NETWORK | NODE_AVALANCHE,
+        )
+
+        def wait_for_sketch(count, capacity):
+            # The sketches are sent at random intervals
+            def sketch_received():
+                self.mocktime += 5 * 60
+                node.setmocktime(self.mocktime)
+                peer.sync_send_with_ping()
+                return peer.get_message_count("avasketch") >= count
+
+            self.wait_until(sketch_received)
+            sketch = peer.get_message("avasketch")
+
+            # The sketch matches the node mempool
+            expected = ShortIdSketch(capacity)
+            for txid in node.getrawmempool():
+                expected.insert(sketch.get_shortid(int(txid, 16)))
+            assert_equal(sketch.sketch.cells, expected.cells)
+
+            return sketch
+
+        sketch = wait_for_sketch(1, AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY)
+
+        # Tell the node we miss a transaction, it gets announced
+        diff = msg_avadiff()
+        diff.decoded = True
+        diff.difference_size = 1
+        diff.shortids = [sketch.get_shortid(self.txids[0])]
+        peer.send_message(diff)
+        self.wait_until(lambda: peer.has_tx_invs({self.txids[0]}))
+
+        # A failure doubles the capacity of the next sketch
+        wait_for_sketch(2, AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY)
+        diff = msg_avadiff()
+        diff.decoded = False
+        peer.send_message(diff)
+        wait_for_sketch(3, 2 * AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY)
+
+        # A success sizes it after the difference, but not below the minimum
+        diff = msg_avadiff()
+        diff.decoded = True
+        diff.difference_size = 20
+        peer.send_message(diff)
+        wait_for_sketch(4, AVALANCHE_MEMPOOL_SKETCH_MIN_CAPACITY)
+
+        diff.difference_size = 100
+        peer.send_message(diff)
+        wait_for_sketch(5, 200)
+
+        peer.peer_disconnect()
+        peer.wait_for_disconnect()
+
+    def test_bad_sketch(self):
+        self.log.info("Check the peers sending invalid sketches are banned")
+        node = self.nodes[0]
+
+        peer = node.add_p2p_connection(self.peers[2])
+        peer.sync_with_ping()
+
+        sketch = msg_avasketch()
+        sketch.sketch.cells = [[0, 0, 0] for _ in range(4)]
+        with node.assert_debug_log(["avasketch-bad-size"]):
+            peer.send_message(sketch)
+            peer.wait_for_disconnect()
+
+
+if __name__ == "__main__":
+    AvalancheMempoolSyncTest().main()
@@ -21,6 +21,8 @@ from test_framework.p2p import P2PInterface
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.util import (
     assert_equal,
+    assert_greater_than,
+    assert_greater_than_or_equal,
     assert_raises_rpc_error,
     try_rpc,
     uint256_hex,
@@ -48,8 +50,25 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
 
         privkey, proof = gen_proof(self, node, expiry=2000000000)
 
+        def get_avalancheinfo():
+            info = node.getavalancheinfo()
+            # The polling statistics depend on the response timings, they are
+            # checked separately.
+            polling = info.pop("polling")
+            assert_equal(
+                set(polling.keys()),
+                {
+                    "node_count",
+                    "response_count",
+                    "timeout_count",
+                    "average_latency_ms",
+                    "average_poll_size",
+                },
+            )
+            return info
+
         def assert_avalancheinfo(expected):
-            assert_equal(node.getavalancheinfo(), expected)
+            assert_equal(get_avalancheinfo(), expected)
 
         coinbase_amount = Decimal("25000000.00")
 
@@ -239,7 +258,7 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
         self.log.info("Mine a block to trigger proof validation, check it is immature")
         self.generate(node, 1, sync_fun=self.no_op)
         self.wait_until(
-            lambda: node.getavalancheinfo()
+            lambda: get_avalancheinfo()
             == {
                 "ready_to_poll": False,
                 "local": {
@@ -273,7 +292,7 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
         self.log.info("Mine another block to mature the local proof")
         self.generate(node, 1, sync_fun=self.no_op)
         self.wait_until(
-            lambda: node.getavalancheinfo()
+            lambda: get_avalancheinfo()
             == {
                 "ready_to_poll": False,
                 "local": {
@@ -349,7 +368,7 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
         n.send_avaproof(immature_proof)
 
         self.wait_until(
-            lambda: node.getavalancheinfo()
+            lambda: get_avalancheinfo()
             == {
                 "ready_to_poll": True,
                 "local": {
@@ -388,7 +407,7 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
             n.wait_for_disconnect()
 
         self.wait_until(
-            lambda: node.getavalancheinfo()
+            lambda: get_avalancheinfo()
             == {
                 "ready_to_poll": True,
                 "local": {
@@ -530,6 +549,34 @@ class GetAvalancheInfoTest(BitcoinTestFramework):
         with node.assert_debug_log(expected_logs):
             self.wait_until(lambda: vote_for_all_proofs())
 
+        self.log.info("Check the polling statistics account for the responses")
+        polling = node.getavalancheinfo()["polling"]
+        assert_greater_than(polling["node_count"], 0)
+        assert_greater_than(polling["response_count"], 0)
+        assert_greater_than_or_equal(polling["average_latency_ms"], 0)
+        # The poll size starts at the maximum of 16 items and only shrinks when
+        # a node doesn't respond
+        assert_greater_than_or_equal(16, polling["average_poll_size"])
+        if polling["timeout_count"] == 0:
+            assert_equal(polling["average_poll_size"], 16)
+
+        self.log.info("Check the latencies account for the finalized proofs")
+        latencies = node.getavalanchelatencyinfo()
+        assert_greater_than_or_equal(
+            latencies["finalization_time"]["proofs"]["count"], len(proofs)
+        )
+        # The polling statistics only account for the connected nodes
+        assert_equal(
+            sum(n["poll_round_trip_time"]["count"] for n in latencies["nodes"]),
+            polling["response_count"],
+        )
+        assert_greater_than_or_equal(
+            latencies["poll_round_trip_time"]["count"], polling["response_count"]
+        )
+        assert_greater_than_or_equal(
+            latencies["timed_out_polls"], polling["timeout_count"]
+        )
+
         self.log.info(
             "Disconnect all the nodes, so we are the only node left on the network"
         )
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 The Bitcoin developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the persistence of the signature and script execution caches.
+
+  - Send a transaction, which caches the execution of its scripts.
+  - Restart the node with -persistsigcache and check that the caches are
+    dumped, then reloaded so the mempool transaction hits the cache when the
+    mempool is reloaded.
+  - Restart the node with -persistsigcache=0 and check that the caches are
+    not loaded.
+"""
+import os
+
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal, assert_greater_than
+from test_framework.wallet import MiniWallet
+
+
+class PersistSigCacheTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = True
+        self.extra_args = [["-persistsigcache"]]
+
+    def run_test(self):
+        node = self.nodes[0]
+        wallet = MiniWallet(node)
+        self.generate(wallet, 1)
+        self.generate(node, 100)
+
+        txid = wallet.send_self_transfer(from_node=node)["txid"]
+        assert_greater_than(node.getscriptcacheinfo()["script"]["insertions"], 0)
+
+        self.log.info("Check the caches are dumped on shutdown")
+        self.stop_node(0)
+        datadir = os.path.join(node.datadir, self.chain)
+        for filename in ["sigcache.dat", "scriptcache.dat"]:
+            assert os.path.isfile(os.path.join(datadir, filename))
+
+        self.log.info("Check the caches are loaded on startup")
+        with node.assert_debug_log(
+            ["Imported sigcache.dat from disk", "Imported scriptcache.dat from disk"]
+        ):
+            self.start_node(0, extra_args=["-persistsigcache"])
+        assert_equal(node.getrawmempool(), [txid])
+        assert_greater_than(node.getscriptcacheinfo()["script"]["hits"], 0)
+
+        self.log.info("Check the caches are not loaded with -persistsigcache=0")
+        with node.assert_debug_log(
+            ["Imported mempool transactions from disk"],
+            unexpected_msgs=["Imported scriptcache.dat from disk"],
+        ):
+            self.restart_node(0, extra_args=["-persistsigcache=0"])
+        assert_equal(node.getrawmempool(), [txid])
+        assert_equal(node.getscriptcacheinfo()["script"]["hits"], 0)
+
+
+if __name__ == "__main__":
+    PersistSigCacheTest().main()
@@ -99,6 +99,24 @@ class TestBitcoinCli(BitcoinTestFramework):
             self.nodes[0].cli("-rpccookiefile=does-not-exist", "-rpcpassword=").echo,
         )
 
+        self.log.info("Test -rpcencoding=cbor")
+        cbor_cli = self.nodes[0].cli("-rpcencoding=cbor")
+        blockhash = self.nodes[0].getbestblockhash()
+        assert_equal(
+            cbor_cli.getblock(blockhash, 2), self.nodes[0].getblock(blockhash, 2)
+        )
+        assert_equal(
+            cbor_cli.getblockheader(blockhash), self.nodes[0].getblockheader(blockhash)
+        )
+        assert_equal(cbor_cli.echo("00ff", "0A", "x"), ["00ff", "0A", "x"])
+        assert_equal(cbor_cli.send_cli("-getinfo")["blocks"], BLOCKS)
+        assert_raises_rpc_error(-5, "Block not found", cbor_cli.getblock, "00" * 32)
+        assert_raises_process_error(
+            1,
+            "Unknown -rpcencoding value: xml",
+            self.nodes[0].cli("-rpcencoding=xml").echo,
+        )
+
         self.log.info("Test -getinfo with arguments fails")
         assert_raises_process_error(
             1, "-getinfo takes no arguments", self.nodes[0].cli("-getinfo").help
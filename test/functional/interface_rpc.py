@@ -53,6 +53,25 @@ class RPCInterfaceTest(BitcoinTestFramework):
             os.path.join(self.nodes[0].datadir, self.chain, "debug.log"),
         )
 
+        assert_equal(set(info["work_queues"].keys()), {"rpc", "rpc_slow", "rest"})
+        for queue in info["work_queues"].values():
+            assert_greater_than_or_equal(queue["threads"], 1)
+            assert_greater_than_or_equal(queue["max_depth"], 1)
+            assert_equal(queue["rejected"], 0)
+
+        def processed(queue):
+            return self.nodes[0].getrpcinfo()["work_queues"][queue]["processed"]
+
+        # The previous getrpcinfo call is accounted for in the rpc queue once
+        # the worker thread is done with it
+        self.wait_until(lambda: processed("rpc") >= 1)
+
+        # Batches and expensive methods are processed by the rpc_slow queue
+        slow_processed = info["work_queues"]["rpc_slow"]["processed"]
+        self.nodes[0].getblock(self.nodes[0].getbestblockhash())
+        self.nodes[0].batch([{"method": "getblockcount", "id": 1}])
+        self.wait_until(lambda: processed("rpc_slow") == slow_processed + 2)
+
     def test_batch_request(self):
         self.log.info("Testing basic JSON-RPC batch request...")
 
@@ -81,6 +100,25 @@ class RPCInterfaceTest(BitcoinTestFramework):
         assert_equal(result_by_id[3]["error"], None)
         assert result_by_id[3]["result"] is not None
 
+        self.log.info("Testing large JSON-RPC batch request...")
+
+        # The calls are executed in parallel but the replies are returned in
+        # the requests order.
+        self.generate(self.nodes[0], 10)
+        for parallelism in [1, 4]:
+            self.restart_node(0, [f"-rpcbatchparallelism={parallelism}"])
+            results = self.nodes[0].batch(
+                [
+                    {"method": "getblockhash", "id": i, "params": [i % 11]}
+                    for i in range(200)
+                ]
+            )
+            assert_equal([res["id"] for res in results], list(range(200)))
+            assert_equal(
+                [res["result"] for res in results],
+                [self.nodes[0].getblockhash(i % 11) for i in range(200)],
+            )
+
     def test_http_status_codes(self):
         self.log.info("Testing HTTP status codes for JSON-RPC requests...")
 
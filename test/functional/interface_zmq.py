@@ -233,8 +233,13 @@ class ZMQTest(BitcoinTestFramework):
             assert_equal(payment_txid, txid.hex())
 
         self.log.info("Test the getzmqnotifications RPC")
+        notifications = self.nodes[0].getzmqnotifications()
+        counters = ["queued", "published", "dropped"]
         assert_equal(
-            self.nodes[0].getzmqnotifications(),
+            [
+                {k: v for k, v in n.items() if k not in counters}
+                for n in notifications
+            ],
             [
                 {"type": "pubhashblock", "address": address, "hwm": 1000},
                 {"type": "pubhashtx", "address": address, "hwm": 1000},
@@ -242,6 +247,15 @@ class ZMQTest(BitcoinTestFramework):
                 {"type": "pubrawtx", "address": address, "hwm": 1000},
             ],
         )
+        self.wait_until(
+            lambda: all(
+                n["published"] == n["queued"]
+                for n in self.nodes[0].getzmqnotifications()
+            )
+        )
+        for n in self.nodes[0].getzmqnotifications():
+            assert n["published"] >= num_blocks
+            assert_equal(n["dropped"], 0)
 
         assert_equal(self.nodes[1].getzmqnotifications(), [])
 
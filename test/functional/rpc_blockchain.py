@@ -525,6 +525,13 @@ class BlockchainTest(BitcoinTestFramework):
         txid = miniwallet.send_self_transfer(fee_rate=fee_per_kb, from_node=node)[
             "txid"
         ]
+
+        self.log.info("Test the streamed verbose mempool matches the batched one")
+        mempool = node.getrawmempool(True)
+        assert txid in mempool
+        batched = node.batch([node.getrawmempool.get_request(True)])
+        assert_equal(batched[0]["result"], mempool)
+
         blockhash = self.generate(node, 1)[0]
 
         self.log.info("Test getblock with verbosity 1 only includes the txid")
@@ -536,6 +543,10 @@ class BlockchainTest(BitcoinTestFramework):
         tx = block["tx"][1]
         assert_equal(tx["fee"], tx["size"] * fee_per_byte)
 
+        self.log.info("Test the streamed getblock result matches the batched one")
+        batched = node.batch([node.getblock.get_request(blockhash, 2)])
+        assert_equal(batched[0]["result"], block)
+
         self.log.info(
             "Test getblock with verbosity 2 still works with pruned Undo data"
         )
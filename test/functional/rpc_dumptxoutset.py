@@ -43,7 +43,7 @@ class DumptxoutsetTest(BitcoinTestFramework):
             # UTXO snapshot hash should be deterministic based on mocked time.
             assert_equal(
                 digest,
-                "a92dc32a15975b3c84bb1e6ac5218ff94194b4ea7d1b9372fb80184a7533a89f",
+                "a1bf4d419a26bace334ea0e859cb6f7680e56a94186e38e768cae97d846f0974",
             )
 
         # Specifying a path to an existing file will fail.
@@ -65,6 +65,17 @@ class RpcMiscTest(BitcoinTestFramework):
             -8, "unknown mode foobar", node.getmemoryinfo, mode="foobar"
         )
 
+        self.log.info("test getscriptcacheinfo")
+        cacheinfo = node.getscriptcacheinfo()
+        for cache in ("signature", "script"):
+            stats = cacheinfo[cache]
+            assert_equal(stats["shards"], 16)
+            assert_greater_than(stats["capacity"], 0)
+            for key in ("insertions", "hits", "misses", "contentions"):
+                assert_greater_than_or_equal(stats[key], 0)
+            assert_greater_than_or_equal(stats["hitrate"], 0)
+            assert_greater_than_or_equal(1, stats["hitrate"])
+
         self.log.info("test logging rpc and help")
 
         # Test logging RPC returns the expected number of logging categories.
@@ -449,6 +449,11 @@ class ScantxoutsetTest(BitcoinTestFramework):
             ],
         )
 
+        self.log.info("Check that the parallel scan covers the whole UTXO set")
+        scan = self.nodes[0].scantxoutset("start", [f"addr({addr})"])
+        assert_equal(scan["success"], True)
+        assert_equal(scan["txouts"], self.nodes[0].gettxoutsetinfo()["txouts"])
+
         # Check that status and abort don't need second arg
         assert_equal(self.nodes[0].scantxoutset("status"), None)
         assert_equal(self.nodes[0].scantxoutset("abort"), False)
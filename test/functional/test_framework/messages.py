@@ -2292,6 +2292,126 @@ class msg_avaproofsreq:
         )
 
 
+class ShortIdSketch:
+    """Invertible Bloom lookup table of short ids, see shortidsketch.h"""
+
+    __slots__ = "cells"
+    NUM_HASHES = 3
+
+    def __init__(self, capacity=None):
+        self.cells = []
+        if capacity is not None:
+            cells_per_partition = (
+                2 * capacity + self.NUM_HASHES - 1
+            ) // self.NUM_HASHES + 8
+            self.cells = [
+                [0, 0, 0] for _ in range(self.NUM_HASHES * cells_per_partition)
+            ]
+
+    @staticmethod
+    def mix(x):
+        x &= 0xFFFFFFFFFFFFFFFF
+        x ^= x >> 30
+        x = (x * 0xBF58476D1CE4E5B9) & 0xFFFFFFFFFFFFFFFF
+        x ^= x >> 27
+        x = (x * 0x94D049BB133111EB) & 0xFFFFFFFFFFFFFFFF
+        x ^= x >> 31
+        return x
+
+    def insert(self, shortid):
+        partition_size = len(self.cells) // self.NUM_HASHES
+        checksum = self.mix(shortid)
+        for i in range(self.NUM_HASHES):
+            index = i * partition_size + (
+                self.mix(shortid + (i + 1) * 0x9E3779B97F4A7C15) % partition_size
+            )
+            cell = self.cells[index]
+            cell[0] += 1
+            cell[1] ^= shortid
+            cell[2] ^= checksum
+
+    def deserialize(self, f):
+        self.cells = [
+            list(struct.unpack("<iQQ", f.read(20)))
+            for _ in range(deser_compact_size(f))
+        ]
+
+    def serialize(self):
+        r = ser_compact_size(len(self.cells))
+        for cell in self.cells:
+            r += struct.pack("<iQQ", *cell)
+        return r
+
+    def __repr__(self):
+        return f"ShortIdSketch(len(cells)={len(self.cells)})"
+
+
+class msg_avasketch:
+    __slots__ = ("key0", "key1", "sketch")
+    msgtype = b"avasketch"
+
+    def __init__(self, capacity=None):
+        self.key0 = random.getrandbits(64)
+        self.key1 = random.getrandbits(64)
+        self.sketch = ShortIdSketch(capacity)
+
+    def get_shortid(self, txid):
+        return siphash256(self.key0, self.key1, txid)
+
+    def add_tx(self, txid):
+        self.sketch.insert(self.get_shortid(txid))
+
+    def deserialize(self, f):
+        self.key0 = struct.unpack("<Q", f.read(8))[0]
+        self.key1 = struct.unpack("<Q", f.read(8))[0]
+        self.sketch.deserialize(f)
+
+    def serialize(self):
+        r = b""
+        r += struct.pack("<Q", self.key0)
+        r += struct.pack("<Q", self.key1)
+        r += self.sketch.serialize()
+        return r
+
+    def __repr__(self):
+        return (
+            f"msg_avasketch(key0={self.key0}, key1={self.key1}, "
+            f"sketch={self.sketch})"
+        )
+
+
+class msg_avadiff:
+    __slots__ = ("decoded", "difference_size", "shortids")
+    msgtype = b"avadiff"
+
+    def __init__(self):
+        self.decoded = False
+        self.difference_size = 0
+        self.shortids = []
+
+    def deserialize(self, f):
+        self.decoded = struct.unpack("<?", f.read(1))[0]
+        self.difference_size = struct.unpack("<I", f.read(4))[0]
+        self.shortids = [
+            struct.unpack("<Q", f.read(8))[0] for _ in range(deser_compact_size(f))
+        ]
+
+    def serialize(self):
+        r = b""
+        r += struct.pack("<?", self.decoded)
+        r += struct.pack("<I", self.difference_size)
+        r += ser_compact_size(len(self.shortids))
+        for shortid in self.shortids:
+            r += struct.pack("<Q", shortid)
+        return r
+
+    def __repr__(self):
+        return (
+            f"msg_avadiff(decoded={self.decoded}, "
+            f"difference_size={self.difference_size}, shortids={self.shortids})"
+        )
+
+
 class TestFrameworkMessages(unittest.TestCase):
     def test_avalanche_proof_serialization_round_trip(self):
         """Verify that an AvalancheProof object is unchanged after a round-trip
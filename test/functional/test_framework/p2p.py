@@ -37,11 +37,13 @@ from test_framework.messages import (
     CBlockHeader,
     msg_addr,
     msg_addrv2,
+    msg_avadiff,
     msg_avahello,
     msg_avapoll,
     msg_avaproof,
     msg_avaproofs,
     msg_avaproofsreq,
+    msg_avasketch,
     msg_block,
     msg_blocktxn,
     msg_cfcheckpt,
@@ -95,12 +97,14 @@ P2P_VERSION_RELAY = 1
 MESSAGEMAP = {
     b"addr": msg_addr,
     b"addrv2": msg_addrv2,
+    b"avadiff": msg_avadiff,
     b"avapoll": msg_avapoll,
     b"avaproof": msg_avaproof,
     b"avaproofs": msg_avaproofs,
     b"avaproofsreq": msg_avaproofsreq,
     b"avaresponse": msg_tcpavaresponse,
     b"avahello": msg_avahello,
+    b"avasketch": msg_avasketch,
     b"block": msg_block,
     b"blocktxn": msg_blocktxn,
     b"cfcheckpt": msg_cfcheckpt,
@@ -434,6 +438,9 @@ class P2PInterface(P2PConnection):
     def on_addrv2(self, message):
         pass
 
+    def on_avadiff(self, message):
+        pass
+
     def on_avapoll(self, message):
         pass
 
@@ -452,6 +459,9 @@ class P2PInterface(P2PConnection):
     def on_avahello(self, message):
         pass
 
+    def on_avasketch(self, message):
+        pass
+
     def on_block(self, message):
         pass
 